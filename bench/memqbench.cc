@@ -0,0 +1,75 @@
+/*****************************************************************************/
+/*   memqbench.cc : time MemQ against the unpooled MemQ it replaced          */
+/*****************************************************************************/
+
+/* Usage: memqbench [operations]
+
+   Each queue sees the same stream of operations: an insert, a removal
+   from the head (a graduating load or store) or a removal from the tail
+   (a squash), chosen by a fixed pseudo-random sequence that keeps the
+   queue between empty and a few dozen entries, as the load and store
+   queues are. Several queues are used at once, as there is one of each
+   kind per processor. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include "Processor/memq.h"
+#include "oldmemq.h"
+
+#define NQUEUES 16
+#define MAXOCC  48
+
+static double Now()
+{
+  struct timeval tv;
+  gettimeofday(&tv,NULL);
+  return tv.tv_sec + tv.tv_usec*1e-6;
+}
+
+template <class Q> double Run(Q *q, long ops, long *check)
+{
+  unsigned seed = 12345;
+  long sum = 0;
+  double start = Now();
+  for (long n=0; n<ops; n++)
+    {
+      seed = seed*1103515245 + 12345;
+      Q& mq = q[(seed >> 8) % NQUEUES];
+      int r = (seed >> 16) % 8;
+      if (mq.NumItems() == 0 || (r < 4 && mq.NumItems() < MAXOCC))
+	mq.Insert((int)n);
+      else if (r < 7)
+	{
+	  sum += mq.GetNext(NULL)->d;
+	  mq.Remove(mq.GetNext(NULL));
+	}
+      else
+	mq.RemoveTail();
+    }
+  double t = Now() - start;
+  for (int i=0; i<NQUEUES; i++)
+    sum += q[i].NumItems();
+  *check = sum;
+  return t;
+}
+
+int main(int argc, char **argv)
+{
+  long ops = argc > 1 ? atol(argv[1]) : 20000000;
+  long c1, c2;
+  OldMemQ<int> *oldq = new OldMemQ<int>[NQUEUES];
+  MemQ<int> *newq = new MemQ<int>[NQUEUES];
+
+  double t1 = Run(oldq,ops,&c1);
+  double t2 = Run(newq,ops,&c2);
+  if (c1 != c2)
+    {
+      fprintf(stderr,"memqbench: queues disagree (%ld vs %ld)\n",c1,c2);
+      return 1;
+    }
+  printf("%ld operations on %d queues\n",ops,NQUEUES);
+  printf("unpooled MemQ: %6.1f ns/op\n",t1*1e9/ops);
+  printf("pooled MemQ:   %6.1f ns/op\n",t2*1e9/ops);
+  return 0;
+}
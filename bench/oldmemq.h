@@ -0,0 +1,88 @@
+/*****************************************************************************/
+/*   oldmemq.h : MemQ as it was before its links were pooled, kept only as  */
+/*               the baseline for memqbench                                  */
+/*****************************************************************************/
+
+#ifndef _oldmemq_h_
+#define _oldmemq_h_ 1
+
+#include <stddef.h>
+
+/* Only the operations memqbench uses; each link is new'ed on insert and
+   deleted on removal, as the original MemQ did */
+
+template <class Data> struct OldMemQLink
+{
+    Data d;
+    OldMemQLink<Data> *next, *prev;
+    OldMemQLink(Data x):d(x) {next=prev=NULL;}
+};
+
+template <class Data> class OldMemQ
+{
+private:
+    OldMemQLink<Data> *head;
+    OldMemQLink<Data> *tail;
+    int items;
+public:
+    OldMemQ(): head(NULL),tail(NULL),items(0) {}
+    void Insert(Data d);
+    void Remove(OldMemQLink<Data> *stepper);
+    void RemoveTail();
+    OldMemQLink<Data> *GetNext(OldMemQLink<Data> *a)
+	{if (a==NULL)return head;else return a->next;}
+    int NumItems() const {return items;}
+};
+
+template <class Data> inline void OldMemQ<Data>::Insert(Data d)
+{
+  items++;
+  OldMemQLink<Data> *item = new OldMemQLink<Data>(d);
+  if (tail == NULL)	{
+    head=tail=item;
+  }
+  else{
+    tail->next=item;
+    item->prev=tail;
+    tail=item;
+  }
+}
+
+template <class Data> inline void OldMemQ<Data>::Remove(OldMemQLink<Data> *stepper)
+{
+  items--;
+  if (stepper == tail)   {
+    if (stepper == head)
+      head=tail=NULL;
+    else   {
+      tail = stepper->prev;
+      tail->next = NULL;
+    }
+  }
+  else if (stepper == head)   {
+    head = stepper->next;
+    head->prev = NULL;
+  }  else  {
+    stepper->next->prev = stepper->prev;
+    stepper->prev->next = stepper->next;
+  }
+  delete stepper;
+}
+
+template <class Data> inline void OldMemQ<Data>::RemoveTail()
+{
+  if (tail){
+    items--;
+    if (tail == head){
+      delete tail;
+      head=tail=NULL;
+    } else{
+      OldMemQLink<Data> *stepper = tail;
+      tail = tail->prev;
+      tail->next = NULL;
+      delete stepper;
+    }
+  }
+}
+
+#endif
@@ -80,6 +80,7 @@ extern int  ARCH_l1type, ARCH_cacsz1, ARCH_setsz1;
 extern int ARCH_cacsz2, ARCH_setsz2, ARCH_linesz, ARCH_wbufsz;
 
 extern int ARCH_dirbufsz;      /* directory buffer sizes */
+extern int ARCH_dirtype;       /* how directories record sharers */
 
 /* Network buffer sizes and delays */
 extern int ARCH_nettype, ARCH_NetBufsz, ARCH_NetPortsz;
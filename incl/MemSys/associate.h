@@ -57,6 +57,8 @@
 #ifndef _MemSys_associate_h_
 #define _MemSys_associate_h_ 1
 
+#include <stdio.h>
+
 /* associate address space from start to end to processor node */
 void AssociateAddrNode(unsigned int start, unsigned int end,
 		       int node, char *name);
@@ -71,6 +73,10 @@ void LookupAddrCohe(unsigned int addr, int *cohe);
 void LookupAddrNode(unsigned int addr, int *node);
 int MyLookupAddrNode(int addr);
 
+/* Write/read the node and coherence trees to/from a checkpoint file */
+void AssociateSave(FILE *fp);
+void AssociateRestore(FILE *fp);
+
 #define STKVAR -1                           /* stack variable identification */
 #define NLISTED -2                           /* Unlisted type identification */
 
@@ -93,7 +93,8 @@ extern int *L1Q_FULL;
 *                                    DEFINES                                 *
 \*****************************************************************************/
 
-#define SUB_SZ 2048   /* cache size allocated initially for infinite caches */
+#define SUB_SZ 2048   /* cache size allocated initially for infinite caches,
+			 and the number of lines they grow by */
 #define INFINITE -1
 
 #define FIRSTLEVEL_WT 1                 /* First level write-through caches */
@@ -176,15 +177,16 @@ extern unsigned int wrb_buf_extra; /* number of extra entries in WRB-buffer
 
 /*::::::::::::::::::::::: Cache Line Data Structure  ::::::::::::::::::::::::*/
 
+/* The lines of a cache are kept in flat arrays indexed by line number
+   (set * setsz + way), so the lines of each set are adjacent. The tags
+   live in an array of their own (CACHE tags) so that notpres can compare
+   a whole set at a time; the prefetch bookkeeping, which only the
+   statistics need, lives in a side array (CACHE prefs). */
+
 struct cache_data_struct {
-  long tag;                                             /* tag of cache line */
   unsigned age;                    /* age of access -- used to implement LRU */
   int dest_node;                                         /* destination node */
 
-  int pref;                                       /* used for prefetch stats */
-  long pref_tag_repl;                             /* used for prefetch stats */
-  double pref_time;                               /* used for prefetch stats */
-
   struct {
     CacheLineState st;                                /* state of cache line */
     unsigned cohe_type: 4;      /* coherence type associated with cache line */
@@ -200,6 +202,12 @@ struct cache_data_struct {
   }state;
 };
 
+struct cache_pref_struct {
+  int pref;                                       /* used for prefetch stats */
+  long pref_tag_repl;                             /* used for prefetch stats */
+  double pref_time;                               /* used for prefetch stats */
+};
+
 /*:::::::::::: Cache Statistics Collection Data Structure  ::::::::::::::::::*/
 
 struct CacheStat {
@@ -303,7 +311,9 @@ struct YS__Cache {
   func    cohe_rtn;                 /* coherence routine to invoke */
   func    prnt_rtn;                  /* printing routine to invoke */
   
-  Cachest ** data;             /* actual cache line information */
+  long *tags;                  /* tag of each cache line (-1 if never used) */
+  Cachest *data;               /* actual cache line information */
+  struct cache_pref_struct *prefs; /* prefetch statistics for each line */
   int num_lines;               /* number of cache lines */
   int block_bits;              /* number of bits in address removed to generate block # */
   int set_bits;                /* number of bits in address used to specify set */
@@ -316,6 +326,10 @@ struct YS__Cache {
   int reqs_at_mshr_count;      /* number of REQUESTs at MSHRs
 				  (including coalesced) */
   int max_mshrs;               /* total number of MSHRs in cache */
+  MSHRITEM **mshr_hash;        /* valid MSHRs chained by the tag of their
+				  main REQUEST (see mshr.c) */
+  int mshr_hash_mask;          /* mshr_hash has mshr_hash_mask+1 buckets */
+  unsigned *mshr_free;         /* one bit per MSHR, set while it is free */
 
   /* smart MSHR queue. Used to simulate activites being held in some
      cache resource (such as an MSHR) waiting to be sent to another
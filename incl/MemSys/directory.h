@@ -63,10 +63,9 @@
 
 /*############################# DIRECTORY  DECLARATION ######################*/
 
-/* Maximum sizes allowed by directory.
-   NOTE: Any update to MAX_MEMSYS_PROC may also need to be reflected here. */
-#define VECTOR_SIZE 4        /* number of integers to be used in bit vector */
-#define MAX_NUM_NODES 4*sizeof(int)*8	/* maximum number of nodes allowed  */
+/* The sharer information and the node_ary of each line are sized to the
+   number of nodes when the first directory is created (see NewDir), so
+   the directory itself places no limit on the number of nodes. */
 
 /* Information related to a single line held in the directory */
 /* Directory's view of line state */
@@ -82,14 +81,16 @@ struct YS__DirLine {
   char  *pfnxt;                 /* "next free" pointer used in pool
 				   management */
   int   tag;                    /* tag identifying the line in question */
-  int   vector[VECTOR_SIZE];	/* Bit vector that specifies all caches with
-				   a copy of the line */
-  int   cold_vec[VECTOR_SIZE];  /* Bit vector that specifies which caches
-				   have ever seen the line -- identifies cold
-				   misses */
   int   state :4;               /* state of line -- specified above */
   int   pend :1;                /* Does this line have a pending transaction
 				   outstanding? */
+  unsigned overflow :1;         /* Have the sharers outgrown the pointers of
+				   a CNTRL_LIMITED_PTR or CNTRL_COARSE_VEC
+				   entry? The sharer list is then a superset
+				   of the actual sharers */
+  unsigned evicting :1;         /* Is this line being evicted from a sparse
+				   directory? It has left its set and only
+				   waits for its invalidations to return */
   int   numsharers;             /* Number of sharers for the current line --
 				   this is redundant, as it can be calculated
 				   from the bit vector; provided for ease
@@ -99,8 +100,19 @@ struct YS__DirLine {
 				   outstanding transaction. Specified below */
   Dirst *next;                  /* "next pointer" for the chained hash table
 				   used among lines in the directory */
+  Dirst *set_next;              /* next line in the same sparse-directory
+				   set (see DIR_SETS below) */
+  unsigned bits[1];             /* vec_index words of sharer information
+				   (see dir_type below), followed by
+				   cold_index words of bit vector that
+				   specify which caches have ever seen the
+				   line -- identifies cold misses. Must be
+				   the last field: the DirstPool objects
+				   are sized for the actual words */
 };
 
+#define DirColdVec(dirptr, dir_item) ((dir_item)->bits + (dirptr)->vec_index)
+
 /* Extra information structure to specify processing information */
 struct YS__DirEP {
   char   *pnxt;                 /* "next" pointer used in pool management */
@@ -125,12 +137,14 @@ struct YS__DirEP {
   int  WasHere;                 /* Node which has provided a WRB or
 				   replacement message -- used in certain
 				   races involving NACKs */
-  int node_ary[MAX_NUM_NODES];  /* array of nodes which require COHE
-				   messages */
   int size_st;                  /* Size of message being sent */
   int size_req;                 /* Size of expected reply */
   int next_req_type;            /* Specifies COHE type being sent as a result
 				   of recent REQUEST */
+  int node_ary[1];              /* array of nodes which require COHE
+				   messages. Must be the last field: the
+				   DirEPPool objects have room for one
+				   entry per node */
 };
 
 /* Response types from Dir_Cohe function -- indicate how to process
@@ -166,16 +180,38 @@ struct YS__DirEP {
 			       at some point. The directory waits for
 			       the WRB or replacement hint to return before
 			       processing this REQUEST */
-#define Directory_rtn_max 11 /* used in names.c to specify number
+#define EVICT_REPLY 11      /* the value specified for "ret_st" when the
+			       COHEs were sent to evict the line from a
+			       sparse directory. The line is freed once
+			       all COHE_REPLYs have been collected */
+#define Directory_rtn_max 12 /* used in names.c to specify number
 				of response types */
 extern char *DirRtnStatus[]; /* array of response names -- used in names.c
 				(for printing out trace/debug information) */
 
 /*:::::::::::::::::: Directory Module Data Structure  :::::::::::::::::::::::*/
 
-/* Directory type specifier */
-#define CNTRL_FULL_MAP 1     /* Directory used is always full-mapped */
-#define HashIdxMask (0x3FF)	/* 1's in ten bits; used by dir hash table */
+/* Directory type specifier: how the sharers of a line are recorded */
+#define CNTRL_FULL_MAP 1     /* one bit per node */
+#define CNTRL_LIMITED_PTR 2  /* Dir_iB: DIR_POINTERS node pointers; when a
+				line has more sharers, invalidations are
+				broadcast to every node */
+#define CNTRL_COARSE_VEC 3   /* Dir_iCV: DIR_POINTERS node pointers; when a
+				line has more sharers, one bit per group of
+				DIR_COARSENESS nodes */
+extern int DIR_POINTERS, DIR_COARSENESS;
+
+/* A sparse directory holds at most DIR_ASSOC lines in each of DIR_SETS
+   sets, replaced according to DIR_REPL (LRU, FIFO or RANDOM, as for the
+   caches). A line chosen for replacement has its sharers invalidated.
+   DIR_SETS of 0 keeps every line ever referenced. */
+extern int DIR_SETS, DIR_ASSOC, DIR_REPL;
+
+#define HashIdxMask (0x3FF)	/* 1's in ten bits; initial size of the
+				   dir hash table */
+#define DIR_HASH_LOAD 2         /* the dir hash table doubles in size when
+				   it holds more than this many lines per
+				   bucket */
 
 struct YS__Directory {
   MODULE_FRAMEWORK
@@ -183,7 +219,8 @@ struct YS__Directory {
   int     dir_type;                             /* Type of directory */
   int     line_size;                          /* directory line size */
   int     num_nodes;                    /* number of nodes in system */
-  int     vec_index;           /* number of ints used in bit vectors */
+  int     vec_index;           /* number of words of sharer information */
+  int     cold_index;          /* number of words in the cold-miss vector */
   int     reqport;                      /* port from which directory
 				           receives REQUESTs         */
   int     next_port;           /* next port to process -- used in RR */
@@ -216,7 +253,16 @@ struct YS__Directory {
 
   DirEP   *extra;                  /* used for building up per-line
 				      "extra" items discussed above  */
-  Dirst    *data_hash[HashIdxMask+1];  /* chain-hash table for lines  */
+  Dirst   **data_hash;             /* chain-hash table for lines  */
+  int     hash_mask;               /* data_hash has hash_mask+1 buckets */
+  int     num_lines;               /* number of lines in data_hash   */
+  Dirst   **dir_set;               /* sparse directory only: lines in
+				      each set, most recently used (LRU)
+				      or inserted (FIFO, RANDOM) first */
+  int     *set_count;              /* lines held in each set (evicting
+				      lines are no longer counted)   */
+  unsigned repl_seed;              /* state of the RANDOM replacement
+				      generator                      */
   cond    cohe_rtn;                /* coherence routine to call (only
 				      Dir_Cohe available now)        */
 
@@ -231,6 +277,11 @@ struct YS__Directory {
   int num_buf_RAR;   /* number of retries sent because of buffer-full              */
   int num_race_RAR;  /* number of retries sent due to race conditions              */
   int num_c2c;       /* number of cache to cache transfers                         */
+  int num_overflow;  /* number of times a line outgrew its sharer pointers         */
+  int num_evict;     /* number of lines replaced in a sparse directory             */
+  int num_evict_invl;/* number of COHEs sent to invalidate replaced lines          */
+  int num_set_full;  /* number of allocations that found every line of the set
+			pending, leaving the set above DIR_ASSOC               */
   STATREC *CoheNumInvlMeans; /* average number of invalidations per request        */
   STATREC *BufTotSzMeans;    /* average number of entries in the directory buffer  */
   double time_of_last_clear; /* time of the last clearstat, for util calc.         */
@@ -0,0 +1,89 @@
+/*
+  hostprof.h
+
+  Declarations for the host-time profiler, which charges the host time
+  spent in the main simulator components (selected with -I).
+  
+ */
+/*****************************************************************************/
+/* This file is part of the RSIM Simulator.                                  */
+/*                                                                           */
+/******************************************************************************/
+/* University of Illinois/NCSA Open Source License                            */
+/*                                                                            */
+/* Copyright (c) 2002 The Board of Trustees of the University of Illinois and */
+/* William Marsh Rice University                                              */
+/*                                                                            */
+/* All rights reserved.                                                       */
+/*                                                                            */
+/* Developed by: Professor Sarita Adve's RSIM research group                  */
+/*               University of Illinois at Urbana-Champaign and William Marsh */
+/*                 Rice University                                            */
+/*               http://www.cs.uiuc.edu/rsim and                              */
+/*                 http://www.ece.rice.edu/~rsim/dist.html                    */
+/*                                                                            */
+/* Permission is hereby granted, free of charge, to any person obtaining a    */
+/* copy of this software and associated documentation files (the "Software"), */
+/* to deal with the Software without restriction, including without           */
+/* limitation the rights to use, copy, modify, merge, publish, distribute,    */
+/* sublicense, and/or sell copies of the Software, and to permit persons to   */
+/* whom the Software is furnished to do so, subject to the following          */
+/* conditions:                                                                */
+/*                                                                            */
+/*     * Redistributions of source code must retain the above copyright       */
+/* notice, this list of conditions and the following disclaimers.             */
+/*                                                                            */
+/*     * Redistributions in binary form must reproduce the above copyright    */
+/* notice, this list of conditions and the following disclaimers in the       */
+/* documentation and/or other materials provided with the distribution.       */
+/*                                                                            */
+/*     * Neither the names of Professor Sarita Adve's RSIM research group,    */
+/* the University of Illinois at Urbana-Champaign, William Marsh Rice         */
+/* University, nor the names of its contributors may be used to endorse or    */
+/* promote products derived from this Software without specific prior written */
+/* permission.                                                                */
+/*                                                                            */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    */
+/* THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR  */
+/* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,      */
+/* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR      */
+/* OTHER DEALINGS WITH THE SOFTWARE.                                          */
+/******************************************************************************/
+
+#ifndef _hostprof_h_
+#define _hostprof_h_ 1
+
+#include <stdio.h>
+
+/* Components are timed exclusively: host time goes to the innermost
+   component active at the time, and time outside all of them goes to
+   HP_OTHER. */
+
+#define HP_OTHER     0          /* driver loop and all other events     */
+#define HP_RSIM      1          /* RSIM_EVENT, outside the stages below */
+#define HP_DECODE    2          /* maindecode (or fast-forward)         */
+#define HP_COMPLETE  3          /* CompleteMemQueue and CompleteQueues  */
+#define HP_ISSUE     4          /* IssueQueues                          */
+#define HP_L1IN      5          /* L1CacheInSim                         */
+#define HP_L1OUT     6          /* L1CacheOutSim                        */
+#define HP_L2IN      7          /* L2CacheInSim                         */
+#define HP_L2OUT     8          /* L2CacheOutSim                        */
+#define HP_DIR       9          /* DirSim events                        */
+#define HP_BUS      10          /* bus events                           */
+#define HP_NET      11          /* smnet and mesh network events        */
+#define HP_EVLIST   12          /* event list insert and removal        */
+#define HP_NUM      13
+
+extern int HostProf;            /* profiling turned on */
+
+#define HOSTPROF_BEGIN(c) {if (HostProf) HostProfBegin(c);}
+#define HOSTPROF_END      {if (HostProf) HostProfEnd();}
+
+void HostProfBegin(int);        /* start charging time to a component   */
+void HostProfEnd(void);         /* return to the enclosing component    */
+int  HostProfEventClass(void (*)()); /* component of an event body      */
+void HostProfReport(FILE *, double, double); /* times since last report */
+
+#endif
@@ -67,10 +67,6 @@ extern int MemsimStatOn; /* Note: this is ON by default */
 extern int blocksize;
 extern int block_bits;
 
-#define MAX_MEMSYS_PROCS 128  /* maximum number of processors allowed
-				 by memory-system simulator .  Note
-				 that any changes here may need to be
-				 reflected in directory module also,
-				 as the directory implements a
-				 bit-vector of the nodes */
+#define MAX_MEMSYS_PROCS 1024 /* maximum number of processors allowed
+				 by memory-system simulator */
 #endif
@@ -63,6 +63,8 @@ struct YS__MSHR /* MSHR data structure */
   int valid;             /* Is this MSHR entry valid */
   int setnum;            /* Corresponding set number for the MSHR */
   REQ *mainreq;          /* The first request that was sent out */
+  long tag;              /* Line tag of mainreq, kept here since mainreq
+			    may be freed before the MSHR is released */
   int counter;           /* The number of coalesced accesses */
   REQ *coal_req[MAX_MAX_COALS]; /* array of coalesced accesses */
   enum ReqType pend_cohe_type; /* Coherence messages that came while the request was outstanding */
@@ -72,7 +74,7 @@ struct YS__MSHR /* MSHR data structure */
   int only_prefs;     /* Does this MSHR include only prefetches? */
   int writes_present; /* this will say if we need to go to PR_DY or if
 			 EXCL (PR_CL) is sufficient */
-  MSHRITEM *next;
+  MSHRITEM *next;   /* next valid MSHR in the same mshr_hash chain */
 };
   
 /* these are the return values from notpres_mshr */
@@ -120,6 +122,9 @@ enum MSHR_Response {MSHR_COAL,       /* REQUESTS: coalesce into an old MSHR
 enum MSHR_Response notpres_mshr(struct YS__Cache *,struct YS__Req *);
 int MSHRIterateUncoalesce(struct YS__Cache *,int mshr_num, int (*)(struct YS__Cache *,struct YS__Req *), enum MISS_TYPE);
 
+/* Allocate the MSHRs of a cache and the structures used to find them */
+void InitMSHRs(struct YS__Cache *, int max_mshrs);
+
 /* Free up an MSHR or substitute a new REQUEST into an MSHR */
 int RemoveMSHR(struct YS__Cache *, int mshr_num, REQ *subst);
 
@@ -117,8 +117,32 @@ void SmnetRcvStatReport();
 void SmnetStatClearAll();
 void SmnetStatClear();
 
-/* Function to create and initialize the mesh network used in RSIM */
+/* Functions to create and initialize the networks used in RSIM */
 void CreateMESH (int, int *, int, int, IPORT **, OPORT **, int (*)(int *,int *,int), int);
+void CreateTORUS (int, int *, int, IPORT **, OPORT **, int);
+void CreateCMESH (int, int *, int, int, IPORT **, OPORT **, int);
+void NetStatsInit (int, int);
+extern IPORT **cpu_iport;	/* message-passing ports of the reply network */
+extern OPORT **cpu_oport;
+
+/* Routing functions for the mesh, selected with "netrouting" */
+#define DOR_ROUTING       0  /* dimension order (MeshRoute)               */
+#define WESTFIRST_ROUTING 1  /* west-first turn model (MeshWestFirstRoute) */
+#define ODDEVEN_ROUTING   2  /* odd-even turn model (MeshOddEvenRoute)    */
+extern int NetRouting;
+extern char *NetRoutingName[];
+int MeshRoute (int *, int *, int);
+int MeshWestFirstRoute (int *, int *, int);
+int MeshOddEvenRoute (int *, int *, int);
+extern DEMUX *YS__RouteDemux; /* demux calling the routing function (net.c) */
+
+/* Packet-level network model (pktnet.c), selected with "netmodel" */
+#define FLIT_NETMODEL 0
+#define PACKET_NETMODEL 1
+extern int NetModel;
+void PktNetCreate(int, int, int *, int, int, IPORT **, OPORT **, int);
+void PktNetSend(PACKET *, IPORT *, double, double, double);
+void YS__PktNetEvent();
 
 
 
@@ -254,6 +278,10 @@ extern int rev_index[NUM_SIZES];
 #define MIN_NET  3
 #define APPR_NET 4
 #define XBAR_NET 5
+#define TORUS_NET 6  /* k-ary n-cube, packet-level model only */
+#define CMESH_NET 7  /* concentrated mesh, packet-level model only */
+
+#define CMESH_CONC 4 /* nodes sharing each router of a concentrated mesh */
 
 
 /*****************************************************************************/
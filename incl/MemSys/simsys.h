@@ -273,6 +273,7 @@
 
 #define CALQUE                   0
 #define LINQUE                   1
+#define TIMEWHEEL                2
 
 /* Netsim Routing modes */
 
@@ -620,11 +621,13 @@ void   EventReschedSema();  /* Reschedules an event to wait for a semaphore */
    double  lastv;               /* Last interval value entered with Update() */
    double  interval;            /* The sampling interval                     */
    int     intervalerr;         /* Nonzero => a negative interval encountered*/
+   const char *unit;            /* Unit of the values, for structured output */
 };
 
 int      YS__StatrecId();       /* Returns the system defined ID or 0        */
 STATREC  *NewStatrec(char *,int,int,int,int,double,double);         /* Creates and returns a pointer to a new statrec     */
 void     StatrecSetHistSz();    /* Sets the default histogram size           */
+void     StatrecSetUnit(STATREC *,const char *); /* Sets the unit of the values */
 void     StatrecReset(STATREC *);        /* Resets the statrec                        */
 void     StatrecUpdate(STATREC *,double,double);       /* Updates the statrec                       */
 void     StatrecReport(STATREC *);       /* Generates and displays a statrec report   */
@@ -646,6 +649,26 @@ double   StatrecInterval();     /* Returns the sampling interval             */
 double   StatrecRate();         /* Returns the sampling rate                 */
 void     StatrecEndInterval();  /* Terminates a sampling interval            */
 
+ struct YS__StatCtr {   /* Per-cycle counter: integer samples batched for a statrec */
+   STATREC *sr;                 /* POINT statrec the samples are folded into */
+   int     maxval;              /* Samples 0..maxval are batched             */
+   double  *wt;                 /* Accumulated weight of each sample value   */
+   int     *n;                  /* Number of samples of each value           */
+   int     pending;             /* Nonzero if there is anything to fold      */
+};
+
+STATCTR  *NewStatctr(STATREC *,int);     /* Creates a per-cycle counter      */
+void     StatctrFold(STATCTR *);         /* Folds the samples into the statrec        */
+void     StatctrReset(STATCTR *);        /* Discards the batched samples     */
+
+/* Adds sample v with weight t; values outside 0..maxval go straight to the statrec */
+#define StatctrUpdate(ctr,v,t) { \
+   int _v = (v); \
+   if (_v >= 0 && _v <= (ctr)->maxval) { \
+      (ctr)->wt[_v] += (t); (ctr)->n[_v]++; (ctr)->pending = 1; \
+   } \
+   else StatrecUpdate((ctr)->sr,(double)_v,(t)); }
+
 
 /*****************************************************************************/
 /* Event list operations                                                     */
@@ -660,7 +683,7 @@ double   YS__EventListHeadval();  /* Returns the time value of the event list he
 int      YS__EventListDelete();   /* Removes an element from the event list  */
 void     YS__EventListPrint();    /* Lists the contents of the event list    */
 int      EventListSize();         /* Returns the size of the event list      */
-void     EventListSelect();       /* Selects the type of event list to use   */
+void     EventListSelect(int,int,double); /* Selects the type of event list to use */
 void     EventListCollectStats(); /* Activates auto stats collection for event list   */
 void     EventListResetStats();   /* Resest a statistics record of a queue   */
 STATREC  *EventListStatPtr();     /* Returns a pointer to a event list's statrec      */
@@ -882,6 +905,14 @@ struct YS__Pkt
    PACKET  *headnext;      /* Next pointer for the head event                */
    PACKET  *tailnext;      /* Next pointer for the tail event                */
    int     tailoffset;     /* Offset of the tail from the front of its buffer*/
+
+   /* The head and tail events are created the first time the
+      descriptor is sent and reused by every later packet that gets it
+      from the pool, so these two fields must stay last: they survive
+      YS__PoolReturnObj().  */
+
+   EVENT   *headobj;       /* Head event owned by this descriptor            */
+   EVENT   *tailobj;       /* Tail event owned by this descriptor            */
 };
 
 PACKET    *NewPacket();           /* Creates and returns a pointer to a new packet    */
@@ -0,0 +1,90 @@
+/*
+  statout.h
+
+  Declarations for the structured statistics output (selected with -j),
+  which writes every reported statistic as a record with named fields.
+  
+ */
+/*****************************************************************************/
+/* This file is part of the RSIM Simulator.                                  */
+/*                                                                           */
+/******************************************************************************/
+/* University of Illinois/NCSA Open Source License                            */
+/*                                                                            */
+/* Copyright (c) 2002 The Board of Trustees of the University of Illinois and */
+/* William Marsh Rice University                                              */
+/*                                                                            */
+/* All rights reserved.                                                       */
+/*                                                                            */
+/* Developed by: Professor Sarita Adve's RSIM research group                  */
+/*               University of Illinois at Urbana-Champaign and William Marsh */
+/*                 Rice University                                            */
+/*               http://www.cs.uiuc.edu/rsim and                              */
+/*                 http://www.ece.rice.edu/~rsim/dist.html                    */
+/*                                                                            */
+/* Permission is hereby granted, free of charge, to any person obtaining a    */
+/* copy of this software and associated documentation files (the "Software"), */
+/* to deal with the Software without restriction, including without           */
+/* limitation the rights to use, copy, modify, merge, publish, distribute,    */
+/* sublicense, and/or sell copies of the Software, and to permit persons to   */
+/* whom the Software is furnished to do so, subject to the following          */
+/* conditions:                                                                */
+/*                                                                            */
+/*     * Redistributions of source code must retain the above copyright       */
+/* notice, this list of conditions and the following disclaimers.             */
+/*                                                                            */
+/*     * Redistributions in binary form must reproduce the above copyright    */
+/* notice, this list of conditions and the following disclaimers in the       */
+/* documentation and/or other materials provided with the distribution.       */
+/*                                                                            */
+/*     * Neither the names of Professor Sarita Adve's RSIM research group,    */
+/* the University of Illinois at Urbana-Champaign, William Marsh Rice         */
+/* University, nor the names of its contributors may be used to endorse or    */
+/* promote products derived from this Software without specific prior written */
+/* permission.                                                                */
+/*                                                                            */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    */
+/* THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR  */
+/* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,      */
+/* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR      */
+/* OTHER DEALINGS WITH THE SOFTWARE.                                          */
+/******************************************************************************/
+
+#ifndef _statout_h_
+#define _statout_h_ 1
+
+#include <stdio.h>
+
+/* Every record has the same fields, in this order:
+
+     time    simulated time of the report
+     phase   processor phase, or number of the memory system report
+     scope   "proc", "cache", "wbuf", "bus", "dir", "smnet", "net", ...
+     module  module name, such as "proc0", "cache0" or "dir0_0"
+     stat    name of the statistic
+     field   "value" for a plain number; "samples", "mean", "stddev",
+             "min", "max" or "bin<i>" for a statistics record; or the
+             category of a broken-down count
+     value   the number (null or empty if not a number)
+     unit    unit of the value, such as "cycles", "count" or "fraction"
+
+   With a file name ending in ".csv" the records are written as CSV with
+   a header line, otherwise as JSON Lines. */
+
+extern FILE *StatOut;           /* structured output, or NULL if off   */
+
+/* Callers test StatOut before writing records, as STATOUT does, so that
+   nothing is computed for them when structured output is off */
+
+#define STATOUT(stat,v,unit) {if (StatOut) StatOutValue(stat,"value",(double)(v),unit);}
+
+void StatOutOpen(const char *);                 /* start output to a file */
+void StatOutPhase(int);                         /* phase of later records */
+void StatOutScope(const char *, const char *);  /* scope and module       */
+void StatOutValue(const char *, const char *, double, const char *);
+                                                /* stat,field,value,unit */
+void StatOutStatrec(const char *, STATREC *);   /* all fields of a statrec */
+
+#endif
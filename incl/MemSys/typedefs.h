@@ -96,6 +96,7 @@ typedef struct YS__Act        ACTIVITY;
 typedef struct YS__Event      EVENT;
 typedef struct YS__Mess       MESSAGE;
 typedef struct YS__Stat       STATREC;
+typedef struct YS__StatCtr    STATCTR;
 
 typedef struct YS__Prcr       PROCESSOR;
 typedef struct YS__Mod        MODULE;
@@ -0,0 +1,138 @@
+/*****************************************************************************/
+/*   decfile.h : On-disk format of predecoded instruction files              */
+/*****************************************************************************/
+/*****************************************************************************/
+/* This file is part of the RSIM Simulator.                                  */
+/*                                                                           */
+/******************************************************************************/
+/* University of Illinois/NCSA Open Source License                            */
+/*                                                                            */
+/* Copyright (c) 2002 The Board of Trustees of the University of Illinois and */
+/* William Marsh Rice University                                              */
+/*                                                                            */
+/* All rights reserved.                                                       */
+/*                                                                            */
+/* Developed by: Professor Sarita Adve's RSIM research group                  */
+/*               University of Illinois at Urbana-Champaign and William Marsh */
+/*                 Rice University                                            */
+/*               http://www.cs.uiuc.edu/rsim and                              */
+/*                 http://www.ece.rice.edu/~rsim/dist.html                    */
+/*                                                                            */
+/* Permission is hereby granted, free of charge, to any person obtaining a    */
+/* copy of this software and associated documentation files (the "Software"), */
+/* to deal with the Software without restriction, including without           */
+/* limitation the rights to use, copy, modify, merge, publish, distribute,    */
+/* sublicense, and/or sell copies of the Software, and to permit persons to   */
+/* whom the Software is furnished to do so, subject to the following          */
+/* conditions:                                                                */
+/*                                                                            */
+/*     * Redistributions of source code must retain the above copyright       */
+/* notice, this list of conditions and the following disclaimers.             */
+/*                                                                            */
+/*     * Redistributions in binary form must reproduce the above copyright    */
+/* notice, this list of conditions and the following disclaimers in the       */
+/* documentation and/or other materials provided with the distribution.       */
+/*                                                                            */
+/*     * Neither the names of Professor Sarita Adve's RSIM research group,    */
+/* the University of Illinois at Urbana-Champaign, William Marsh Rice         */
+/* University, nor the names of its contributors may be used to endorse or    */
+/* promote products derived from this Software without specific prior written */
+/* permission.                                                                */
+/*                                                                            */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    */
+/* THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR  */
+/* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,      */
+/* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR      */
+/* OTHER DEALINGS WITH THE SOFTWARE.                                          */
+/******************************************************************************/
+
+
+#ifndef _decfile_h_
+#define _decfile_h_ 1
+
+#include "Processor/instruction.h"
+
+/* A .dec file starts with a DecHeader, followed by one checksum for each
+   chunk of DEC_CHUNK instructions and then by the instructions. Each
+   instruction is DEC_FIELDS 32-bit words packed as in DecPack, in the
+   byte order of the host that ran predecode (recorded in byteorder).
+   The header checksum covers the chunk checksums, so the simulator can
+   check the header at startup and each chunk when it is first fetched
+   from. */
+
+#define DEC_MAGIC       0x52444543      /* "RDEC" */
+#define DEC_VERSION     2
+#define DEC_BYTEORDER   0x01020304
+#define DEC_FIELDS      5               /* words per instruction */
+#define DEC_CHUNKSHIFT  10
+#define DEC_CHUNK       (1<<DEC_CHUNKSHIFT)
+
+struct DecHeader
+{
+  int magic;
+  int version;
+  int byteorder;
+  int fields;
+  int ninstrs;
+  int chunk;
+  unsigned checksum;		/* of the chunk checksum table */
+  int pad;
+};
+
+inline int DecChunks(int ninstrs) {return (ninstrs+DEC_CHUNK-1)/DEC_CHUNK;}
+
+inline unsigned DecChecksum(const void *buf, int len) /* Adler-32 */
+{
+  const unsigned char *p = (const unsigned char *)buf;
+  unsigned a = 1, b = 0;
+  while (len-- > 0)
+    {
+      a = (a + *p++) % 65521;
+      b = (b + a) % 65521;
+    }
+  return (b << 16) | a;
+}
+
+inline unsigned DecSwap(unsigned w)
+{
+  return (w >> 24) | ((w >> 8) & 0xff00) | ((w << 8) & 0xff0000) | (w << 24);
+}
+
+/* The packing matches the bit field layout of struct instr under the
+   usual low-bit-first allocation, in which case the simulator uses the
+   file in place */
+
+inline void DecPack(const instr& i, int *w)
+{
+  w[0] = i.imm;
+  w[1] = i.aux2;
+  w[2] = (i.instruction & 0x1ff) | ((i.rd & 0xff) << 9) |
+    ((i.rcc & 0xff) << 17) | ((i.rscc & 0x7f) << 25);
+  w[3] = (i.rs1 & 0x3ffff) | ((i.rs2 & 0xff) << 18) |
+    ((i.rd_regtype & 7) << 26) | ((i.rs1_regtype & 7) << 29);
+  w[4] = (i.rs2_regtype & 7) | ((i.aux1 & 0xffff) << 3) | (i.taken << 19) |
+    (i.annul << 20) | (i.cond_branch << 21) | ((i.uncond_branch & 7) << 22) |
+    ((i.wpchange & 3) << 25);
+}
+
+inline int DecField(unsigned w, int lo, int bits) /* sign-extended */
+{
+  return int(w << (32-lo-bits)) >> (32-bits);
+}
+
+inline void DecUnpack(const int *rec, int swap, instr& i)
+{
+  unsigned w[DEC_FIELDS];
+  for (int f=0; f<DEC_FIELDS; f++)
+    w[f] = swap ? DecSwap((unsigned)rec[f]) : (unsigned)rec[f];
+  i = instr(INSTRUCTION(w[2] & 0x1ff),DecField(w[2],9,8),DecField(w[2],17,8),
+	    DecField(w[3],0,18),DecField(w[3],18,8),DecField(w[2],25,7),
+	    DecField(w[4],3,16),int(w[1]),int(w[0]),
+	    REGTYPE((w[3] >> 26) & 7),REGTYPE((w[3] >> 29) & 7),REGTYPE(w[4] & 7),
+	    (w[4] >> 19) & 1,(w[4] >> 20) & 1,(w[4] >> 21) & 1,(w[4] >> 22) & 7,
+	    WPC(DecField(w[4],25,2)));
+}
+
+#endif
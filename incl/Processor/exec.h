@@ -61,7 +61,7 @@ class instance;
 extern void IssueQueues(state *proc);
 extern void FlushReadyQueues(int, state *);
 extern void CompleteQueues(state *);
-extern unsigned GetMap(instance *, state *);
+extern char *GetMap(instance *, state *, int write=0);
 extern void UnitSetup(state *, int except);
 
 typedef void (*EFP)(instance *, state *);
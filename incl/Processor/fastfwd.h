@@ -0,0 +1,87 @@
+/*****************************************************************************/
+/*   fastfwd.h : Functional fast-forward ahead of detailed simulation        */
+/*****************************************************************************/
+/*****************************************************************************/
+/* This file is part of the RSIM Simulator.                                  */
+/*                                                                           */
+/******************************************************************************/
+/* University of Illinois/NCSA Open Source License                            */
+/*                                                                            */
+/* Copyright (c) 2002 The Board of Trustees of the University of Illinois and */
+/* William Marsh Rice University                                              */
+/*                                                                            */
+/* All rights reserved.                                                       */
+/*                                                                            */
+/* Developed by: Professor Sarita Adve's RSIM research group                  */
+/*               University of Illinois at Urbana-Champaign and William Marsh */
+/*                 Rice University                                            */
+/*               http://www.cs.uiuc.edu/rsim and                              */
+/*                 http://www.ece.rice.edu/~rsim/dist.html                    */
+/*                                                                            */
+/* Permission is hereby granted, free of charge, to any person obtaining a    */
+/* copy of this software and associated documentation files (the "Software"), */
+/* to deal with the Software without restriction, including without           */
+/* limitation the rights to use, copy, modify, merge, publish, distribute,    */
+/* sublicense, and/or sell copies of the Software, and to permit persons to   */
+/* whom the Software is furnished to do so, subject to the following          */
+/* conditions:                                                                */
+/*                                                                            */
+/*     * Redistributions of source code must retain the above copyright       */
+/* notice, this list of conditions and the following disclaimers.             */
+/*                                                                            */
+/*     * Redistributions in binary form must reproduce the above copyright    */
+/* notice, this list of conditions and the following disclaimers in the       */
+/* documentation and/or other materials provided with the distribution.       */
+/*                                                                            */
+/*     * Neither the names of Professor Sarita Adve's RSIM research group,    */
+/* the University of Illinois at Urbana-Champaign, William Marsh Rice         */
+/* University, nor the names of its contributors may be used to endorse or    */
+/* promote products derived from this Software without specific prior written */
+/* permission.                                                                */
+/*                                                                            */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    */
+/* THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR  */
+/* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,      */
+/* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR      */
+/* OTHER DEALINGS WITH THE SOFTWARE.                                          */
+/******************************************************************************/
+
+#ifndef _fastfwd_h_
+#define _fastfwd_h_ 1
+
+struct state;
+
+/* Number of instructions a processor fast-forwards per simulated cycle */
+#define FF_QUANTUM 1000
+
+extern int fast_forward;	/* -s: functional mode until first newphase */
+extern long long ff_instructions; /* instructions fast-forwarded so far */
+
+/* Statistical sampling (-b ff,warm,measure). Each processor repeatedly
+   fast-forwards "ff" instructions, warms up the detailed pipeline and
+   caches for "warm" graduated instructions, and then measures "measure"
+   graduated instructions; state::report_samples reports the results. */
+enum
+{
+  SAMPLE_OFF,			/* sampling not in use */
+  SAMPLE_FF,			/* functional fast-forward */
+  SAMPLE_WARM,			/* detailed, statistics discarded */
+  SAMPLE_MEASURE,		/* detailed, statistics recorded */
+  SAMPLE_DRAIN			/* no fetch until the pipeline is empty */
+};
+
+extern int sampling;		/* -b given */
+extern int sample_ff, sample_warm, sample_measure; /* interval lengths */
+
+/* Functionally execute up to quantum instructions of proc, bypassing
+   the out-of-order pipeline. With -s, ends fast-forward mode for all
+   processors when a newphase marker is reached. */
+extern int FastForward(state *proc, int quantum);
+
+/* Move proc to the next sampling interval once the current one is done;
+   called every cycle with -b. */
+extern void SampleCycle(state *proc);
+
+#endif
@@ -209,6 +209,7 @@ struct instance                          /* this is a _dynamic_ instruction */
     
   /*Constructor to initialize  instance */
   decode_instruction(instr *instrn,state *proc);
+  instance() {}	/* fields filled in by the fast-forward engine */
   instance(instr *instrn, state *proc)
   {decode_instruction(instrn,proc);}
   instance(instance *inst) {*this=*inst;new2ndinst++;}
@@ -88,4 +88,47 @@ public:
   int GetMin(instance *& min, int& tag); /* return min object & matching tag & timestamp */
 };
 
+/****************************************************************************/
+/******************* InstWheel class defintion ******************************/
+/****************************************************************************/
+
+/* An InstWheel holds the same (timestamp, instance, tag) entries as an
+   InstHeap and hands them back in the same order, but keeps them in a
+   ring of per-cycle slots. The slots cover the wheelsz cycles starting
+   at base; the rare entry further out waits in an ordinary InstHeap until
+   the wheel turns far enough to take it. Since completion times are only
+   a few cycles ahead, insert and GetMin do not depend on the number of
+   entries held. An entry for a cycle that has already passed goes in the
+   slot for base, which is always the first one drained. */
+
+class InstWheel
+{
+  typedef instance *instptr;
+
+  struct Slot
+  {
+    int first, n, size;	/* live entries are [first,n) */
+    instance **obj;
+    int *tags;
+    int *ord;
+  };
+
+private:
+  static int wheelsz; /* must be a power of 2 */
+  Slot *slots;
+  int base;		/* earliest cycle held in the slots */
+  int used;		/* entries in the slots */
+  InstHeap overflow;	/* entries at base+wheelsz or later */
+  void SlotInsert(Slot &, int ts, instance *o, int tag);
+  void rebase(int);
+  int FirstCycle() const;
+
+public:
+  InstWheel();
+  int insert(int ts, instance *o, int tag);
+  int num() const {return used+overflow.num();}
+  int PeekMin(); /* return min timestamp */
+  int GetMin(instance *& min, int& tag); /* return min object & matching tag & timestamp */
+};
+
 #endif
@@ -125,42 +125,49 @@ extern char *inames[numINSTRS];                   /* instruction names array */
 
 struct instr                  /************** this is a _static_ instruction */
 {
-  INSTRUCTION instruction;
+  /* Every fetched instruction is read through this structure, so it
+     is packed into five words; the widths below cover every value
+     predecode produces (rs1 includes PRIV_REGISTERS + n). decfile.h
+     relies on this field order and these widths. */
+
+  int imm;				/* immediate field */
+  int aux2;
+
+  INSTRUCTION instruction : 9;
 
 /* WRITTEN REGISTERS */
-  int rd;				/* destination register */
-  int rcc; 				/* destination condition code register */
+  int rd : 8;				/* destination register */
+  int rcc : 8; 				/* destination condition code register */
 
 /* READ REGISTERS */
-  int rs1;				/* source register 1 */
-  int rs2;				/* source register 2 */
-  int rscc;				/* source condition code register */
-
-/* AUXILIARY DATA */  
-  int aux1;				
-  int aux2;
-  int imm;				/* immediate field */
+  int rscc : 7;				/* source condition code register */
+  int rs1 : 18;				/* source register 1 */
+  int rs2 : 8;				/* source register 2 */
 
 /* BIT FIELDS */
   
-  REGTYPE rd_regtype; 			/* is rd a floating point?  */
-  REGTYPE rs1_regtype;			/* is rs1 a floating point? */
-  REGTYPE rs2_regtype;			/* is rs2 a floating point? */
-  int taken;				/* taken hint for branches  */
-  int annul;				/* annul bit for branches   */
-  int cond_branch; 			/* indicate conditional branch */
-  int uncond_branch; 			/* indicate non-conditional branch
+  REGTYPE rd_regtype : 3; 		/* is rd a floating point?  */
+  REGTYPE rs1_regtype : 3;		/* is rs1 a floating point? */
+  REGTYPE rs2_regtype : 3;		/* is rs2 a floating point? */
+
+/* AUXILIARY DATA */  
+  int aux1 : 16;				
+
+  unsigned taken : 1;			/* taken hint for branches  */
+  unsigned annul : 1;			/* annul bit for branches   */
+  unsigned cond_branch : 1; 		/* indicate conditional branch */
+  unsigned uncond_branch : 3; 		/* indicate non-conditional branch
 					0 for other,
 					1 for address calc needed,
 					2 for immediate address,
 					3 for "call",
 					4 for probable return (address calc needed) */
 
-  WPC wpchange; 			/* indicate instructions that change window
+  WPC wpchange : 2; 			/* indicate instructions that change window
 					   pointer +1 for save, -1 for restore */
   
-  instr(): instruction(iRESERVED),aux1(0),aux2(0),imm(0) {rscc=rcc=rd=rs1=rs2=0;rd_regtype=rs1_regtype=rs2_regtype=REG_INT;wpchange=WPC_NONE;taken=annul=cond_branch=uncond_branch=0;}
-  instr(INSTRUCTION i): instruction(i),aux1(0),aux2(0),imm(0) {rscc=rcc=rd=rs1=rs2=0;rd_regtype=rs1_regtype=rs2_regtype=REG_INT;wpchange=WPC_NONE;taken=annul=cond_branch=uncond_branch=0;}
+  instr(): imm(0),aux2(0),instruction(iRESERVED),aux1(0) {rscc=rcc=rd=rs1=rs2=0;rd_regtype=rs1_regtype=rs2_regtype=REG_INT;wpchange=WPC_NONE;taken=annul=cond_branch=uncond_branch=0;}
+  instr(INSTRUCTION i): imm(0),aux2(0),instruction(i),aux1(0) {rscc=rcc=rd=rs1=rs2=0;rd_regtype=rs1_regtype=rs2_regtype=REG_INT;wpchange=WPC_NONE;taken=annul=cond_branch=uncond_branch=0;}
   instr (INSTRUCTION in_instruction, int in_rd, int in_rcc, int in_rs1, int in_rs2, int in_rscc, int in_aux1, int in_aux2, int in_imm, REGTYPE in_rd_regtype, REGTYPE in_rs1_regtype, REGTYPE in_rs2_regtype, int in_taken, int in_annul, int in_cond_branch, int in_uncond_branch, WPC in_wpchange) {instruction=in_instruction;aux1=in_aux1;aux2=in_aux2;imm=in_imm;rscc=in_rscc;rcc=in_rcc;rd=in_rd;rs1=in_rs1;rs2=in_rs2;rd_regtype=in_rd_regtype;rs1_regtype=in_rs1_regtype;rs2_regtype=in_rs2_regtype;wpchange=in_wpchange;taken=in_taken;annul=in_annul;cond_branch=in_cond_branch;uncond_branch=in_uncond_branch;}
 
 
@@ -168,11 +175,7 @@ struct instr                  /************** this is a _static_ instruction */
      support, int register #0 is constantly mapped to the number 0, so
      the value is always ready and can be ignored as a dependence */
 
-  /* writing instruction to a file */
-  void output(FILE *out) {fwrite((const char *)this,sizeof(instr),1,out);}
-
-  /* reading instruction from a file */
-  void input(FILE *in) {fread((char *)this,sizeof(instr),1,in);}
+  /* see decfile.h for reading and writing instructions to a file */
 
   /* printing a file */
   void print(); // define it as appropriate in other files
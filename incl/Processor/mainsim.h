@@ -58,9 +58,22 @@ extern int simulate_ilp;
 extern int stat_sched;
 
 #ifdef __cplusplus
+#include "Processor/decfile.h"
+
 extern instr *instr_array;
 extern int num_instructions;
 
+extern char *instr_chunk_ready;
+extern void LoadInstrChunk(int);
+
+/* instr_array + pc, checking its chunk of the .dec file on first use */
+inline instr *FetchInstr(int pc)
+{
+  if (!instr_chunk_ready[pc >> DEC_CHUNKSHIFT])
+    LoadInstrChunk(pc >> DEC_CHUNKSHIFT);
+  return instr_array + pc;
+}
+
 enum SpecStores {SPEC_STALL, SPEC_LIMBO, SPEC_EXCEPT};
 extern SpecStores spec_stores;
 /* 
@@ -4,7 +4,9 @@
   
   Definition and implementation of the MemQ class. The MemQ class defines
   a specialized linked list used to implement the memory queues in the
-  processor
+  processor. Each MemQ keeps its own pool of links, so inserting and
+  removing elements does not allocate memory once the pool has grown to
+  the size the queue needs.
   
   ***************************************************************************/
 /*****************************************************************************/
@@ -59,6 +61,9 @@
 #define _memq_h_ 1
 
 #include <stddef.h>
+#include <malloc.h>
+
+#define MEMQ_CHUNK 32			/* links added to a pool at a time */
 
 /*************************************************************************/
 /***************** Individual elements of MemQ ***************************/
@@ -82,11 +87,15 @@ private:
     MemQLink<Data> *head;
     MemQLink<Data> *tail;
     int items;
+    MemQLink<Data> *freelinks;			/* pool of unused links */
+    MemQLink<Data> *NewLink(Data d);		/* get link from pool */
+    void FreeLink(MemQLink<Data> *l)		/* return link to pool */
+	{l->next=freelinks; freelinks=l;}
 public:
-    MemQ(): head(NULL),tail(NULL),items(0) {}	/* constructor */
+    MemQ(): head(NULL),tail(NULL),items(0),freelinks(NULL) {} /* constructor */
   void restart() {				/* destructor  */
 	MemQLink<Data> *old;
-	while (head != NULL) {old=head; head=head->next; delete old;}
+	while (head != NULL) {old=head; head=head->next; FreeLink(old);}
 	head=tail=NULL; items=0;}
     void Insert(Data d);			/* insert element */
     int Lookup(Data d);				/* search for element */
@@ -112,12 +121,34 @@ public:
 /***************** MemQ class implementation *****************************/
 /*************************************************************************/
 
+/********************* Link pool ****************************************/
+
+/* Links are malloc'ed a chunk at a time, like the objects of an
+   Allocator, and are never given back; a removed link goes back to the
+   pool of its queue. */
+
+template <class Data> inline MemQLink<Data> *MemQ<Data>::NewLink(Data d)
+{
+  MemQLink<Data> *item;
+  if (freelinks == NULL)	{
+    MemQLink<Data> *chunk =
+      (MemQLink<Data> *)malloc(sizeof(MemQLink<Data>)*MEMQ_CHUNK);
+    for (int i=0; i<MEMQ_CHUNK; i++)
+      FreeLink(&chunk[i]);
+  }
+  item = freelinks;
+  freelinks = item->next;
+  item->d = d;
+  item->next = item->prev = NULL;
+  return item;
+}
+
 /********************* Insert operation *********************************/
 
 template <class Data> inline void MemQ<Data>::Insert(Data d)
 {
   items++;
-  MemQLink<Data> *item = new MemQLink<Data>(d);
+  MemQLink<Data> *item = NewLink(d);
   if (tail == NULL)	{
     head=tail=item;
   }
@@ -182,7 +213,7 @@ template <class Data> inline void MemQ<Data>::Remove(MemQLink<Data> *stepper)
     stepper->next->prev = stepper->prev;
     stepper->prev->next = stepper->next;
   }
-  delete stepper;
+  FreeLink(stepper);
 }
 
 template <class Data> inline int MemQ<Data>::Remove(Data d)
@@ -239,13 +270,13 @@ template <class Data> inline void MemQ<Data>::RemoveTail()
     items--;
     
     if (tail == head){
-      delete tail;
+      FreeLink(tail);
       head=tail=NULL;
     } else{
       register MemQLink<Data> *stepper = tail;
       tail = tail->prev;
       tail->next = NULL;
-      delete stepper;
+      FreeLink(stepper);
     }
   }
 }
@@ -0,0 +1,177 @@
+/*****************************************************************************/
+/*   pagemap.h : Translation of simulated pages to simulator memory          */
+/*****************************************************************************/
+/*****************************************************************************/
+/* This file is part of the RSIM Simulator.                                  */
+/*                                                                           */
+/******************************************************************************/
+/* University of Illinois/NCSA Open Source License                            */
+/*                                                                            */
+/* Copyright (c) 2002 The Board of Trustees of the University of Illinois and */
+/* William Marsh Rice University                                              */
+/*                                                                            */
+/* All rights reserved.                                                       */
+/*                                                                            */
+/* Developed by: Professor Sarita Adve's RSIM research group                  */
+/*               University of Illinois at Urbana-Champaign and William Marsh */
+/*                 Rice University                                            */
+/*               http://www.cs.uiuc.edu/rsim and                              */
+/*                 http://www.ece.rice.edu/~rsim/dist.html                    */
+/*                                                                            */
+/* Permission is hereby granted, free of charge, to any person obtaining a    */
+/* copy of this software and associated documentation files (the "Software"), */
+/* to deal with the Software without restriction, including without           */
+/* limitation the rights to use, copy, modify, merge, publish, distribute,    */
+/* sublicense, and/or sell copies of the Software, and to permit persons to   */
+/* whom the Software is furnished to do so, subject to the following          */
+/* conditions:                                                                */
+/*                                                                            */
+/*     * Redistributions of source code must retain the above copyright       */
+/* notice, this list of conditions and the following disclaimers.             */
+/*                                                                            */
+/*     * Redistributions in binary form must reproduce the above copyright    */
+/* notice, this list of conditions and the following disclaimers in the       */
+/* documentation and/or other materials provided with the distribution.       */
+/*                                                                            */
+/*     * Neither the names of Professor Sarita Adve's RSIM research group,    */
+/* the University of Illinois at Urbana-Champaign, William Marsh Rice         */
+/* University, nor the names of its contributors may be used to endorse or    */
+/* promote products derived from this Software without specific prior written */
+/* permission.                                                                */
+/*                                                                            */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    */
+/* THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR  */
+/* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,      */
+/* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR      */
+/* OTHER DEALINGS WITH THE SOFTWARE.                                          */
+/******************************************************************************/
+
+
+#ifndef _pagemap_h_
+#define _pagemap_h_ 1
+
+#include <stdlib.h>
+
+/* The simulated address space is 32 bits of ALLOC_SIZE (4 KB) pages,
+   so a page number is 20 bits. PageMap translates a page number to the
+   simulator memory that holds the page with a two-level radix table:
+   the upper PM_TOPBITS bits of the page number select a leaf of
+   pointers, which is allocated the first time any of its pages is
+   mapped. A lookup is two loads and no hashing, and pointers are held
+   at their native size so that 64-bit hosts work.
+
+   A page may also be mapped copy-on-write (see ShareWith): it is then
+   shared with other PageMaps, and whoever writes it first must give
+   itself a private copy and insert that in place of the shared one. */
+
+#define PM_PAGEBITS 20
+#define PM_TOPBITS 10
+#define PM_LEAFBITS (PM_PAGEBITS-PM_TOPBITS)
+#define PM_LEAFSIZE (1 << PM_LEAFBITS)
+#define PM_WORDBITS (8*sizeof(unsigned))
+
+struct PageMapLeaf
+{
+  char *page[PM_LEAFSIZE];                         /* NULL if unmapped */
+  unsigned cow[PM_LEAFSIZE/PM_WORDBITS];           /* copy-on-write bits */
+};
+
+class PageMap
+{
+private:
+  PageMapLeaf *leaves[1 << PM_TOPBITS];
+  int used;
+
+  PageMapLeaf *leaf(unsigned pg) const
+    {return leaves[(pg >> PM_LEAFBITS) & ((1 << PM_TOPBITS)-1)];}
+  PageMapLeaf *getleaf(unsigned pg);
+
+public:
+  PageMap() {for (int i=0; i < (1 << PM_TOPBITS); i++) leaves[i]=NULL; used=0;}
+  ~PageMap() {for (int i=0; i < (1 << PM_TOPBITS); i++) if (leaves[i]) free(leaves[i]);}
+
+  int insert(unsigned pg, char *pa, int cow=0); // returns 0 on failure
+  int lookup(unsigned pg, char *&pa) const // puts page into pa on success
+    {
+      PageMapLeaf *l = leaf(pg);
+      if (l == NULL || (pa = l->page[pg & (PM_LEAFSIZE-1)]) == NULL)
+	return 0;
+      return 1;
+    }
+  int IsShared(unsigned pg) const // is pg mapped copy-on-write?
+    {
+      PageMapLeaf *l = leaf(pg);
+      pg &= PM_LEAFSIZE-1;
+      return l != NULL && (l->cow[pg/PM_WORDBITS] >> (pg%PM_WORDBITS)) & 1;
+    }
+  int ShareWith(PageMap &); // map all our pages copy-on-write into another
+  int NumElts() const {return used;}
+};
+
+inline PageMapLeaf *PageMap::getleaf(unsigned pg)
+{
+  PageMapLeaf *&l = leaves[(pg >> PM_LEAFBITS) & ((1 << PM_TOPBITS)-1)];
+  if (l == NULL)
+    l = (PageMapLeaf *)calloc(1,sizeof(PageMapLeaf));
+  return l;
+}
+
+inline int PageMap::insert(unsigned pg, char *pa, int cow)
+{
+  PageMapLeaf *l = getleaf(pg);
+  if (l == NULL)
+    return 0;
+  pg &= PM_LEAFSIZE-1;
+  if (l->page[pg] == NULL)
+    used++;
+  l->page[pg] = pa;
+  if (cow)
+    l->cow[pg/PM_WORDBITS] |= 1u << (pg%PM_WORDBITS);
+  else
+    l->cow[pg/PM_WORDBITS] &= ~(1u << (pg%PM_WORDBITS));
+  return 1;
+}
+
+/* ShareWith: used at fork. Marks every page of this map copy-on-write
+   and maps it the same way in other, so the cost is one pass over the
+   mapped leaves rather than a copy of every page. */
+
+inline int PageMap::ShareWith(PageMap &other)
+{
+  for (int i=0; i < (1 << PM_TOPBITS); i++)
+    {
+      PageMapLeaf *l = leaves[i];
+      if (l == NULL)
+	continue;
+      for (int j=0; j < PM_LEAFSIZE; j++)
+	if (l->page[j])
+	  {
+	    l->cow[j/PM_WORDBITS] |= 1u << (j%PM_WORDBITS);
+	    if (!other.insert((i << PM_LEAFBITS) | j, l->page[j], 1))
+	      return 0;
+	  }
+    }
+  return 1;
+}
+
+/* Each processor also keeps a small direct-mapped software TLB of the
+   pages it has recently touched (private or shared), so most accesses
+   skip even the radix walk. An entry remembers whether the page may be
+   written in place; a copy-on-write page is entered read-only until its
+   first store makes it private. A processor's entries must be dropped
+   whenever its mappings change behind GetMap's back, as fork does when
+   it turns the parent's pages copy-on-write (see FlushTLB). */
+
+#define TLB_SIZE 64   /* must be a power of 2 */
+#define TLB_NOPAGE ((unsigned)~0) /* no 20-bit page number matches this */
+
+struct TLBEntry
+{
+  unsigned pg;
+  char *base;
+  int writable;
+};
+
+#endif
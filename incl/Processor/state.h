@@ -61,6 +61,7 @@
 #include "alloc.h"
 #include "allocator.h"
 #include "memq.h"
+#include "storeq.h"
 #include "units.h"
 #include "stallq.h"
 #include "tagcvt.h"
@@ -122,6 +123,7 @@ extern int NUM_WINS; /* number of register windows: must be a power of 2. */
 #define NO_OF_PHYSICAL_FP_REGISTERS (NO_OF_LOGICAL_FP_REGISTERS + MAX_ACTIVE_NUMBER)
 
 #include "hash.h"
+#include "pagemap.h"
 
 
 /*****************************************************************************/
@@ -284,13 +286,13 @@ struct state
   MiniStallQ BranchDepQ;		/* data structure which keeps track of
 					  stalled branch instructions       */
   int MaxUnits[numUTYPES];		/* maximum number of FU's per type  */
-  InstHeap Running;                     /* data structure which keeps track of
+  InstWheel Running;                    /* data structure which keeps track of
 					   when instructions complete */
 
   unsigned highheap; 			/* The extent of the processor heap */
   unsigned lowstack; 			/* The low address of the stack */
-  HashTable<unsigned, unsigned> PageTable; /* (mem_map1,mem_map2) are the
-					    hashing functions */
+  PageMap PageTable;                    /* private pages: heap and stack */
+  TLBEntry tlb[TLB_SIZE];               /* recently used pages (see GetMap) */
         
   class stallqueue *stallq;             /* Holds stalled instruction if
 					   processor runs out of renaming
@@ -307,9 +309,9 @@ struct state
   MemQ<class BranchQElement *> branchq;
     
   /* DoneHeap definition*/
-  InstHeap DoneHeap;			/* keeps track of instructions that
+  InstWheel DoneHeap;			/* keeps track of instructions that
 					  are done                         */
-  InstHeap MemDoneHeap;			/* keeps track of memory instructions
+  InstWheel MemDoneHeap;		/* keeps track of memory instructions
 					  that are done                    */
   
   /* Mappers from logical to physical for int and FP*/
@@ -341,7 +343,7 @@ struct state
 
 #ifndef STORE_ORDERING
   MemQ<instance *> LoadQueue;		/* load queue                       */
-  MemQ<instance *> StoreQueue;		/* store queue                      */
+  StoreQ StoreQueue;			/* store queue, indexed by address  */
   int StoresToMem;			/* keep track of stores outstanding */
 
   MemQ<int> st_tags;			/* list of store tags               */
@@ -410,6 +412,14 @@ struct state
 #else
   STATREC *MemQueueSize;		/* memory queue size                 */
 #endif
+  /* per-cycle counters batching the samples of the statrecs above;
+     folded into them by fold_stats before any report */
+  STATCTR *SPECSctr, *ACTIVELISTctr, *FUUsagectr[numUTYPES];
+#ifndef STORE_ORDERING
+  STATCTR *VSBctr, *LoadQueueSizectr;
+#else
+  STATCTR *MemQueueSizectr;
+#endif
 
   STATREC *lat_contrs[lNUM_LAT_TYPES];	/* execution time components         */
   STATREC *partial_otime;		/* partial overlap times             */
@@ -418,6 +428,14 @@ struct state
   
   int stats_phase;			/* stats collection phase            */
 
+  /* statistical sampling (-b); see fastfwd.cc */
+  int sample_mode;			/* type of the current interval      */
+  int sample_left;			/* instructions left to fast-forward */
+  int sample_mark;			/* graduates when warmup started     */
+  STATREC *sample_ipc;			/* IPC of each measured interval     */
+  STATREC *sample_l1miss, *sample_l2miss; /* demand miss rates per interval */
+  STATREC *sample_lat[lNUM_LAT_TYPES];	/* lat_contrs ratios per interval    */
+
   STATREC *in_except;                   /* time spent waiting to trap */
   
   /* classify read, write, and rmw times based on different metrics */
@@ -469,13 +487,16 @@ struct state
   ~state()			/* destructor                        */
 	{if (corefile) fclose(corefile);}
 
-  void copy(const state *); 	/* copy state into another proc      */
-  state *fork() const; 
+  void copy(state *); 		/* copy state into another proc      */
+  state *fork(); 
   
   int SPARCtoLog(int iarch)	/* convert SPARC int register to logical reg */
 	{return convert_to_logical(cwp,iarch);}
   /* turns cwp, iarch pair into il */
 
+  void FlushTLB()		/* forget all cached page translations */
+	{for (int i=0; i<TLB_SIZE; i++) tlb[i].pg = TLB_NOPAGE;}
+
 
   /* branch prediction functions */
   void BPBSetup(); /* set up branch prediction table */
@@ -488,9 +509,12 @@ struct state
   /* Stats */
   void report_stats();
   void reset_stats();
+  void fold_stats();
   void report_phase();
   void report_phase_fast();
   void report_phase_in(char *);
+  void record_sample();
+  void report_samples();
   void report_partial();
   void endphase();
   void newphase(int);
@@ -511,16 +535,17 @@ struct state
 };
 
 /* Other useful function definitions (see .c files for descriptions) */
-extern HashTable<unsigned, unsigned> *SharedPageTable; // (mem_map1,mem_map2);
+extern PageMap *SharedPageTable;
 
 extern int DEBUG_TIME;		/* time to enable debugging on */
 
 extern void init_decode(state *);
 extern int reset_lists(state *);
 extern int ExceptionHandler(int, state *);
+extern int ProcessException(instance *, state *, int);
 extern int PreExceptionHandler(instance *, state *);
 
-extern void ComputeAvail(state *);
+extern void ComputeAvail(state *, int cycles=1);
 
 #define unstall_the_rest(proc) {if (proc->stall_the_rest) {proc->eff_losses[proc->type_of_stall_rest] += proc->stalledeff; proc->stall_the_rest=0; proc->type_of_stall_rest=eNOEFF_LOSS; proc->stalledeff = 0;}}
 
@@ -528,6 +553,7 @@ inline unsigned DOWN_TO_PAGE(unsigned i) { return i-i%ALLOC_SIZE;}
 inline unsigned UP_TO_PAGE(unsigned i) {unsigned j=i+ALLOC_SIZE-1; return j-j%ALLOC_SIZE;}
 
 extern "C" void RSIM_EVENT();
+extern int cycle_skip; /* skip cycles where all nodes wait on memory */
 extern int startup(char**,state *); // load executable, set up stack, data, some registers, etc.
 
 #endif
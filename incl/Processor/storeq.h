@@ -0,0 +1,314 @@
+/*****************************************************************************
+  
+  Processor/storeq.h
+  
+  Definition and implementation of the StoreQ class. A StoreQ is the MemQ
+  used for the store queue, together with an index of its stores by
+  address. Loads use the index to find the earlier stores they overlap
+  without walking the whole store queue.
+  
+  ***************************************************************************/
+/*****************************************************************************/
+/* This file is part of the RSIM Simulator.                                  */
+/*                                                                           */
+/******************************************************************************/
+/* University of Illinois/NCSA Open Source License                            */
+/*                                                                            */
+/* Copyright (c) 2002 The Board of Trustees of the University of Illinois and */
+/* William Marsh Rice University                                              */
+/*                                                                            */
+/* All rights reserved.                                                       */
+/*                                                                            */
+/* Developed by: Professor Sarita Adve's RSIM research group                  */
+/*               University of Illinois at Urbana-Champaign and William Marsh */
+/*                 Rice University                                            */
+/*               http://www.cs.uiuc.edu/rsim and                              */
+/*                 http://www.ece.rice.edu/~rsim/dist.html                    */
+/*                                                                            */
+/* Permission is hereby granted, free of charge, to any person obtaining a    */
+/* copy of this software and associated documentation files (the "Software"), */
+/* to deal with the Software without restriction, including without           */
+/* limitation the rights to use, copy, modify, merge, publish, distribute,    */
+/* sublicense, and/or sell copies of the Software, and to permit persons to   */
+/* whom the Software is furnished to do so, subject to the following          */
+/* conditions:                                                                */
+/*                                                                            */
+/*     * Redistributions of source code must retain the above copyright       */
+/* notice, this list of conditions and the following disclaimers.             */
+/*                                                                            */
+/*     * Redistributions in binary form must reproduce the above copyright    */
+/* notice, this list of conditions and the following disclaimers in the       */
+/* documentation and/or other materials provided with the distribution.       */
+/*                                                                            */
+/*     * Neither the names of Professor Sarita Adve's RSIM research group,    */
+/* the University of Illinois at Urbana-Champaign, William Marsh Rice         */
+/* University, nor the names of its contributors may be used to endorse or    */
+/* promote products derived from this Software without specific prior written */
+/* permission.                                                                */
+/*                                                                            */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    */
+/* THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR  */
+/* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,      */
+
+
+#ifndef _storeq_h_
+#define _storeq_h_ 1
+
+#include <stddef.h>
+#include "memq.h"
+#include "instance.h"
+
+/* Stores are filed by the 16-byte granule holding their first byte. No
+   memory operation is longer than 16 bytes, so a store overlapping a
+   given access starts in the granule before it or in one it touches. */
+
+#define STQ_GRANSHIFT 4
+#define STQ_BUCKETS 256				/* must be a power of 2 */
+#define STQ_CHUNK 64				/* entries allocated at a time */
+
+/*************************************************************************/
+/***************** Index entries of StoreQ *******************************/
+/*************************************************************************/
+
+struct StoreQEntry
+{
+    MemQLink<instance *> *link;		/* queue element of the store */
+    StoreQEntry *next;			/* next entry in the same bucket */
+};
+
+
+/*************************************************************************/
+/***************** StoreQ class definition *******************************/
+/*************************************************************************/
+
+class StoreQ : public MemQ<instance *>
+{
+private:
+    StoreQEntry *buckets[STQ_BUCKETS];
+    StoreQEntry *freelist;
+    instance **found;				/* result of Overlaps */
+    int foundsize;
+
+    static unsigned Bucket(unsigned addr)
+	{unsigned g = addr >> STQ_GRANSHIFT;
+	 return (g ^ (g >> 8)) & (STQ_BUCKETS-1);}
+    void Index(MemQLink<instance *> *stepper);
+    void Unindex(MemQLink<instance *> *stepper);
+public:
+    StoreQ(): freelist(NULL),found(NULL),foundsize(0)	/* constructor */
+	{for (int i=0; i<STQ_BUCKETS; i++) buckets[i]=NULL;}
+    void restart()				/* destructor  */
+	{while (NumItems()) RemoveTail();}
+    void Insert(instance *d);			/* insert element */
+    int Remove(instance *d);			/* delete element */
+    void Remove(MemQLink<instance *> *stepper);	/* delete element: type 2 */
+    int RemoveGetPrev(instance *d, instance *&d2); /* delete element: type 3 */
+    int RemoveGetNext(instance *d, instance *&d2); /* delete element: type 4 */
+    int Replace(instance *d,instance *d2);	/* replace element */
+    void Replace(MemQLink<instance *> *stepper,instance *d2); /* type 2 */
+    void RemoveTail();				/* delete tail */
+    void AddrReady(instance *d);		/* file store under its address */
+    int Overlaps(instance *ld, instance **&sts);/* earlier overlapping stores */
+};
+
+/*************************************************************************/
+/***************** StoreQ class implementation ***************************/
+/*************************************************************************/
+
+/********************* Index maintenance ********************************/
+
+/* Only stores with a known address are in the index; each is filed by
+   its queue element, which stays the same when the store is Replaced. */
+
+inline void StoreQ::Index(MemQLink<instance *> *stepper)
+{
+  unsigned b = Bucket(stepper->d->addr);
+  StoreQEntry *e;
+
+  for (e = buckets[b]; e != NULL; e = e->next)
+    if (e->link == stepper)
+      return;
+  if (freelist == NULL)	{
+    StoreQEntry *chunk = new StoreQEntry[STQ_CHUNK];
+    for (int i=0; i<STQ_CHUNK; i++)	{
+      chunk[i].next = freelist;
+      freelist = &chunk[i];
+    }
+  }
+  e = freelist;
+  freelist = e->next;
+  e->link = stepper;
+  e->next = buckets[b];
+  buckets[b] = e;
+}
+
+inline void StoreQ::Unindex(MemQLink<instance *> *stepper)
+{
+  if (!stepper->d->addr_ready)
+    return;
+  StoreQEntry **ep = &buckets[Bucket(stepper->d->addr)];
+  while (*ep != NULL)	{
+    StoreQEntry *e = *ep;
+    if (e->link == stepper)	{
+      *ep = e->next;
+      e->next = freelist;
+      freelist = e;
+      return;
+    }
+    ep = &e->next;
+  }
+}
+
+inline void StoreQ::AddrReady(instance *d)
+{
+  /* the store is most likely near the tail, so search from there */
+  MemQLink<instance *> *stepper = NULL;
+  while ((stepper = GetPrev(stepper)) != NULL)	{
+    if (stepper->d == d)	{
+      Index(stepper);
+      return;
+    }
+  }
+}
+
+/********************* Insert operation *********************************/
+
+inline void StoreQ::Insert(instance *d)
+{
+  MemQ<instance *>::Insert(d);
+  if (d->addr_ready)
+    Index(GetPrev(NULL));
+}
+
+/************************* Replace operations ****************************/
+
+inline void StoreQ::Replace(MemQLink<instance *> *stepper,instance *d2)
+{
+  Unindex(stepper);
+  MemQ<instance *>::Replace(stepper,d2);
+  if (d2->addr_ready)
+    Index(stepper);
+}
+
+inline int StoreQ::Replace(instance *d,instance *d2)
+{
+  MemQLink<instance *> *stepper = NULL;
+  while ((stepper = GetNext(stepper)) != NULL)   {
+    if (stepper->d == d)     {
+      Replace(stepper,d2);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**************************** Delete operations ***************************/
+
+inline void StoreQ::Remove(MemQLink<instance *> *stepper)
+{
+  Unindex(stepper);
+  MemQ<instance *>::Remove(stepper);
+}
+
+inline int StoreQ::Remove(instance *d)
+{
+  MemQLink<instance *> *stepper = NULL;
+  while ((stepper = GetNext(stepper)) != NULL)   {
+    if (stepper->d == d)     {
+      Remove(stepper);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+inline int StoreQ::RemoveGetPrev(instance *d, instance *&d2)
+{
+  MemQLink<instance *> *prev,*stepper = NULL;
+  while ((stepper = GetNext(stepper)) != NULL)   {
+    if (stepper->d == d)     {
+      prev = stepper->prev;
+      Remove(stepper);
+      if (prev != NULL)
+	d2 = prev->d;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+inline int StoreQ::RemoveGetNext(instance *d, instance *&d2)
+{
+  MemQLink<instance *> *next,*stepper = NULL;
+  while ((stepper = GetNext(stepper)) != NULL)   {
+    if (stepper->d == d)     {
+      next = stepper->next;
+      Remove(stepper);
+      if (next != NULL)
+	d2 = next->d;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+inline void StoreQ::RemoveTail()
+{
+  MemQLink<instance *> *stepper = GetPrev(NULL);
+  if (stepper)	{
+    Unindex(stepper);
+    MemQ<instance *>::RemoveTail();
+  }
+}
+
+/************************* Overlap lookup ********************************/
+
+/* Overlaps sets sts to the stores with known addresses that come before
+   load ld in program order and overlap it, oldest first, and returns
+   their number. The array is reused by the next call. */
+
+inline int StoreQ::Overlaps(instance *ld, instance **&sts)
+{
+  unsigned g = (ld->addr >> STQ_GRANSHIFT) - 1;
+  unsigned glast = ld->finish_addr >> STQ_GRANSHIFT;
+  unsigned seen[3];
+  int k, nseen = 0, n = 0;
+
+  if (foundsize < NumItems())	{
+    delete[] found;
+    foundsize = 2*NumItems();
+    found = new instance *[foundsize];
+  }
+  for (k=0; k<3; k++, g++)	{
+    unsigned b = Bucket(g << STQ_GRANSHIFT);
+    int i;
+    for (i=0; i<nseen; i++)
+      if (seen[i] == b)
+	break;
+    if (i == nseen)	{
+      seen[nseen++] = b;
+      for (StoreQEntry *e = buckets[b]; e != NULL; e = e->next)	{
+	instance *st = e->link->d;
+	if (st->tag < ld->tag &&
+	    ((st->finish_addr >= ld->finish_addr && ld->finish_addr >= st->addr) ||
+	     (ld->finish_addr >= st->finish_addr && st->finish_addr >= ld->addr)))	{
+	  /* keep the list in program order; it is almost always short */
+	  int j = n++;
+	  while (j > 0 && found[j-1]->tag > st->tag)	{
+	    found[j] = found[j-1];
+	    j--;
+	  }
+	  found[j] = st;
+	}
+      }
+    }
+    if (g == glast)
+      break;
+  }
+  sts = found;
+  return n;
+}
+
+#endif
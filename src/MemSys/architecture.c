@@ -84,8 +84,6 @@ int INTERCONNECTION_WIDTH_BYTES=16; /* width of ports */
 int INTERCONNECTION_WIDTH_BYTES_DIR=16; /* width of ports to directory */
 
 int MeshRoute(int *,int *,int); /*dimension-order routing function for mesh */
-extern OPORT *cpu_oport[256]; /* OPORTs of network */
-extern IPORT *cpu_iport[256]; /* IPORTs of network */
 
 PROCESSOR **cpu; /* array of CPU pointers */
 DEMUX **demux_table; /* array of demuxes */
@@ -115,6 +113,7 @@ int ARCH_l1type=PR_WT;
 int ARCH_cacsz1=16, ARCH_setsz1=1;
 int ARCH_cacsz2=64, ARCH_setsz2=4, ARCH_linesz=64;
 int ARCH_wbufsz=8, ARCH_dirbufsz=64;
+int ARCH_dirtype = CNTRL_FULL_MAP;
 int ARCH_nettype = MESH_NET, ARCH_NetBufsz=64;
 int ARCH_NetPortsz=64, ARCH_flitsz=8;
 int ARCH_flitd=4, ARCH_arbdelay=4;
@@ -189,7 +188,8 @@ void SystemInit()
   lvl2_linesz = linesz2;
   YS__NumNodes = ARCH_numnodes;
   
-  if (ARCH_nettype == MESH_NET) /* call dir_net_init to set up mesh network */
+  if (ARCH_nettype == MESH_NET || ARCH_nettype == TORUS_NET ||
+      ARCH_nettype == CMESH_NET) /* call dir_net_init to set up the network */
     dir_net_init (ARCH_numnodes, ARCH_cacsz1, ARCH_cacsz2, linesz1, linesz2,
 		  ARCH_setsz1, ARCH_setsz2,
 		  cohe1, cohe2, allo1, allo2, adap1, adap2, wbuf1, 
@@ -229,6 +229,7 @@ static void dir_net_init (int nodes, int cacsz, int cacsz2,
     
     double temp1;
     int dim_mesh[2];
+    int (*routefunc)(int *,int *,int);
     char name[32];
     struct Delays *DelayCPU;
     struct Delays *L1Delays;
@@ -258,30 +259,55 @@ static void dir_net_init (int nodes, int cacsz, int cacsz2,
 	oport_ptr = (OPORT **)malloc(sizeof(OPORT *) * nodes*2);  
 	
 	
-	if(nettype != MESH_NET)
-	  YS__errmsg("This version of RSIM supports only the mesh network.\n");
+	if(nettype != MESH_NET && nettype != TORUS_NET && nettype != CMESH_NET)
+	  YS__errmsg("This version of RSIM supports only the mesh, torus and cmesh networks.\n");
 	
 	/****** NETWORK *******/
 	
-	/* Set up the mesh network */
-	temp1 = sqrt((double)nodes);
+	/* Set up the network: a square 2-D array of routers, with
+	   CMESH_CONC nodes on each router for the concentrated mesh and
+	   one node per router otherwise */
+	temp1 = sqrt((double)(nettype == CMESH_NET ? nodes/CMESH_CONC : nodes));
 	dim_mesh[0] = (int)temp1;
+	if (nettype == CMESH_NET &&
+	    (dim_mesh[0] != temp1 || nodes % CMESH_CONC != 0))
+	  YS__errmsg("For a cmesh network number of nodes must be CMESH_CONC times a square\n");
 	if (dim_mesh[0] != temp1)
 	  YS__errmsg("For a mesh network number of  nodes must be a square\n");
 	dim_mesh[1] = dim_mesh[0];
-	fprintf(simout,"MESH:\tsize: %dx%d\tSpeed: %d (x prcr speed)\n",
+	fprintf(simout,"%s:\tsize: %dx%d\tSpeed: %d (x prcr speed)\n",
+		nettype == TORUS_NET ? "TORUS" : nettype == CMESH_NET ? "CMESH" : "MESH",
 	       dim_mesh[0], dim_mesh[1], flitd * FASTER_PROC );
 	fprintf(simout,"\tWidth of links: %g (in bytes)\tSwitch Buffer Size: %d (in flits; %s)\n",
 	       flitsz, NetBufsz, NetBufsz == (int)((double)linesz/flitsz) ? "=line size":"");
+	if (NetRouting != DOR_ROUTING &&
+	    (nettype != MESH_NET || NetModel == PACKET_NETMODEL))
+	  YS__errmsg("Adaptive routing is only available with the flit-level mesh\n");
+	fprintf(simout,"\tRouting: %s\n", NetRoutingName[NetRouting]);
 	
 	/* Call to CreateMesh(dim, mesh_size, bufferszinnetwork,port_size, iport*,
 	   oport*, router_function, mesh_num) */
 	/* We create a request net and a reply net for worm hole routing */
 	
-	CreateMESH (2, dim_mesh, NetBufsz, 1, iport_ptr, oport_ptr, MeshRoute, REPLY_NET);
-	/* Reply network */
-	CreateMESH (2, dim_mesh, NetBufsz, 1, iport_ptr+nodes, oport_ptr+nodes,
-		    MeshRoute, REQ_NET); /* Request network */
+	if (nettype == TORUS_NET)
+	  {
+	    CreateTORUS (2, dim_mesh, 1, iport_ptr, oport_ptr, REPLY_NET);
+	    CreateTORUS (2, dim_mesh, 1, iport_ptr+nodes, oport_ptr+nodes, REQ_NET);
+	  }
+	else if (nettype == CMESH_NET)
+	  {
+	    CreateCMESH (2, dim_mesh, CMESH_CONC, 1, iport_ptr, oport_ptr, REPLY_NET);
+	    CreateCMESH (2, dim_mesh, CMESH_CONC, 1, iport_ptr+nodes, oport_ptr+nodes, REQ_NET);
+	  }
+	else
+	  {
+	    routefunc = NetRouting == WESTFIRST_ROUTING ? MeshWestFirstRoute :
+	      NetRouting == ODDEVEN_ROUTING ? MeshOddEvenRoute : MeshRoute;
+	    CreateMESH (2, dim_mesh, NetBufsz, 1, iport_ptr, oport_ptr, routefunc, REPLY_NET);
+	    /* Reply network */
+	    CreateMESH (2, dim_mesh, NetBufsz, 1, iport_ptr+nodes, oport_ptr+nodes,
+			routefunc, REQ_NET); /* Request network */
+	  }
 	
 	
 	NetworkSetFlitDelay (flitd * FASTER_PROC); /* Set flit delay to flitd cycles -- in net.c */
@@ -497,7 +523,7 @@ static void dir_net_init (int nodes, int cacsz, int cacsz2,
 	sprintf(name,"dir%d_%d",i,leaf);
 	dir[(i*INTERLEAVING_FACTOR)+leaf] = NewDir(name,i, 3, /* routing5*/ routing_dir,
 						   DirDelays, 2, 0 /*1 */,linesz, 
-						   CNTRL_FULL_MAP, nodes, dbufsz,
+						   ARCH_dirtype, nodes, dbufsz,
 						   Dir_Cohe, 0,1,NULL/* DirStatReport */);
       }
       InterleavingStats[i] = NewStatrec("interleaving",POINT,NOMEANS,HIST,
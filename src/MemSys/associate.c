@@ -737,3 +737,68 @@ int num_nodes;
 
 /**************************************************************************************/
 
+
+/*****************************************************************************/
+/* Checkpoint support: the trees are written in preorder, each node followed */
+/* by a flag word giving which children follow, so that AssociateRestore can */
+/* rebuild exactly the same tree without going through InsertList again.    */
+/*****************************************************************************/
+
+static void SaveTree(fp, p)
+FILE *fp;
+LITEM *p;
+{
+  int kids;
+
+  kids = (p->left != NULL) | ((p->right != NULL) << 1);
+  fwrite((char *)p, sizeof(LITEM), 1, fp);
+  fwrite((char *)&kids, sizeof(int), 1, fp);
+  if (p->left)
+    SaveTree(fp, p->left);
+  if (p->right)
+    SaveTree(fp, p->right);
+}
+
+static LITEM *RestoreTree(fp)
+FILE *fp;
+{
+  LITEM *p;
+  int kids;
+
+  p = (LITEM *)malloc(sizeof(LITEM));
+  if (p == NULL) {
+    fprintf(simerr, "AssociateRestore(): malloc failed \n");
+    exit(-1);
+  }
+  if (fread((char *)p, sizeof(LITEM), 1, fp) != 1 ||
+      fread((char *)&kids, sizeof(int), 1, fp) != 1)
+    YS__errmsg("AssociateRestore(): truncated checkpoint");
+  p->left = (kids & 1) ? RestoreTree(fp) : NULL;
+  p->right = (kids & 2) ? RestoreTree(fp) : NULL;
+  return p;
+}
+
+void AssociateSave(fp)
+FILE *fp;
+{
+  int present[2];
+
+  present[0] = (node_root != NULL);
+  present[1] = (cohe_root != NULL);
+  fwrite((char *)present, sizeof(int), 2, fp);
+  if (node_root)
+    SaveTree(fp, node_root);
+  if (cohe_root)
+    SaveTree(fp, cohe_root);
+}
+
+void AssociateRestore(fp)
+FILE *fp;
+{
+  int present[2];
+
+  if (fread((char *)present, sizeof(int), 2, fp) != 2)
+    YS__errmsg("AssociateRestore(): truncated checkpoint");
+  node_root = present[0] ? RestoreTree(fp) : NULL;
+  cohe_root = present[1] ? RestoreTree(fp) : NULL;
+}
@@ -60,6 +60,7 @@
 #include "MemSys/net.h"
 #include "MemSys/bus.h"
 #include "MemSys/arch.h"
+#include "MemSys/statout.h"
 #include "Processor/simio.h"
 #include <malloc.h>
 
@@ -354,6 +355,8 @@ void BusStatReport (bptr) /* only stats currently given are utilization */
 BUS *bptr;
 {
   fprintf(simout,"%s: Bus Utilization (time spent delivering pkts) = %3.4f%%\n", bptr->name, (bptr->utilization/ (YS__Simtime - bptr->time_of_last_clear))*100);
+  StatOutScope("bus",bptr->name);
+  STATOUT("utilization",bptr->utilization/(YS__Simtime - bptr->time_of_last_clear),"fraction");
   
 }
 
@@ -58,6 +58,7 @@
 #include "MemSys/req.h"
 #include "MemSys/net.h"
 #include "MemSys/misc.h"
+#include "MemSys/statout.h"
 #include "Processor/capconf.h"
 #include "Processor/simio.h"
 
@@ -228,19 +229,14 @@ LINKPARA *link_para;
   captr->cohe_rtn = cohe_rtn; /* cohe_rtn to call: cohe_pr for L1 cache,
 				                   cohe_sl for L2 cache */
 
-  captr->max_mshrs = max_mshrs; /* # of MSHRs: this is used in init_cache */
+  /* Create new mshrs and intialize them. # of MSHRs is used in init_cache */
+  InitMSHRs(captr, max_mshrs);
   init_cache(captr);		/*Initialize cache data structures */
 
   /* set network ports, if any */
   captr->netsend_port = netsend_port;
   captr->netrcv_port = netrcv_port;
   
-  /* Create new mshrs and intialize them */
-  captr->mshrs = malloc(sizeof(MSHRITEM) * max_mshrs);
-  for (i=0; i<captr->max_mshrs; i++)
-    {
-      captr->mshrs[i].valid=0;
-    }
   captr->mshr_count=0; /* counts WRBs in MSHRs, etc */
   captr->reqmshr_count=0; /* only counting data requests */
   captr->reqs_at_mshr_count=0;
@@ -317,6 +313,7 @@ int CacheStatReport (CACHE *captr) /* report stats for this cache */
 {
   FILE *out;
   double hitpr, lat, util;
+  char stat[40];
 
   int i,j;
 
@@ -325,10 +322,13 @@ int CacheStatReport (CACHE *captr) /* report stats for this cache */
   
   out=simout;
 
+  StatOutScope("cache",captr->name);
   SMModuleStatReport(captr , &hitpr, &lat, &util); /* First report basic module stats */
 
   /* Hit rate and miss rate */
   fprintf(out,"Num_hit: %d  Num_miss: %d Num_lat: %d\n",(captr->num_ref-captr->num_miss), captr->num_miss, captr->num_lat);
+  STATOUT("num_miss",captr->num_miss,"count");
+  STATOUT("num_lat",captr->num_lat,"count");
 
   /* Now split up the hits and misses into each different miss type
    for each different type of demand access (READ, WRITE, RMW, each
@@ -341,6 +341,11 @@ int CacheStatReport (CACHE *captr) /* report stats for this cache */
 		  CacheMissTypes[i],captr->stat.demand_miss[j][i],
 		  (double)captr->stat.demand_miss[j][i]/(double)captr->stat.demand_ref[j],
 		  (double)captr->stat.demand_miss[j][i]/(double)captr->num_ref);
+	  if (StatOut)
+	    {
+	      sprintf(stat,"demand_%s",Req_Type[j+READ]);
+	      StatOutValue(stat,CacheMissTypes[i],captr->stat.demand_miss[j][i],"count");
+	    }
 	}
     }
   
@@ -352,6 +357,11 @@ int CacheStatReport (CACHE *captr) /* report stats for this cache */
 		  CacheMissTypes[i],captr->stat.pref_miss[j][i],
 		  (double)captr->stat.pref_miss[j][i]/(double)captr->stat.pref_ref[j],
 		  (double)captr->stat.pref_miss[j][i]/(double)captr->num_ref);
+	  if (StatOut)
+	    {
+	      sprintf(stat,"pref_%s",Req_Type[j+L1WRITE_PREFETCH]);
+	      StatOutValue(stat,CacheMissTypes[i],captr->stat.pref_miss[j][i],"count");
+	    }
 	}
     }
 
@@ -364,6 +374,11 @@ int CacheStatReport (CACHE *captr) /* report stats for this cache */
 	      StatrecSamples(captr->net_demand_miss[j]),
 	      StatrecMean(captr->net_demand_miss[j]),
 	      StatrecSdv(captr->net_demand_miss[j]));
+      if (StatOut)
+	{
+	  sprintf(stat,"network_miss_%s",Req_Type[j+READ]);
+	  StatOutStatrec(stat,captr->net_demand_miss[j]);
+	}
     }
   
   for (j=0; j<= L2READ_PREFETCH-L1WRITE_PREFETCH; j++)
@@ -373,6 +388,11 @@ int CacheStatReport (CACHE *captr) /* report stats for this cache */
 	      StatrecSamples(captr->net_pref_miss[j]),
 	      StatrecMean(captr->net_pref_miss[j]),
 	      StatrecSdv(captr->net_pref_miss[j]));
+      if (StatOut)
+	{
+	  sprintf(stat,"network_miss_%s",Req_Type[j+L1WRITE_PREFETCH]);
+	  StatOutStatrec(stat,captr->net_pref_miss[j]);
+	}
     }
 
 
@@ -402,7 +422,15 @@ int CacheStatReport (CACHE *captr) /* report stats for this cache */
 	  captr->stat.pipe_stall_MSHR_COAL,
 	  captr->stat.pipe_stall_MSHR_CONF,
 	  captr->stat.pipe_stall_MSHR_FULL);
-
+  if (StatOut)
+    {
+      StatOutValue("mshr_pipe_stalls","WAR",captr->stat.pipe_stall_MSHR_WAR,"count");
+      StatOutValue("mshr_pipe_stalls","MSHR_COHE",captr->stat.pipe_stall_MSHR_COHE,"count");
+      StatOutValue("mshr_pipe_stalls","PEND_COHE",captr->stat.pipe_stall_PEND_COHE,"count");
+      StatOutValue("mshr_pipe_stalls","MAX_COAL",captr->stat.pipe_stall_MSHR_COAL,"count");
+      StatOutValue("mshr_pipe_stalls","CONF",captr->stat.pipe_stall_MSHR_CONF,"count");
+      StatOutValue("mshr_pipe_stalls","FULL",captr->stat.pipe_stall_MSHR_FULL,"count");
+    }
 
   /* Report counts of various COHE message types and
      the manner in which CACHE handles them. */
@@ -442,6 +470,46 @@ int CacheStatReport (CACHE *captr) /* report stats for this cache */
   
   fprintf(out,"Pipe stalls for REQs matching WRB replacement: %d\tfor WRBBUF full: %d\n\n",captr->stat.pipe_stall_WRB_match,captr->stat.pipe_stall_WRBBUF_full);
 
+  if (StatOut)
+    {
+      StatOutValue("cohes","total",captr->stat.cohe,"count");
+      StatOutValue("cohes","nacked",captr->stat.cohe_nack,"count");
+      StatOutValue("cohes","stalled",captr->stat.cohe_stall_PEND_COHE,"count");
+      StatOutValue("cohe_replys","total",captr->stat.cohe_reply,"count");
+      StatOutValue("cohe_replys","merged",captr->stat.cohe_reply_merge,"count");
+      StatOutValue("cohe_replys","merged_ignored",captr->stat.cohe_reply_merge_ignore,"count");
+      StatOutValue("cohe_replys","nacked",captr->stat.cohe_reply_nack,"count");
+      StatOutValue("cohe_replys","nacked_docohe",captr->stat.cohe_reply_nack_docohe,"count");
+      StatOutValue("cohe_replys","nacked_mergefail",captr->stat.cohe_reply_nack_mergefail,"count");
+      StatOutValue("cohe_replys","nack_pended",captr->stat.cohe_reply_nack_pend,"count");
+      StatOutValue("cohe_replys","nack_pends_propagated",captr->stat.cohe_reply_prop_nack_pend,"count");
+      StatOutValue("cohe_replys","unsolicited_WRB",captr->stat.cohe_reply_unsolicited_WRB,"count");
+      StatOutValue("cache_to_cache","requests",captr->stat.cohe_cache_to_cache_good+captr->stat.cohe_cache_to_cache_fail,"count");
+      StatOutValue("cache_to_cache","failures",captr->stat.cohe_cache_to_cache_fail,"count");
+      STATOUT("replies_nacked",captr->stat.replies_nacked,"count");
+      STATOUT("rars_handled",captr->stat.rars_handled,"count");
+      StatOutValue("wrb_inclusions","sent",captr->stat.wb_inclusions_sent,"count");
+      StatOutValue("wrb_inclusions","from_L2_E",captr->stat.wb_prcl_inclusions_sent,"count");
+      StatOutValue("wrb_inclusions","real",captr->stat.wb_inclusions_real,"count");
+      StatOutValue("wrb_inclusions","race",captr->stat.wb_inclusions_race,"count");
+      StatOutValue("wrb_inclusions","repeats",captr->stat.wb_repeats,"count");
+      StatOutValue("victims",State[SH_CL],captr->stat.shcl_victims,"count");
+      StatOutValue("victims",State[PR_CL],captr->stat.prcl_victims,"count");
+      StatOutValue("victims",State[PR_DY],captr->stat.prdy_victims,"count");
+      StatOutValue("wrb_pipe_stalls","WRB_match",captr->stat.pipe_stall_WRB_match,"count");
+      StatOutValue("wrb_pipe_stalls","WRBBUF_full",captr->stat.pipe_stall_WRBBUF_full,"count");
+      StatOutValue("prefetches","total",captr->stat.pref_total,"count");
+      StatOutValue("prefetches","dropped",captr->stat.dropped_pref,"count");
+      StatOutValue("prefetches","unnecessary",captr->stat.pref_unnecessary,"count");
+      StatOutValue("prefetches","late",captr->stat.pref_late,"count");
+      StatOutValue("prefetches","useful",captr->stat.pref_useful,"count");
+      StatOutValue("prefetches","upgrade",captr->stat.pref_useful_upgrade,"count");
+      StatOutValue("prefetches","useless",captr->stat.pref_useless,"count");
+      StatOutValue("prefetches","invalidated",captr->stat.pref_useless_cohe,"count");
+      StatOutValue("prefetches","downgraded",captr->stat.pref_downgraded,"count");
+      StatOutValue("prefetches","damaging",captr->stat.pref_damaging,"count");
+    }
+
   /* Prefetching statistics: basic types (dropped, unnecessary, late, etc.) */
   fprintf(out,"Pref_Total: %d\nPref_Dropped: %d ( %.2f %%)\nPref_Unnecessary: %d ( %.2f %%)\n",
 	  captr->stat.pref_total,
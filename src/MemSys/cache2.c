@@ -63,6 +63,12 @@
 #include "Processor/simio.h"
 
 #include <malloc.h>
+#include <strings.h>
+#if defined(__AVX2__) && defined(__LP64__)
+#include <immintrin.h>
+#elif defined(__SSE2__) && defined(__LP64__)
+#include <emmintrin.h>
+#endif
 
 extern int captr_block_bits;
 
@@ -73,7 +79,7 @@ extern int captr_block_bits;
 
 void init_cache(CACHE *captr)
 {
-  int i, j, k, ii;
+  int i, j, k;
   int lsb = 0;
   int temp, nof_sets;
   int num_lines;
@@ -167,62 +173,38 @@ void init_cache(CACHE *captr)
   captr->set_bits = set_bits;
   captr->num_lines = num_lines;
 
-  /* The cache data structure is divided into a two dimentional
-    array. The data structure has one entry for each cache line. The
-    array is [100][SUB_SZ] maximum.  This gives a maximum of
-    SUB_SZ*100 lines (204800 when this comment was written).  However
-    for infinite caches all of this space is not allocated at this
-    time.  To start with only space for SUB_SZ lines are
-    malloc-ed. Then as the cache has capacity misses more space is
-    allocated during simulation. For finite caches all space is
-    allocated at this time.
+  /* The cache lines are kept in three flat arrays indexed by line
+    number: the tags, the hot per-line state, and the prefetch
+    statistics. Each set occupies setsize consecutive entries. For
+    finite caches all space is allocated at this time; infinite caches
+    start with SUB_SZ lines and are grown during simulation as they
+    take capacity misses (see miss_ageupdate).
     */
 
-  if (num_lines > (SUB_SZ*100)) {
-    fprintf(simout,"NewCache(): cache size: %d KB, line size: %d bytes, num_lines: %d, \n",
-	cachesize, blocksize, num_lines);
-    fprintf(simout," in cache \"%s\" \n",captr->name);
-    YS__errmsg("NewCache(): Simulation exceeds max limit on number of lines in cache");
-  }
-  /* To increase this limit, change SUB_SZ defined in ../../incl/MemSys/cache.h */
-  captr->data = (Cachest **) malloc (sizeof (Cachest *) * 100);
-  /* malloc space for 100 pointers (first diemnsion of the cache data structure array */
-  if (!captr->data)
+  captr->tags = (long *) malloc(sizeof (long) * num_lines);
+  captr->data = (Cachest *) malloc(sizeof (Cachest) * num_lines);
+  captr->prefs = (struct cache_pref_struct *)
+    malloc(sizeof (struct cache_pref_struct) * num_lines);
+  if (!captr->tags || !captr->data || !captr->prefs)
     YS__errmsg("NewCache(): malloc failed");
 
-  if (num_lines <= SUB_SZ) {	/* need to malloc only one set of SUB_SZ cache line structures */
-    captr->data[0] = (Cachest *) malloc(sizeof (Cachest) * num_lines);
-    if (!captr->data[0])
-      YS__errmsg("NewCache(): malloc failed");
-  }
-  else {			/* need to malloc several sets of cache line structures */
-    temp = num_lines;
-    for (i=0; temp > SUB_SZ; i++) {
-      captr->data[i] = (Cachest *) malloc(sizeof (Cachest) * SUB_SZ);
-      if (!captr->data[i])
-        YS__errmsg("NewCache(): malloc failed");
-      temp = temp - SUB_SZ;
-    }
-    captr->data[i] = (Cachest *) malloc(sizeof (Cachest) * temp);
-    if (!captr->data[i])
-      YS__errmsg("NewCache(): malloc failed");
-  }
   /* initialize the array of cache lines */
   for ( j = 0; j < num_lines; j += setsize)
     for ( k = 0; k < setsize; k++)
       {
-	i = (j+k)/SUB_SZ;
-       ii = (j+k)%SUB_SZ;
-       captr->data[i][ii].tag = -1; 
-       captr->data[i][ii].age = k + 1; 
-       captr->data[i][ii].pref = 0;
-       captr->data[i][ii].pref_tag_repl = -1;
-       captr->data[i][ii].state.st = INVALID; /* indicates invalid line */
-       captr->data[i][ii].state.cohe_type = 0;
-       captr->data[i][ii].state.allo_type = 0;
-       captr->data[i][ii].state.mshr_out = 0;
-       captr->data[i][ii].state.cohe_pend = 0;
-     }
+	i = j+k;
+	captr->tags[i] = -1; 
+	captr->data[i].age = k + 1; 
+	captr->data[i].dest_node = 0;
+	captr->data[i].state.st = INVALID; /* indicates invalid line */
+	captr->data[i].state.cohe_type = 0;
+	captr->data[i].state.allo_type = 0;
+	captr->data[i].state.mshr_out = 0;
+	captr->data[i].state.cohe_pend = 0;
+	captr->prefs[i].pref = 0;
+	captr->prefs[i].pref_tag_repl = -1;
+	captr->prefs[i].pref_time = 0.0;
+      }
 
   /* Also start out a new CapConfDetector to determine miss types */
   captr->ccd = NewCapConfDetector(num_lines);
@@ -236,16 +218,64 @@ void init_cache(CACHE *captr)
   captr->utilization = 0.0;
   memset(&captr->stat,0,sizeof(CacheStatStruct)); /* zero the statistics block out */
   
-  for (i=0; i < 3; i++)
+  for (i=0; i < 3; i++) {
     captr->net_demand_miss[i]=NewStatrec("demand",POINT,MEANS,NOHIST,0,0.0,1.0);
-  for (i=0; i < 4; i++)
+    StatrecSetUnit(captr->net_demand_miss[i],"cycles");
+  }
+  for (i=0; i < 4; i++) {
     captr->net_pref_miss[i]=NewStatrec("pref",POINT,MEANS,NOHIST,0,0.0,1.0);
+    StatrecSetUnit(captr->net_pref_miss[i],"cycles");
+  }
   
   captr->mshr_occ=NewStatrec("Mshr occupancy",INTERVAL,MEANS,HIST,captr->max_mshrs,0.0,(double)captr->max_mshrs);
   
   captr->mshr_req_count=NewStatrec("Mshr req occupancy",INTERVAL,MEANS,HIST,10,0.0,(double)(captr->max_mshrs * MAX_COALS));
   captr->pref_lateness=NewStatrec("Prefetch Lateness",POINT,MEANS,HIST,20,0.0,200.0);
   captr->pref_earlyness=NewStatrec("Prefetch Earlyness",POINT,MEANS,HIST,20,0.0,200.0);
+  StatrecSetUnit(captr->mshr_occ,"MSHRs");
+  StatrecSetUnit(captr->mshr_req_count,"requests");
+  StatrecSetUnit(captr->pref_lateness,"cycles");
+  StatrecSetUnit(captr->pref_earlyness,"cycles");
+}
+
+/*****************************************************************************/
+/* find_tag: returns the way of the first of the n tags starting at tags     */
+/* that equals tag, or -1 if there is none. Since the tags of a set are      */
+/* contiguous, this compares several ways at a time where SSE2 or AVX2 is    */
+/* available.                                                                */
+/*****************************************************************************/
+
+static int find_tag(long *tags, int n, long tag)
+{
+  int i = 0, m;
+
+#if defined(__AVX2__) && defined(__LP64__)
+  __m256i key = _mm256_set1_epi64x(tag);
+  for (; i + 4 <= n; i += 4)
+    {
+      m = _mm256_movemask_pd(_mm256_castsi256_pd(
+		_mm256_cmpeq_epi64(_mm256_loadu_si256((__m256i *)(tags+i)),key)));
+      if (m)
+	return i + ffs(m) - 1;
+    }
+#elif defined(__SSE2__) && defined(__LP64__)
+  /* SSE2 has no 64-bit compare: compare the 32-bit halves and require
+     both halves of a way to match */
+  __m128i key = _mm_set1_epi64x(tag), eq;
+  for (; i + 2 <= n; i += 2)
+    {
+      eq = _mm_cmpeq_epi32(_mm_loadu_si128((__m128i *)(tags+i)),key);
+      eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2,3,0,1)));
+      m = _mm_movemask_pd(_mm_castsi128_pd(eq));
+      if (m)
+	return i + ffs(m) - 1;
+    }
+#endif
+
+  for (; i < n; i++)		/* remaining ways, or no SIMD at all */
+    if (tags[i] == tag)
+      return i;
+  return -1;
 }
 
 /*****************************************************************************/
@@ -264,56 +294,22 @@ void init_cache(CACHE *captr)
 int notpres (long address, long *tag, int *set, int *set_ind, CACHE *captr)
 
 {
- unsigned i, i1, i2;
- unsigned temp;
+ int way;
  
  /* process address to get the tag and set number */
  *tag = (address) >> (captr->non_tag_bits);
  *set = ((address) >> (captr->block_bits)) & ~(~0 << (captr->set_bits));
  *set_ind = *set * captr->setsz;
 
- if (captr->num_lines <= SUB_SZ) { /* small cache; fits in 1 dimension */
-   temp = *set_ind;
-   for ( i = 0; i < captr->setsz; i++) /* loop through the set looking for a match */
-     {
-       if ( captr->data[0][temp].tag == *tag) /* a match! */
-         if (captr->data[0][temp].state.st != INVALID)
-           {
-             *set_ind = temp;
-             return(0);		/* found a hit */
-           }
-         else
-           {
-             *set_ind = temp;
-             return(1);		/* found a present miss; state is INVALID */
-           }
-       temp++;
-     }
+ way = find_tag(captr->tags + *set_ind, captr->setsz, *tag);
+ if (way < 0)
    return(2);			/* did not find a tag match; miss */
- }
-
- else {				/* larger cache */
-   temp = *set_ind;
-   for ( i = 0; i < captr->setsz; i++) /* loop through set looking for a match */
-     {
-       i1 = temp /SUB_SZ;
-       i2 = temp % SUB_SZ;
-       if ( captr->data[i1][i2].tag == *tag) /* a match */
-         if (captr->data[i1][i2].state.st != INVALID)
-           {
-             *set_ind = temp;
-             return(0);		/* found a hit */
-           }
-         else
-           {
-             *set_ind = temp;
-             return(1);		/* found a present miss; state is INVALID */
-           }
-       temp++;
-     }
-   return(2);			/* did not find a tag match; miss */
- }
 
+ *set_ind += way;
+ if (captr->data[*set_ind].state.st != INVALID)
+   return(0);			/* found a hit */
+ else
+   return(1);			/* found a present miss; state is INVALID */
 }
 
 /*****************************************************************************/
@@ -325,63 +321,30 @@ int notpres (long address, long *tag, int *set, int *set_ind, CACHE *captr)
 void hit_update (unsigned index, CACHE *captr, int set, REQ *req)
 {
  unsigned temp, i, tage;
- int i1, i2;
 
  if (captr->types.replacement == LRU && captr->size != INFINITE)
   {				/* update ages if LRU replacement and not infinite cache */
 				/* Infinite caches will not have to worry about replacement */
-    if (captr->num_lines <= SUB_SZ) { /* if small cache */
-      temp = set *captr->setsz;
-      tage = captr->data[0][index].age;	/* age of line hit */
-      for ( i = 0; i < captr->setsz; i ++)
-        if ( captr->data[0][temp].age < tage) /* ages less than that hit are increased by one  */
-          (captr->data[0][temp++].age)++;
-        else
-          if( temp == index)
-	    {
-	      if (captr->data[0][temp].pref && !req->s.prefetch)
-		{
-		  captr->data[0][temp].pref = 0; /* it's now been demand fetched! */
-		  captr->stat.pref_useful++;
-		  captr->data[0][temp].pref_tag_repl = -1; /* now the blame for replacing a line goes to the demand access, not the prefetch */
-		  /* now also account for the earliness factor */
-		  StatrecUpdate(captr->pref_earlyness,(double)(YS__Simtime-captr->data[0][temp].pref_time),1.0);
-		}
-              captr->data[0][temp++].age = 1; /* age of line hit is made 1 */
-	    }
-          else
-            temp++;
-    }
-    else {			/* if num lines is geater than SUB_SZ */
-      temp = set;
-      i1 = (index)/SUB_SZ;
-      i2 = (index)%SUB_SZ;
-      tage = captr->data[i1][i2].age; /* age of line hit */
-      for ( i = 0; i < captr->setsz; i ++) {
-        i1 = (temp)/SUB_SZ;
-        i2 = (temp)%SUB_SZ;
-        if ( captr->data[i1][i2].age < tage) {
-          (captr->data[i1][i2].age)++; /* ages less than that hit are increased by one  */
-          temp ++;
-        }
+    temp = set *captr->setsz;
+    tage = captr->data[index].age;	/* age of line hit */
+    for ( i = 0; i < captr->setsz; i ++)
+      if ( captr->data[temp].age < tage) /* ages less than that hit are increased by one  */
+        (captr->data[temp++].age)++;
+      else
+        if( temp == index)
+	  {
+	    if (captr->prefs[temp].pref && !req->s.prefetch)
+	      {
+		captr->prefs[temp].pref = 0; /* it's now been demand fetched! */
+		captr->stat.pref_useful++;
+		captr->prefs[temp].pref_tag_repl = -1; /* now the blame for replacing a line goes to the demand access, not the prefetch */
+		/* now also account for the earliness factor */
+		StatrecUpdate(captr->pref_earlyness,(double)(YS__Simtime-captr->prefs[temp].pref_time),1.0);
+	      }
+            captr->data[temp++].age = 1; /* age of line hit is made 1 */
+	  }
         else
-          if( temp == index)
-            {
-	      if (captr->data[i1][i2].pref && !req->s.prefetch)
-		{
-		  captr->data[i1][i2].pref = 0; /* it's now been demand fetched! */
-		  captr->stat.pref_useful++;
-		  captr->data[i1][i2].pref_tag_repl = -1; /* now the blame for replacing a line goes to the demand access, not the prefetch */
-		  /* now also account for the earliness factor */
-		  StatrecUpdate(captr->pref_earlyness,(double)(YS__Simtime-captr->data[0][temp].pref_time),1.0);
-		}
-              captr->data[i1][i2].age = 1; /* age of hit line is made 1 */
-              temp ++;
-            }
-          else
-            temp++;
-      }
-    }
+          temp++;
   }
 }
 
@@ -393,70 +356,35 @@ void premiss_ageupdate (CACHE *captr, int set_ind, REQ *req, int nofetchcoal)
 {
   int  temp, i;
   int inv_age;
-  int i1, i2;
 
   if (captr->types.replacement == LRU && captr->size != INFINITE)
   {				/* update ages if LRU replacement and not infinite cache */
 				/* Infinite caches will not have to worry about replacement */
-    if (captr->num_lines <= SUB_SZ) { /* if small cache */
-      inv_age = captr->data[0][set_ind].age; /* age of line that had a present miss */
+    inv_age = captr->data[set_ind].age; /* age of line that had a present miss */
 
-      temp = (int)(set_ind/captr->setsz)*(captr->setsz);
-      for ( i = 0; i < captr->setsz; i++)
-        if (captr->data[0][temp].age < inv_age)/* ages less than that of pre-miss line are increased by one  */
-          (captr->data[0][temp++].age)++;
-        else
-          if ( temp == set_ind ) /* captr->data[0][temp].age == inv_age) */
-            {
-	      if (req->s.prefetch && nofetchcoal) /* only prefetches present --
-						     no demand fetches yet */
-		{		  
-		  captr->data[0][temp].pref=1;
-		  captr->data[0][temp].pref_time=YS__Simtime; /* used to account for earliness */
-		}
-	      else
-		captr->data[0][temp].pref=0; /* not a "prefetch" line --
-						either only demand access or
-						a late prefetch */
+    temp = (int)(set_ind/captr->setsz)*(captr->setsz);
+    for ( i = 0; i < captr->setsz; i++)
+      if (captr->data[temp].age < inv_age)/* ages less than that of pre-miss line are increased by one  */
+        (captr->data[temp++].age)++;
+      else
+        if ( temp == set_ind ) /* captr->data[temp].age == inv_age) */
+          {
+	    if (req->s.prefetch && nofetchcoal) /* only prefetches present --
+						   no demand fetches yet */
+	      {		  
+		captr->prefs[temp].pref=1;
+		captr->prefs[temp].pref_time=YS__Simtime; /* used to account for earliness */
+	      }
+	    else
+	      captr->prefs[temp].pref=0; /* not a "prefetch" line --
+					    either only demand access or
+					    a late prefetch */
 		
-	      captr->data[0][temp].pref_tag_repl = -1; /* this happens regardless, since nothing was replaced */
-              captr->data[0][temp++].age = 1; /* age of present miss line is made 1 */
-            }
-          else
-            temp++;
-    }
-
-    else {
-      i1 = set_ind / SUB_SZ;
-      i2 = set_ind % SUB_SZ;
-      inv_age = captr->data[i1][i2].age; /* age of line that had a present miss */
-
-      temp = (int)(set_ind/captr->setsz)*(captr->setsz);
-      for ( i = 0; i < captr->setsz; i++) {
-        i1 = temp / SUB_SZ;
-        i2 = temp % SUB_SZ;
-        if (captr->data[i1][i2].age < inv_age) {
-	  /* ages less than that of pre-miss line are increased by one  */
-          (captr->data[i1][i2].age)++;
-          temp ++;
-        }
+	    captr->prefs[temp].pref_tag_repl = -1; /* this happens regardless, since nothing was replaced */
+            captr->data[temp++].age = 1; /* age of present miss line is made 1 */
+          }
         else
-          if (temp == set_ind) { 
-	      if (req->s.prefetch &&nofetchcoal) /* only a prefetch line */
-		{
-		  captr->data[i1][i2].pref=1;
-		  captr->data[i1][i2].pref_time=YS__Simtime;
-		}
-	      else
-		captr->data[i1][i2].pref=0;
-	      captr->data[i1][i2].pref_tag_repl = -1; /* this happens regardless, since nothing was replaced */
-              captr->data[i1][i2].age = 1; /* age of present miss line is made 1 */
-              temp ++;
-            }
-          else
-            temp++;
-      }
-    }
+          temp++;
   }
 }
 
@@ -474,7 +402,7 @@ void premiss_ageupdate (CACHE *captr, int set_ind, REQ *req, int nofetchcoal)
 int miss_ageupdate (REQ *req, CACHE *captr, int *set_ind, long tag, int nofetchcoal)
 {
   int  temp, i, temp1;
-  int i1, i2, repl_age;
+  int repl_age;
   int victim;
 
   int bestinv=-1, bestclean=-1, bestprivate=-1, bestdirty=-1;
@@ -487,10 +415,8 @@ int miss_ageupdate (REQ *req, CACHE *captr, int *set_ind, long tag, int nofetchc
   int reqtag = (req->address >> captr->non_tag_bits);
   
   if (captr->setsz == 1) {	/* Direct mapped caches */
-    temp = *set_ind;
-    i1 = (temp)/SUB_SZ;
-    i2 = (temp)%SUB_SZ;
-    if (captr->data[i1][i2].state.mshr_out && captr->cache_level_type != FIRSTLEVEL_WT)
+    temp1 = *set_ind;
+    if (captr->data[temp1].state.mshr_out && captr->cache_level_type != FIRSTLEVEL_WT)
       /* lines with upgrades outstanding should not be replaced -- in a
 	 write through cache, though, we sometimes book MSHRs for excl pref,
 	 RMWs, etc, but those can be victimzed ... */
@@ -501,32 +427,32 @@ int miss_ageupdate (REQ *req, CACHE *captr, int *set_ind, long tag, int nofetchc
     /* if the line being brought in is a line that was recently replaced
        by a prefetch to a different line in the same set, that prefetch
        is considered a damaging prefetch */
-   if (captr->data[i1][i2].state.st != INVALID && reqtag == captr->data[i1][i2].pref_tag_repl) 
+   if (captr->data[temp1].state.st != INVALID && reqtag == captr->prefs[temp1].pref_tag_repl) 
       {
 	captr->stat.pref_damaging++;
-	captr->data[i1][i2].pref_tag_repl = -1;
+	captr->prefs[temp1].pref_tag_repl = -1;
       }
 
    /* If a prefetch is victimized before it can be used, it is counted as useless */
-    if (captr->data[i1][i2].pref)
+    if (captr->prefs[temp1].pref)
       captr->stat.pref_useless++;
 
     /* if the incoming line is a prefetch without any demand fetches
        yet, set up prefetch accounting for it */
     if (req->s.prefetch &&nofetchcoal)
       {
-	if (captr->data[i1][i2].state.st != INVALID)
-	  captr->data[i1][i2].pref_tag_repl = captr->data[i1][i2].tag;
+	if (captr->data[temp1].state.st != INVALID)
+	  captr->prefs[temp1].pref_tag_repl = captr->tags[temp1];
 	else
-	  captr->data[i1][i2].pref_tag_repl = -1;
+	  captr->prefs[temp1].pref_tag_repl = -1;
 	
-	captr->data[i1][i2].pref = 1;
-	captr->data[i1][i2].pref_time = YS__Simtime;
+	captr->prefs[temp1].pref = 1;
+	captr->prefs[temp1].pref_time = YS__Simtime;
       }
     else /* otherwise, it's a regular access or a late pf. No PF accounting needed */
       {
-	captr->data[i1][i2].pref_tag_repl = -1;
-	captr->data[i1][i2].pref = 0;
+	captr->prefs[temp1].pref_tag_repl = -1;
+	captr->prefs[temp1].pref = 0;
       }
     return 1;
   }
@@ -543,53 +469,52 @@ int miss_ageupdate (REQ *req, CACHE *captr, int *set_ind, long tag, int nofetchc
 	   specified above. (prefer INVALID, then SH_CL, then PR_CL,
 	   then PR_DY) */
 	
-	i1 = (temp+i)/SUB_SZ;
-	i2 = (temp+i)%SUB_SZ;
-	if (!captr->data[i1][i2].state.mshr_out || captr->cache_level_type == FIRSTLEVEL_WT) /* don't look at upgrade lines */
+	temp1 = temp+i;
+	if (!captr->data[temp1].state.mshr_out || captr->cache_level_type == FIRSTLEVEL_WT) /* don't look at upgrade lines */
 	  {
-	    switch (captr->data[i1][i2].state.st)
+	    switch (captr->data[temp1].state.st)
 	      {
 	      case INVALID:
-		if (inv_age < captr->data[i1][i2].age)
+		if (inv_age < captr->data[temp1].age)
 		  {
-		    inv_age = captr->data[i1][i2].age;
+		    inv_age = captr->data[temp1].age;
 		    bestinv=i;
 		  }
 		break;
 	      case SH_CL:
-		if (clean_age < captr->data[i1][i2].age)
+		if (clean_age < captr->data[temp1].age)
 		  {
-		    clean_age = captr->data[i1][i2].age;
+		    clean_age = captr->data[temp1].age;
 		    bestclean=i;
 		  }
-		if (captr->data[i1][i2].pref_tag_repl == reqtag)
+		if (captr->prefs[temp1].pref_tag_repl == reqtag)
 		  {
-		    captr->data[i1][i2].pref_tag_repl = -1;
+		    captr->prefs[temp1].pref_tag_repl = -1;
 		    captr->stat.pref_damaging++;
 		  }
 		break;
 	      case PR_CL: /* this is worse than SH_CL since this might be dirty in upper caches */
-		if (private_age < captr->data[i1][i2].age)
+		if (private_age < captr->data[temp1].age)
 		  {
-		    private_age = captr->data[i1][i2].age;
+		    private_age = captr->data[temp1].age;
 		    bestprivate=i;
 		  }
-		if (captr->data[i1][i2].pref_tag_repl == reqtag)
+		if (captr->prefs[temp1].pref_tag_repl == reqtag)
 		  {
-		    captr->data[i1][i2].pref_tag_repl = -1;
+		    captr->prefs[temp1].pref_tag_repl = -1;
 		    captr->stat.pref_damaging++;
 		  }
 		break;
 	      case PR_DY:
 	      case SH_DY:
-		if (dirty_age < captr->data[i1][i2].age)
+		if (dirty_age < captr->data[temp1].age)
 		  {
-		    dirty_age = captr->data[i1][i2].age;
+		    dirty_age = captr->data[temp1].age;
 		    bestdirty=i;
 		  }
-		if (captr->data[i1][i2].pref_tag_repl == reqtag)
+		if (captr->prefs[temp1].pref_tag_repl == reqtag)
 		  {
-		    captr->data[i1][i2].pref_tag_repl = -1;
+		    captr->prefs[temp1].pref_tag_repl = -1;
 		    captr->stat.pref_damaging++;
 		  }
 		break;
@@ -631,36 +556,35 @@ int miss_ageupdate (REQ *req, CACHE *captr, int *set_ind, long tag, int nofetchc
     /* having found the victim, update ages */
     for ( i = 0; i < captr->setsz; i++)
       {
-	i1 = (temp+i)/SUB_SZ;
-	i2 = (temp+i)%SUB_SZ;
-	if (captr->data[i1][i2].age < repl_age)
+	temp1 = temp+i;
+	if (captr->data[temp1].age < repl_age)
 	  {
-	    (captr->data[i1][i2].age)++;
+	    (captr->data[temp1].age)++;
 	  }
 	else if (i == victim)
 	  {
-	    if (captr->data[i1][i2].pref) /* if the victim was a prefetch, */
+	    if (captr->prefs[temp1].pref) /* if the victim was a prefetch, */
 	      captr->stat.pref_useless++; /* that prefetch is now useless */
 	    if (req->s.prefetch && nofetchcoal) 
 	      {
 		/* if this access is a prefetch, remember which line (if
 		   any) it invalidated so that it can be later determined
 		   if this line was a damaging prefetch. */
-		if (captr->data[i1][i2].state.st != INVALID)
-		  captr->data[i1][i2].pref_tag_repl = captr->data[i1][i2].tag;
+		if (captr->data[temp1].state.st != INVALID)
+		  captr->prefs[temp1].pref_tag_repl = captr->tags[temp1];
 		else
-		  captr->data[i1][i2].pref_tag_repl = -1;
+		  captr->prefs[temp1].pref_tag_repl = -1;
 		
-		captr->data[i1][i2].pref = 1;
-		captr->data[i1][i2].pref_time = YS__Simtime;
+		captr->prefs[temp1].pref = 1;
+		captr->prefs[temp1].pref_time = YS__Simtime;
 	      }
 	    else
 	      {
-		captr->data[i1][i2].pref_tag_repl = -1;
-		captr->data[i1][i2].pref = 0;
+		captr->prefs[temp1].pref_tag_repl = -1;
+		captr->prefs[temp1].pref = 0;
 	      }
 
-	    captr->data[i1][i2].age = 1;
+	    captr->data[temp1].age = 1;
 	  }
       }
 
@@ -672,9 +596,7 @@ int miss_ageupdate (REQ *req, CACHE *captr, int *set_ind, long tag, int nofetchc
     temp1 = -1;
     for (i = 0; i < captr->setsz; i++)
       {
-        i1 = (temp+i)/SUB_SZ;
-        i2 = (temp+i)%SUB_SZ;
-        if (captr->data[i1][i2].state.st == INVALID) { 
+        if (captr->data[temp+i].state.st == INVALID) { 
           temp1 = temp + i;	/* Set to invalid line if any */
           *set_ind = temp1;
           break;
@@ -682,21 +604,25 @@ int miss_ageupdate (REQ *req, CACHE *captr, int *set_ind, long tag, int nofetchc
       }
     if (temp1 == -1) {		/* No invalid line in cache */
 				/* Increase cache size */
+      temp = captr->num_lines;
       captr->num_lines += SUB_SZ; 
-      if (captr->num_lines > (SUB_SZ*100)) 
-	YS__errmsg("miss_ageupdate(): Infinite Cache size exceeded maximum size allocated");
-
-      i1 = (captr->num_lines / SUB_SZ) - 1;
-      captr->data[i1] = (Cachest *)malloc(sizeof(Cachest)*SUB_SZ);
-      if (!captr->data[i1])
+      captr->tags = (long *)realloc(captr->tags, sizeof(long)*captr->num_lines);
+      captr->data = (Cachest *)realloc(captr->data, sizeof(Cachest)*captr->num_lines);
+      captr->prefs = (struct cache_pref_struct *)
+	realloc(captr->prefs, sizeof(struct cache_pref_struct)*captr->num_lines);
+      if (!captr->tags || !captr->data || !captr->prefs)
         YS__errmsg("miss_ageupdate(): Malloc failed when extending cache data structure for infinite cache");
 
-      for (i=0; i<SUB_SZ; i++) {
-        captr->data[i1][i].tag = -1; /* marked invalid */
-        captr->data[i1][i].state.st = INVALID;
+      for (i=temp; i<captr->num_lines; i++) {
+        captr->tags[i] = -1; /* marked invalid */
+        memset(&captr->data[i], 0, sizeof(Cachest));
+        captr->data[i].state.st = INVALID;
+        captr->prefs[i].pref = 0;
+        captr->prefs[i].pref_tag_repl = -1;
+        captr->prefs[i].pref_time = 0.0;
       }
       captr->setsz = captr->num_lines;
-      *set_ind  = captr->num_lines - SUB_SZ;
+      *set_ind  = temp;
     }
     return 1;
   }                             /* end: infinite cache */
@@ -707,7 +633,7 @@ int miss_ageupdate (REQ *req, CACHE *captr, int *set_ind, long tag, int nofetchc
 /*****************************************************************************/
 void cache_get_cohe_type (CACHE *captr, int hittype, int set_ind, long address, int *cohe_type, int *allo_type, int *node)
 {
-  int x, i1, i2;
+  int x;
 
   if (captr->types.adap_type == 1 ) {
     if (hittype == 2) {	/* if miss */
@@ -722,10 +648,8 @@ void cache_get_cohe_type (CACHE *captr, int hittype, int set_ind, long address,
       }
     }
     else  {			/* if hit */
-      i1 = set_ind/SUB_SZ;
-      i2 = set_ind % SUB_SZ;
-      *cohe_type = captr->data[i1][i2].state.cohe_type;
-      *allo_type = captr->data[i1][i2].state.allo_type;
+      *cohe_type = captr->data[set_ind].state.cohe_type;
+      *allo_type = captr->data[set_ind].state.allo_type;
     }	
   }
   else {			/* if not adaptive */
@@ -760,10 +684,8 @@ void cache_get_cohe_type (CACHE *captr, int hittype, int set_ind, long address,
 	}
       }
   }
-  else {
-    i1 = set_ind/SUB_SZ; i2 = set_ind % SUB_SZ;
-    *node = captr->data[i1][i2].dest_node;
-  }
+  else
+    *node = captr->data[set_ind].dest_node;
 
 }
 
@@ -64,6 +64,7 @@
 #include "MemSys/arch.h"
 #include "MemSys/net.h"
 #include "MemSys/cache.h"
+#include "MemSys/statout.h"
 #include "Processor/memprocess.h"
 #include "Processor/simio.h"
 #include <malloc.h>
@@ -351,6 +352,7 @@ void PrcrStatReport(PROCESSOR *prptr)
     
     prptr->utilization += GetSimTime() - prptr->start_time;
     prptr->start_time = GetSimTime();
+    StatOutScope("cpu",prptr->name);
     SMModuleStatReport(prptr , &hitpr, &lat, &util);
     
     gnum_ref += prptr->num_ref;
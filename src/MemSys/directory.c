@@ -66,13 +66,20 @@
 #include "Processor/memprocess.h"
 #include "MemSys/cache.h"
 #include "MemSys/bus.h"
+#include "MemSys/statout.h"
 #include "Processor/simio.h"
 
 #include <malloc.h>
 #include <string.h>
 
 int dir_index=0;
-DIR *dir_ptr[128];
+DIR *dir_ptr[MAX_MEMSYS_PROCS];
+int DIR_POINTERS = 4;   /* sharer pointers in CNTRL_LIMITED_PTR/COARSE_VEC lines */
+int DIR_COARSENESS = 4; /* nodes per bit of an overflowed CNTRL_COARSE_VEC line */
+static unsigned *DirPtrTmp; /* pointers of a line being converted to a coarse vector */
+int DIR_SETS = 0;       /* sets in a sparse directory; 0 keeps every line */
+int DIR_ASSOC = 8;      /* lines per sparse-directory set */
+int DIR_REPL = LRU;     /* sparse-directory replacement policy */
 extern PROCESSOR **cpu;
 extern int YS__NumNodes; /* from mainsim.cc */
 
@@ -85,6 +92,14 @@ messages */
 static int DirAdd_FM(DIR *, Dirst *, int, REQ *);
 static void DirRmAllAdd_FM(DIR *, Dirst *, int, REQ *);
 static void DirRmAll_FM(DIR *, Dirst *, int);
+static void DirOverflow(DIR *, Dirst *);
+static int DirVecWords(int, int);
+static void DirHashGrow(DIR *);
+static void DirHashRemove(DIR *, Dirst *);
+static void DirSetTouch(DIR *, Dirst *);
+static void DirSetInsert(DIR *, Dirst *, REQ *);
+static void DirEvict(DIR *, Dirst *, REQ *);
+static void DirEvictDone(DIR *, Dirst *);
 struct DirQueue;
 static REQ *DirQueueRm(struct DirQueue *);
 static REQ *DirQueuePeek(struct DirQueue *);
@@ -1040,6 +1055,15 @@ void DirSim()
 		      req->tag, Req_Type[req->req_type], req->src_node);
 	      YS__errmsg("Not Expecting a coherence reply for this line");
 	    }
+	  if (req->s.reply == NACK && dir_item->extra->nack_st == NACK_NOK &&
+	      dir_item->extra->ret_st == EVICT_REPLY)
+	    {
+	      /* The owner of a line being evicted from a sparse
+		 directory has replaced it on its own. Handle this like
+		 a NACK_PEND: once its WRB/REPL has arrived the NACK
+		 counts as a reply, until then the COHE is resent. */
+	      req->s.reply = NACK_PEND;
+	    }
 	  if (req->s.reply == NACK) /* negative ack (miss in remote cache) */
 	    {
 	      if (dir_item->extra->nack_st == NACK_NOK) /* If NACK is not OK */
@@ -1230,7 +1254,13 @@ void DirSim()
 		    }
 #endif
 		  dir_item->extra->WasHere = -1;
-		  if (req->forward_to != -1)
+		  if (dir_item->extra->ret_st == EVICT_REPLY)
+		    {
+		      /* the owner replaced the line being evicted (and
+			 may already be asking for it again); its WRB/REPL
+			 settled the line, so count this as a reply */
+		    }
+		  else if (req->forward_to != -1)
 		    {
 		      /* in this case, reprocess the request, just
 		       as in NACK_NOK above. */
@@ -1333,6 +1363,13 @@ void DirSim()
 	    {
 	      /* Note: don't do buf_totsz-- until REPLY is about to be sent out */
 	      dirptr->wait_cntsz --;	/*** decrement wait cnt size */
+	      if (dir_item->extra->ret_st == EVICT_REPLY)
+		{
+		  /* every sharer of the evicted line has let it go */
+		  DirEvictDone(dirptr, dir_item);
+		  case_num = DIRSTARTOVER;
+		  break;
+		}
 	      if (dir_item->extra->ret_st != ACK_REPLY) /* DIR_REPLY, VISIT_MEM, or SPECIAL_REPLY */
 		req = dir_item->extra->pend_req; /* revive the pending req */
       
@@ -1601,10 +1638,7 @@ int Dir_Cohe(DIR *dirptr, REQ *req, Dirst **dir_item, Dirst *copy, DirEP *extra)
   unsigned oursalone;
 
     
-  if (dirptr->dir_type != CNTRL_FULL_MAP )
-    YS__errmsg("Dir_Cohe(): This routine supports only CNTL_FULL_MAP directory");
-    
-  *dir_item = DirHashLookup_FM(dirptr, tag);
+  *dir_item = DirHashLookup_FM(dirptr, tag, req);
 #ifdef DEBUG_DIRECTORY
   if (DEBUG_TIME < YS__Simtime) 
     if (req->req_type == WRB || req->req_type == REPL)
@@ -1716,7 +1750,7 @@ int Dir_Cohe(DIR *dirptr, REQ *req, Dirst **dir_item, Dirst *copy, DirEP *extra)
 #ifdef DEBUG_DIRECTORY
 	  if (YS__Simtime > DEBUG_TIME)
 	    fprintf(simout,">>>>>>>>>>%s: READ_SH from %d tag %ld state UNCACHED new:%x %x \n",dirptr->name,
-		   req->src_node,req->tag,(*dir_item)->vector[1],(*dir_item)->vector[0]);
+		   req->src_node,req->tag,(*dir_item)->bits[1],(*dir_item)->bits[0]);
 #endif
 	  extra->counter = 0; /* no COHEs needed */
 	  /* return as PRIVATE if MESI; SHARED if MSI */
@@ -1738,7 +1772,7 @@ int Dir_Cohe(DIR *dirptr, REQ *req, Dirst **dir_item, Dirst *copy, DirEP *extra)
 #ifdef DEBUG_DIRECTORY
 	  if (YS__Simtime > DEBUG_TIME)
 	    fprintf(simout,">>>>>>>>>>%s: READ_SH from %d tag %ld state DIR_SHARED new:%x %x\n",dirptr->name,
-		   req->src_node,req->tag,(*dir_item)->vector[1],(*dir_item)->vector[0]);
+		   req->src_node,req->tag,(*dir_item)->bits[1],(*dir_item)->bits[0]);
 #endif
 	  extra->counter = 0; /* no COHEs needed */
 	  
@@ -1777,7 +1811,7 @@ int Dir_Cohe(DIR *dirptr, REQ *req, Dirst **dir_item, Dirst *copy, DirEP *extra)
 #ifdef DEBUG_DIRECTORY
 	  if (YS__Simtime > DEBUG_TIME)
 	    fprintf(simout,">>>>>>>>>>%s: READ_SH from %d tag %ld state DIR_PRIVATE was:%x %x\n",dirptr->name,
-		   req->src_node,req->tag,(*dir_item)->vector[1],(*dir_item)->vector[0]);
+		   req->src_node,req->tag,(*dir_item)->bits[1],(*dir_item)->bits[0]);
 #endif
 	  find = DirFind_FM(dirptr, *dir_item, extra->node_ary, node_index, &node_copy);
 	  if (find != 1)
@@ -1850,10 +1884,10 @@ int Dir_Cohe(DIR *dirptr, REQ *req, Dirst **dir_item, Dirst *copy, DirEP *extra)
 #ifdef DEBUG_DIRECTORY
 	  if (YS__Simtime > DEBUG_TIME)
 	    fprintf(simout,">>>>>>>>>>%s: UPGRADE from %d tag %ld state DIR_SHARED was:%x %x",dirptr->name,
-		   req->src_node,req->tag,(*dir_item)->vector[1],(*dir_item)->vector[0]);
+		   req->src_node,req->tag,(*dir_item)->bits[1],(*dir_item)->bits[0]);
 #endif
 	  find = DirFind_FM(dirptr, *dir_item, extra->node_ary, node_index, &node_copy); /* get list of sharers */
-	  if (find == 0) /* no sharers? Not allowed. */
+	  if (find == 0 && !(*dir_item)->overflow) /* no sharers? Not allowed */
 	    {
 	      fprintf(simerr,"Dir_Cohe(): State is DIR_SHARED; find must be > 1; dir node: %d\n",
 		      dirptr->node_num);
@@ -1864,7 +1898,9 @@ int Dir_Cohe(DIR *dirptr, REQ *req, Dirst **dir_item, Dirst *copy, DirEP *extra)
 	  if (!node_copy) /* Node does not have a copy of this line */
 	    {
 	      /* This case can come from a race. The UPGRADE must be
-		 transparently converted into a READ_OWN */
+		 transparently converted into a READ_OWN. An overflowed
+		 line cannot tell whether the node has a copy, so its
+		 UPGRADEs are always converted as well */
 #ifdef DEBUG_DIRECTORY
 	      if (YS__Simtime > DEBUG_TIME)
 		{
@@ -1884,7 +1920,7 @@ int Dir_Cohe(DIR *dirptr, REQ *req, Dirst **dir_item, Dirst *copy, DirEP *extra)
 	      DirRmAllAdd_FM(dirptr, *dir_item, node_index,req); /* Build the node_ary and other fields related to INVLs */ 
 #ifdef DEBUG_DIRECTORY
 	      if (YS__Simtime > DEBUG_TIME)
-		fprintf(simout,"  new: %x %x\n",(*dir_item)->vector[1],(*dir_item)->vector[0]);
+		fprintf(simout,"  new: %x %x\n",(*dir_item)->bits[1],(*dir_item)->bits[0]);
 #endif
 	      (*dir_item)->state = DIR_PRIVATE; /* will be held in PRIVATE state by requestor */
 		req->req_type = REPLY_UPGRADE; /* requestor will get upgrade reply */
@@ -1949,7 +1985,7 @@ int Dir_Cohe(DIR *dirptr, REQ *req, Dirst **dir_item, Dirst *copy, DirEP *extra)
 #ifdef DEBUG_DIRECTORY
 	  if (YS__Simtime > DEBUG_TIME)
 	    fprintf(simout,">>>>>>>>>>%s: READ_OWN from %d tag %ld state UNCACHED new:%x %x\n",dirptr->name,
-		   req->src_node,req->tag,(*dir_item)->vector[1],(*dir_item)->vector[0]);
+		   req->src_node,req->tag,(*dir_item)->bits[1],(*dir_item)->bits[0]);
 #endif
 	  extra->counter = 0; /* no COHEs needed */
 	  (*dir_item)->state = DIR_PRIVATE; /* requestor is owner */
@@ -1963,12 +1999,12 @@ int Dir_Cohe(DIR *dirptr, REQ *req, Dirst **dir_item, Dirst *copy, DirEP *extra)
 	  if (YS__Simtime > DEBUG_TIME)
 	    fprintf(simout,">>>>>>>>>>%s: READ_OWN from %d tag %ld state DIR_SHARED was:%x %x",
 		   dirptr->name,req->src_node,req->tag,
-		   (*dir_item)->vector[1],(*dir_item)->vector[0]);
+		   (*dir_item)->bits[1],(*dir_item)->bits[0]);
 #endif
 
 	  /* identify all other sharers */
 	  find = DirFind_FM(dirptr, *dir_item, extra->node_ary, node_index, &node_copy);
-	  if (find == 0)
+	  if (find == 0 && !(*dir_item)->overflow)
 	    {
 	      fprintf(simerr,"Dir_Cohe(): State is DIR_SHARED; find must be at least 1; dir node: %d\n",
 		      dirptr->node_num);
@@ -1989,7 +2025,7 @@ int Dir_Cohe(DIR *dirptr, REQ *req, Dirst **dir_item, Dirst *copy, DirEP *extra)
 	  DirRmAllAdd_FM(dirptr, *dir_item, node_index,req);
 #ifdef DEBUG_DIRECTORY
 	  if (YS__Simtime > DEBUG_TIME)
-	    fprintf(simout,"  new:%x %x\n",(*dir_item)->vector[1],(*dir_item)->vector[0]);
+	    fprintf(simout,"  new:%x %x\n",(*dir_item)->bits[1],(*dir_item)->bits[0]);
 #endif
 	  (*dir_item)->state = DIR_PRIVATE; /* line will be owned by the requestor */
 	  
@@ -2025,7 +2061,7 @@ int Dir_Cohe(DIR *dirptr, REQ *req, Dirst **dir_item, Dirst *copy, DirEP *extra)
 #ifdef DEBUG_DIRECTORY
 	  if (YS__Simtime > DEBUG_TIME)
 	    fprintf(simout,">>>>>>>>>>%s: READ_OWN from %d tag %ld state DIR_PRIVATE was:%x %x",dirptr->name,
-		   req->src_node,req->tag,(*dir_item)->vector[1],(*dir_item)->vector[0]);
+		   req->src_node,req->tag,(*dir_item)->bits[1],(*dir_item)->bits[0]);
 #endif
 	  find = DirFind_FM(dirptr, *dir_item, extra->node_ary, node_index, &node_copy);
 	  if (find != 1)
@@ -2083,7 +2119,7 @@ int Dir_Cohe(DIR *dirptr, REQ *req, Dirst **dir_item, Dirst *copy, DirEP *extra)
 	  DirRmAllAdd_FM(dirptr, *dir_item, node_index,req);
 #ifdef DEBUG_DIRECTORY
 	  if (YS__Simtime > DEBUG_TIME)
-	    fprintf(simout,"  new:%x %x\n",(*dir_item)->vector[1],(*dir_item)->vector[0]);
+	    fprintf(simout,"  new:%x %x\n",(*dir_item)->bits[1],(*dir_item)->bits[0]);
 #endif
 	  (*dir_item)->state = DIR_PRIVATE; /* requesting processor will end
 					       up as owner */
@@ -2110,7 +2146,7 @@ int Dir_Cohe(DIR *dirptr, REQ *req, Dirst **dir_item, Dirst *copy, DirEP *extra)
 #ifdef DEBUG_DIRECTORY
 	  if (YS__Simtime > DEBUG_TIME)
 	    fprintf(simout,">>>>>>>>>>%s: WRB from %d tag %ld state DIR_PRIVATE was:%x %x",dirptr->name,
-		   req->src_node,req->tag,(*dir_item)->vector[1],(*dir_item)->vector[0]);
+		   req->src_node,req->tag,(*dir_item)->bits[1],(*dir_item)->bits[0]);
 #endif
 	  find = DirFind_FM(dirptr, *dir_item, NULL, node_index, &node_copy);
 	  if (find != 1)
@@ -2136,7 +2172,7 @@ int Dir_Cohe(DIR *dirptr, REQ *req, Dirst **dir_item, Dirst *copy, DirEP *extra)
 	  DirRmAll_FM(dirptr, *dir_item, node_index); /* line is now uncached */
 #ifdef DEBUG_DIRECTORY
 	  if (YS__Simtime > DEBUG_TIME)
-	    fprintf(simout,"  new:%x %x\n",(*dir_item)->vector[1],(*dir_item)->vector[0]);
+	    fprintf(simout,"  new:%x %x\n",(*dir_item)->bits[1],(*dir_item)->bits[0]);
 #endif
 	  (*dir_item)->state = UNCACHED;
 	    return VISIT_MEM;
@@ -2342,9 +2378,76 @@ static REQ *DirQueueRm(struct DirQueue *q)
 
 /*****************************************************************************/
 /* Table Maintenance Routines: These keep track of the state of each cache   */
-/* line and the sharers                                                      */
+/* line and the sharers. The sharers are recorded according to dir_type:     */
+/*   CNTRL_FULL_MAP: a bit vector with one bit per node.                     */
+/*   CNTRL_LIMITED_PTR, CNTRL_COARSE_VEC: up to DIR_POINTERS node numbers,   */
+/*     the first numsharers words of the sharer information. A line that     */
+/*     gets more sharers than that is marked as overflowed. An overflowed    */
+/*     CNTRL_LIMITED_PTR line is thought to be shared by every node; an      */
+/*     overflowed CNTRL_COARSE_VEC line keeps one bit for each group of      */
+/*     DIR_COARSENESS nodes.                                                 */
+/* An overflowed line only gives a superset of the sharers. The extra        */
+/* INVLs it causes are NACKed by caches that do not have the line, which     */
+/* is acceptable for INVLs (NACK_OK). A line in DIR_PRIVATE state always has */
+/* a single exact sharer, since it is set with DirRmAllAdd_FM.               */
 /*****************************************************************************/
 
+/* number of words of sharer information in each line */
+static int DirVecWords(int dir_type, int num_nodes)
+{
+  int words;
+  
+  switch (dir_type)
+    {
+    case CNTRL_FULL_MAP:
+      return (num_nodes + 31) / 32;
+    case CNTRL_LIMITED_PTR:
+      return DIR_POINTERS;
+    case CNTRL_COARSE_VEC:
+      words = ((num_nodes + DIR_COARSENESS - 1) / DIR_COARSENESS + 31) / 32;
+      return words > DIR_POINTERS ? words : DIR_POINTERS;
+    default:
+      YS__errmsg("Unknown directory type");
+    }
+  return 0;
+}
+
+/* a line has outgrown its pointers: switch it to the imprecise format */
+static void DirOverflow(DIR *dirptr, Dirst *dir_item)
+{
+  int k, group;
+  
+  dir_item->overflow = 1;
+  if (MemsimStatOn)
+    dirptr->num_overflow++;
+  if (dirptr->dir_type != CNTRL_COARSE_VEC)
+    return; /* CNTRL_LIMITED_PTR: broadcast from now on */
+  
+  for (k=0; k < dir_item->numsharers; k++)
+    DirPtrTmp[k] = dir_item->bits[k];
+  for (k=0; k < dirptr->vec_index; k++)
+    dir_item->bits[k] = 0;
+  for (k=0; k < dir_item->numsharers; k++)
+    {
+      group = DirPtrTmp[k] / DIR_COARSENESS;
+      dir_item->bits[group / 32] |= 1 << (group % 32);
+    }
+}
+
+/* Stats for cold misses */
+static void DirColdAdd(DIR *dirptr, Dirst *dir_item, int node_index, REQ *req)
+{
+  unsigned *cold_vec = DirColdVec(dirptr, dir_item);
+  int i = node_index / 32;
+  int j = node_index % 32;
+  
+  if (!(cold_vec[i] & (1 << j))) {
+    /* in other words, we've never come here before for this processor */
+    req->line_cold = 1; /* so we'll see it for sure when we get line cold */
+    cold_vec[i] = cold_vec[i] | (1<<j); 
+  }
+}
+
 /* adds a new sharer */
 static int DirAdd_FM(DIR *dirptr, Dirst *dir_item, int node_index, REQ *req) /* return nonzero if we alone used to have it */
 #if 0
@@ -2353,30 +2456,49 @@ static int DirAdd_FM(DIR *dirptr, Dirst *dir_item, int node_index, REQ *req) /*
      int  node_index;		/* node_index should go from 0 to num_nodes-1 */
 #endif
 {
-  int i, j, num_nodes;
+  int i, j, k, num_nodes;
   unsigned oursalone, hadit;
   
   num_nodes = dirptr->num_nodes;
   if (node_index >= num_nodes)
     YS__errmsg("Invalid node index");
   
-  i = node_index / 32;
-  j = node_index % 32;
+  DirColdAdd(dirptr, dir_item, node_index, req);
 
-  hadit = (dir_item->vector[i] & (1 << j));
-  oursalone = hadit && (dir_item->numsharers == 1);
-  if (!hadit)
-    dir_item->numsharers++;
-  dir_item->vector[i] = dir_item->vector[i] | (1<<j);
+  if (dirptr->dir_type == CNTRL_FULL_MAP)
+    {
+      i = node_index / 32;
+      j = node_index % 32;
+
+      hadit = (dir_item->bits[i] & (1 << j));
+      oursalone = hadit && (dir_item->numsharers == 1);
+      if (!hadit)
+	dir_item->numsharers++;
+      dir_item->bits[i] = dir_item->bits[i] | (1<<j);
+      return oursalone;
+    }
 
-  /* Stats for cold misses */
-  if (!(dir_item->cold_vec[i] & (1 << j))) {
-    /* in other words, we've never come here before for this processor */
-    req->line_cold = 1; /* so we'll see it for sure when we get line cold */
-    dir_item->cold_vec[i] = dir_item->cold_vec[i] | (1<<j); 
-  }
+  if (!dir_item->overflow)
+    {
+      for (k=0; k < dir_item->numsharers; k++)
+	if (dir_item->bits[k] == node_index)
+	  return dir_item->numsharers == 1;
+      if (dir_item->numsharers < DIR_POINTERS)
+	{
+	  dir_item->bits[dir_item->numsharers++] = node_index;
+	  return 0;
+	}
+      DirOverflow(dirptr, dir_item);
+    }
 
-  return oursalone;
+  /* Overflowed: we can no longer tell whether we alone had it */
+  if (dirptr->dir_type == CNTRL_COARSE_VEC)
+    {
+      i = node_index / DIR_COARSENESS;
+      dir_item->bits[i / 32] |= 1 << (i % 32);
+    }
+  dir_item->numsharers++;
+  return 0;
 }
 
 /* removes all sharers but the specified node */
@@ -2387,31 +2509,22 @@ static void DirRmAllAdd_FM(DIR *dirptr, Dirst *dir_item, int node_index, REQ *re
      int  node_index;		/* node_index should go from 0 to num_nodes-1 */
 #endif
 {
-  int i, j, k, num_nodes;
+  int k, num_nodes;
   
   num_nodes = dirptr->num_nodes;
   if (node_index >= num_nodes)
     YS__errmsg("Invalid node index");
   
-  i = node_index / 32;
-  j = node_index % 32;
-
+  for (k=0; k < dirptr->vec_index; k++)
+    dir_item->bits[k] = 0;
   dir_item->numsharers = 1;
-  dir_item->vector[i] =  (1<<j);
-
-  for (k=0; k<i; k++)
-    dir_item->vector[k] = 0;
-  for (k=i+1; k < dirptr->vec_index; k++)
-    dir_item->vector[k] = 0;
-
-  /* Stats for cold misses */
-  if (!(dir_item->cold_vec[i] & (1 << j))) {
-    /* in other words, we've never come here before for this processor */
-    req->line_cold = 1; /* so we'll see it for sure when we get line cold */
-    dir_item->cold_vec[i] = dir_item->cold_vec[i] | (1<<j); 
-  }
-
+  dir_item->overflow = 0;
+  if (dirptr->dir_type == CNTRL_FULL_MAP)
+    dir_item->bits[node_index / 32] = 1 << (node_index % 32);
+  else
+    dir_item->bits[0] = node_index;
 
+  DirColdAdd(dirptr, dir_item, node_index, req);
 }
 
 /* remove all sharers, including requestor. Used in WRBs and invalidation
@@ -2430,8 +2543,9 @@ static void DirRmAll_FM(DIR *dirptr, Dirst *dir_item, int node_index)
     YS__errmsg("Invalid node index");
   
   dir_item->numsharers = 0;
+  dir_item->overflow = 0;
   for (k=0; k<dirptr->vec_index; k++)
-    dir_item->vector[k] = 0;
+    dir_item->bits[k] = 0;
 }
 
 /* remove specified node from sharers */
@@ -2442,23 +2556,39 @@ void DirRm_FM(DIR *dirptr, Dirst *dir_item, int node_index)
      int  node_index;		/* node_index should go from 0 to num_nodes-1 */
 #endif
 {
-  int i, j, num_nodes;
+  int i, j, k, num_nodes;
   
   num_nodes = dirptr->num_nodes;
   if (node_index >= num_nodes)
     YS__errmsg("Invalid node index");
   
-  i = node_index / 32;
-  j = node_index % 32;
+  if (dirptr->dir_type == CNTRL_FULL_MAP)
+    {
+      i = node_index / 32;
+      j = node_index % 32;
 
-  if (dir_item->vector[i] & (1<<j))
-    dir_item->numsharers--;
-  
-  dir_item->vector[i] = dir_item->vector[i] & (~(1<<j));
+      if (dir_item->bits[i] & (1<<j))
+	dir_item->numsharers--;
   
+      dir_item->bits[i] = dir_item->bits[i] & (~(1<<j));
+      return;
+    }
+
+  if (dir_item->overflow) /* other nodes may share the bit; leave it */
+    return;
+  for (k=0; k < dir_item->numsharers; k++)
+    if (dir_item->bits[k] == node_index)
+      {
+	dir_item->numsharers--;
+	dir_item->bits[k] = dir_item->bits[dir_item->numsharers];
+	dir_item->bits[dir_item->numsharers] = 0;
+	return;
+      }
 }
 
-/* find the list of sharers, built up in node_ary */
+/* find the list of sharers, built up in node_ary. For an overflowed
+   line, every node that may share it (other than node_num) is listed,
+   and node_num is never reported as having a copy. */
 static int DirFind_FM(dirptr, dir_item, node_ary, node_num, node_copy)
      DIR *dirptr;		/* Pointer to directory module */
      Dirst *dir_item;		/* Pointer to data structure for this line */
@@ -2472,98 +2602,383 @@ static int DirFind_FM(dirptr, dir_item, node_ary, node_num, node_copy)
   
   *node_copy = 0;
 
-  for (i=0; i < dirptr->vec_index; i++)
+  if (dirptr->dir_type == CNTRL_FULL_MAP)
     {
-      if (dir_item->vector[i])
+      for (i=0; i < dirptr->vec_index; i++)
 	{
-	  j=1;
-	  for (k=0; k<32; k++)
+	  if (dir_item->bits[i])
 	    {
-	      if (dir_item->vector[i] & j)
+	      j=1;
+	      for (k=0; k<32; k++)
 		{
-		  if ((node_ary != NULL) && ((node = i*32+k) != node_num))
+		  if (dir_item->bits[i] & j)
 		    {
-		      node_ary[node_ary_idx] = node ;
-		      node_ary_idx++;
+		      if ((node_ary != NULL) && ((node = i*32+k) != node_num))
+			{
+			  node_ary[node_ary_idx] = node ;
+			  node_ary_idx++;
+			}
+		      else *node_copy = 1; /* requesting node (node_num) has a copy of data */
+		      find ++;
 		    }
-		  else *node_copy = 1; /* requesting node (node_num) has a copy of data */
-		  find ++;
+		  j = j<<1;
 		}
-	      j = j<<1;
 	    }
 	}
+      return find;
+    }
+
+  if (!dir_item->overflow)
+    {
+      for (k=0; k < dir_item->numsharers; k++)
+	{
+	  if ((node_ary != NULL) && ((node = dir_item->bits[k]) != node_num))
+	    {
+	      node_ary[node_ary_idx] = node ;
+	      node_ary_idx++;
+	    }
+	  else *node_copy = 1; /* requesting node (node_num) has a copy of data */
+	  find ++;
+	}
+      return find;
+    }
+
+  /* Overflowed. Only shared lines overflow; a PRIVATE line (the only
+     case where node_ary is NULL) always has a single exact sharer. */
+  if (node_ary == NULL)
+    YS__errmsg("DirFind_FM(): overflowed line needs a node_ary");
+  for (i=0; i < dirptr->num_nodes; i++)
+    {
+      if (dirptr->dir_type == CNTRL_COARSE_VEC)
+	{
+	  k = i / DIR_COARSENESS;
+	  if (!(dir_item->bits[k / 32] & (1 << (k % 32))))
+	    {
+	      i = (k + 1) * DIR_COARSENESS - 1; /* skip the rest of the group */
+	      continue;
+	    }
+	}
+      if (i != node_num)
+	{
+	  node_ary[node_ary_idx] = i;
+	  node_ary_idx++;
+	  find ++;
+	}
     }
   return find;
 }
 
 /*****************************************************************************/
 /* DirHashLookup_FM: Lookup the specified line in the directory chain        */
-/* hash table. If line is not present, add a new empty entry for it.         */
+/* hash table. If line is not present, add a new empty entry for it. In a    */
+/* sparse directory the new entry may force another line of its set out.     */
 /*****************************************************************************/
-Dirst *DirHashLookup_FM(dirptr, tag)
+Dirst *DirHashLookup_FM(dirptr, tag, req)
      DIR *dirptr;
      long tag;
+     REQ *req;			/* access being processed -- supplies the
+				   fields of any invalidations sent */
 {
   int i,j;
 
   Dirst *temp, *temp_prev;
 
-  i = tag & HashIdxMask;		/* hash index for this tag  */
-
-  if (dirptr->data_hash[i] == NULL) { /* this hash head is null */
-    dirptr->data_hash[i] = (Dirst *)YS__PoolGetObj(&YS__DirstPool);
-    temp = dirptr->data_hash[i];
-    temp->tag = tag;
-    for (j=0; j < dirptr->vec_index; j++)
-      temp->vector[j] = temp->cold_vec[j] = 0;
-    temp->state = UNCACHED;
-    temp->pend = 0;
-    temp->extra = NULL;
-    temp->next = NULL;
-    return temp;
-  }
-    
-  else {
-    temp = dirptr->data_hash[i];
-    temp_prev = NULL;
+  i = tag & dirptr->hash_mask;		/* hash index for this tag  */
+
+  temp = dirptr->data_hash[i];
+  temp_prev = NULL;
     
-    while(temp) {
-      if (temp->tag == tag)
+  while(temp) {
+    if (temp->tag == tag)
+      {
+	/* We'll do a self-optimizing hash list that moves this to the
+	   head automatically */
+	if (temp_prev) /* this means we weren't already at the head */
+	  {
+	    temp_prev->next = temp->next; /* take us out of the list */
+	    temp->next = dirptr->data_hash[i]; 
+	    dirptr->data_hash[i] = temp; /* move this to head, since it's likely to be ref'd again soon */
+	  }
+	if (dirptr->dir_set && DIR_REPL == LRU && !temp->evicting)
+	  DirSetTouch(dirptr, temp);
+	return temp;
+      }
+    else {
+      temp_prev = temp;
+      temp = temp->next;
+    }
+  }
+
+  /* Not present: add a new entry at the head of the chain, growing the
+     table first if it has become too heavily loaded */
+  if (++dirptr->num_lines > DIR_HASH_LOAD * (dirptr->hash_mask + 1))
+    {
+      DirHashGrow(dirptr);
+      i = tag & dirptr->hash_mask;
+    }
+  temp = (Dirst *)YS__PoolGetObj(&YS__DirstPool);
+  temp->tag = tag;
+  for (j=0; j < dirptr->vec_index + dirptr->cold_index; j++)
+    temp->bits[j] = 0;
+  temp->state = UNCACHED;
+  temp->pend = 0;
+  temp->overflow = 0;
+  temp->evicting = 0;
+  temp->numsharers = 0;
+  temp->extra = NULL;
+  temp->next = dirptr->data_hash[i];
+  dirptr->data_hash[i] = temp; /* move this to head, since it's likely to be ref'd */
+  if (dirptr->dir_set)
+    DirSetInsert(dirptr, temp, req);
+  return temp;
+}
+
+/*****************************************************************************/
+/* DirHashGrow: doubles the number of buckets in the directory hash table.   */
+/* Lines keep their addresses (REQs point to them), only the chains change.  */
+/*****************************************************************************/
+static void DirHashGrow(DIR *dirptr)
+{
+  Dirst **old_hash, *temp, *temp_next;
+  int i, old_size, new_mask;
+
+  old_hash = dirptr->data_hash;
+  old_size = dirptr->hash_mask + 1;
+  new_mask = 2 * old_size - 1;
+
+  dirptr->data_hash = (Dirst **)malloc((new_mask + 1) * sizeof(Dirst *));
+  if (dirptr->data_hash == NULL)
+    YS__errmsg("DirHashGrow(): malloc failed");
+  for (i=0; i <= new_mask; i++)
+    dirptr->data_hash[i] = NULL;
+
+  /* Walk each chain from the tail end so recently used lines stay near
+     the head of their new chains */
+  for (i=0; i < old_size; i++)
+    {
+      temp = old_hash[i];
+      old_hash[i] = NULL;
+      while (temp)     /* reverse the chain into old_hash[i] */
+	{
+	  temp_next = temp->next;
+	  temp->next = old_hash[i];
+	  old_hash[i] = temp;
+	  temp = temp_next;
+	}
+      for (temp = old_hash[i]; temp; temp = temp_next)
 	{
-	  /* We'll do a self-optimizing hash list that moves this to the
-	     head automatically */
-	  if (temp_prev) /* this means we weren't already at the head */
+	  temp_next = temp->next;
+	  temp->next = dirptr->data_hash[temp->tag & new_mask];
+	  dirptr->data_hash[temp->tag & new_mask] = temp;
+	}
+    }
+
+  free(old_hash);
+  dirptr->hash_mask = new_mask;
+}
+
+/*****************************************************************************/
+/* DirHashRemove: unlinks a line from its hash chain. The caller frees it.   */
+/*****************************************************************************/
+static void DirHashRemove(DIR *dirptr, Dirst *dir_item)
+{
+  Dirst **temp;
+
+  for (temp = &dirptr->data_hash[dir_item->tag & dirptr->hash_mask];
+       *temp != dir_item; temp = &(*temp)->next)
+    if (*temp == NULL)
+      YS__errmsg("DirHashRemove(): line not in the directory");
+  *temp = dir_item->next;
+  dirptr->num_lines--;
+}
+
+/*****************************************************************************/
+/* Sparse directory: each set is a list of at most DIR_ASSOC lines kept in   */
+/* replacement order, most recently used (LRU) or inserted (FIFO, RANDOM)    */
+/* first. The sets only bound how many lines are tracked; lines are still    */
+/* found through the hash table.                                             */
+/*****************************************************************************/
+
+/* DirSetTouch: move a line to the head of its set on an LRU reference */
+static void DirSetTouch(DIR *dirptr, Dirst *dir_item)
+{
+  Dirst **temp, **head;
+
+  head = temp = &dirptr->dir_set[dir_item->tag % DIR_SETS];
+  if (*head == dir_item)
+    return;
+  while (*temp != dir_item)
+    temp = &(*temp)->set_next;
+  *temp = dir_item->set_next;
+  dir_item->set_next = *head;
+  *head = dir_item;
+}
+
+/* DirSetInsert: add a new line to its set, first evicting lines until the
+   set has room. Only lines with nothing outstanding can be evicted; if
+   every line of the set is pending, the set briefly holds an extra line
+   and shrinks back on a later insertion. */
+static void DirSetInsert(DIR *dirptr, Dirst *dir_item, REQ *req)
+{
+  Dirst *temp, *victim;
+  int set = dir_item->tag % DIR_SETS;
+  int num;
+
+  while (dirptr->set_count[set] >= DIR_ASSOC)
+    {
+      victim = NULL;
+      if (DIR_REPL == RANDOM)
+	{
+	  num = 0;
+	  for (temp = dirptr->dir_set[set]; temp; temp = temp->set_next)
+	    if (!temp->pend && !temp->extra)
+	      num++;
+	  if (num)
 	    {
-	      temp_prev->next = temp->next; /* take us out of the list */
-	      temp->next = dirptr->data_hash[i]; 
-	      dirptr->data_hash[i] = temp; /* move this to head, since it's likely to be ref'd again soon */
+	      dirptr->repl_seed = dirptr->repl_seed * 1103515245 + 12345;
+	      num = (dirptr->repl_seed >> 16) % num;
+	      for (temp = dirptr->dir_set[set]; temp; temp = temp->set_next)
+		if (!temp->pend && !temp->extra && num-- == 0)
+		  {
+		    victim = temp;
+		    break;
+		  }
 	    }
-	  return temp;
 	}
-      else {
-	temp_prev = temp;
-	temp = temp->next;
-      }
-    }
-    if (!temp) {
-      temp = (Dirst *)YS__PoolGetObj(&YS__DirstPool);
-      if (temp_prev)
+      else /* LRU or FIFO: the last line that can go */
 	{
-	  /* Put the new entry at the head -- done below */
+	  for (temp = dirptr->dir_set[set]; temp; temp = temp->set_next)
+	    if (!temp->pend && !temp->extra)
+	      victim = temp;
 	}
-      else
-	YS__errmsg("DirHashLookup_FM(): This should be a hash head entry");
+
+      if (victim == NULL)
+	{
+	  if (MemsimStatOn)
+	    dirptr->num_set_full++;
+	  break;
+	}
+      DirEvict(dirptr, victim, req);
     }
-    temp->tag = tag;
-    for (j=0; j < dirptr->vec_index; j++)
-      temp->vector[j] = temp->cold_vec[j] = 0;
-    temp->state = UNCACHED;
-    temp->pend = 0;
-    temp->extra = NULL;
-    temp->next = dirptr->data_hash[i];
-    dirptr->data_hash[i] = temp; /* move this to head, since it's likely to be ref'd */
-    return temp;
-  }
+
+  dir_item->set_next = dirptr->dir_set[set];
+  dirptr->dir_set[set] = dir_item;
+  dirptr->set_count[set]++;
+}
+
+/*****************************************************************************/
+/* DirEvict: takes a line out of its sparse-directory set. An uncached line  */
+/* is freed at once. Otherwise each sharer is sent an INVL (a COPYBACK_INVL  */
+/* for a private line, so that dirty data comes back to memory) and the line */
+/* stays in the hash table, pending, until DirEvictDone is called on the     */
+/* last COHE_REPLY. Accesses to it meanwhile wait in the pending buffer.     */
+/* The COHEs go out through OutboundReqs, as the directory may be in the     */
+/* middle of another access.                                                 */
+/*****************************************************************************/
+static void DirEvict(DIR *dirptr, Dirst *victim, REQ *req)
+{
+  Dirst **temp;
+  DirEP *extra;
+  REQ *req1;
+  int i, node_copy;
+
+  for (temp = &dirptr->dir_set[victim->tag % DIR_SETS]; *temp != victim;
+       temp = &(*temp)->set_next);
+  *temp = victim->set_next;
+  dirptr->set_count[victim->tag % DIR_SETS]--;
+  victim->set_next = NULL;
+  if (MemsimStatOn)
+    dirptr->num_evict++;
+
+  if (victim->state == UNCACHED)
+    {
+      DirHashRemove(dirptr, victim);
+      YS__PoolReturnObj(&YS__DirstPool, victim);
+      return;
+    }
+
+  extra = (DirEP *)YS__PoolGetObj(&YS__DirEPPool);
+  extra->counter = DirFind_FM(dirptr, victim, extra->node_ary, -1, &node_copy);
+  extra->num_left = 0;
+  extra->pend_req = NULL;
+  extra->waiting = 0;
+  extra->WaitingFor = -1;
+  extra->WasHere = -1;
+  extra->ret_st = EVICT_REPLY;
+  extra->size_st = REQ_SZ;
+  if (victim->state == DIR_PRIVATE)
+    {
+      /* NACK_NOK: an owner whose reply is still in flight must not
+	 ignore this, so it answers NACK_PEND until the line arrives */
+      extra->next_req_type = COPYBACK_INVL;
+      extra->size_req = REQ_SZ+LINESZ;
+      extra->nack_st = NACK_NOK;
+    }
+  else
+    {
+      extra->next_req_type = INVL;
+      extra->size_req = REQ_SZ;
+      extra->nack_st = NACK_OK;
+    }
+
+  victim->pend = 1;
+  victim->evicting = 1;
+  victim->extra = extra;
+  dirptr->wait_cntsz++;
+  if (MemsimStatOn)
+    dirptr->num_evict_invl += extra->counter;
+
+  for (i=0; i < extra->counter; i++)
+    {
+      req1 = (REQ *)YS__PoolGetObj(&YS__ReqPool);
+      req1->id = YS__idctr ++;
+      req1->priority = 0;
+      req1->address = (long)victim->tag * dirptr->line_size;
+      req1->tag = victim->tag;
+      req1->src_node = dirptr->node_num;
+      req1->dest_node = extra->node_ary[i];
+      req1->req_type = extra->next_req_type;
+      req1->size_st = extra->size_st;
+      req1->size_req = extra->size_req;
+      req1->address_type = req->address_type;
+      req1->dubref = req->dubref;
+      req1->s.reply = 0;
+      req1->s.dir = REQ_FWD;
+      req1->s.route = ABV;
+      req1->s.ret = RET;
+      req1->s.type = COHE;
+      req1->s.nack_st = extra->nack_st;
+      req1->s.nc = 0;
+      req1->s.dirdone = 0;
+      req1->start_time = GetSimTime();
+      req1->cohe_type = req->cohe_type;
+      req1->allo_type = req->allo_type;
+      req1->linesz = req->linesz;
+      req1->dir_item = victim;
+
+      dirptr->outboundsz++;
+      DirQueueAdd(dirptr->OutboundReqs, req1);
+    }
+
+#ifdef DEBUG_DIRECTORY
+  if (DEBUG_TIME < YS__Simtime)
+    fprintf(simout,"%s: evicting tag %ld with %d COHEs @:%1.0f\n",
+	    dirptr->name, (long)victim->tag, extra->counter, YS__Simtime);
+#endif
+}
+
+/*****************************************************************************/
+/* DirEvictDone: all COHE_REPLYs of an eviction are in; free the line and    */
+/* revive the accesses that were waiting for it.                             */
+/*****************************************************************************/
+static void DirEvictDone(DIR *dirptr, Dirst *dir_item)
+{
+  long tag = dir_item->tag;
+
+  YS__PoolReturnObj(&YS__DirEPPool, dir_item->extra);
+  DirHashRemove(dirptr, dir_item);
+  YS__PoolReturnObj(&YS__DirstPool, dir_item);
+  DirCheckBuf(dirptr, tag);
 }
 
 /*****************************************************************************/
@@ -2668,7 +3083,7 @@ DIR *NewDir(char *name, int node_num, int stat_level, rtfunc routing,
      int    ports_blw;		/* Number of ports below this module                   */
                                 /* DIR Attributes                                      */
      int    line_size;
-     int    dir_type;		/* Only CNTRL_FULL_MAP supported; (full bit map vector) */
+     int    dir_type;		/* CNTRL_FULL_MAP, CNTRL_LIMITED_PTR or CNTRL_COARSE_VEC */
      int    num_nodes;		/* number of nodes present */
      int    bufsz;		/* size of buffering in module */
      cond   cohe_rtn;
@@ -2688,8 +3103,21 @@ DIR *NewDir(char *name, int node_num, int stat_level, rtfunc routing,
       dir_index ++;
     }
   if (dir_index == 1) 		/* First directory module created */
-    CoheNumInvlHist =
-      NewStatrec("NumInvl", POINT, MEANS, HISTSPECIAL, num_nodes, 0.0, (double)num_nodes);
+    {
+      CoheNumInvlHist =
+	NewStatrec("NumInvl", POINT, MEANS, HISTSPECIAL, num_nodes, 0.0, (double)num_nodes);
+      StatrecSetUnit(CoheNumInvlHist,"invalidations");
+
+      /* Size the line and extra-info pools for this many nodes */
+      if (YS__DirstPool.newed || YS__DirEPPool.newed)
+	YS__errmsg("NewDir(): directory pools already in use");
+      YS__PoolInit(&YS__DirstPool, "DirstPool", 200, sizeof(Dirst) +
+		   (DirVecWords(dir_type, num_nodes) + (num_nodes + 31) / 32 - 1) * sizeof(unsigned));
+      YS__PoolInit(&YS__DirEPPool, "DirEPPool", 200, sizeof(DirEP) +
+		   (num_nodes - 1) * sizeof(int));
+      if (dir_type == CNTRL_COARSE_VEC)
+	DirPtrTmp = (unsigned *)malloc(DIR_POINTERS * sizeof(unsigned));
+    }
   
   dirptr->id = YS__idctr++;	/* System assigned unique ID   */
   strncpy(dirptr->name, name,31); /* Copy module name */
@@ -2730,8 +3158,10 @@ DIR *NewDir(char *name, int node_num, int stat_level, rtfunc routing,
     YS__errmsg("NewDir(): Node number of directory not in the range 0 to num_nodes-1");
   dirptr->line_size = line_size;
   dirptr->num_nodes = num_nodes;
-  if (dir_type == CNTRL_FULL_MAP)     
-    dirptr->vec_index = (num_nodes / (sizeof(int)*8)) + ((num_nodes%(sizeof(int)*8)) ? 1:0);
+  if (DIR_POINTERS < 1 || DIR_COARSENESS < 1)
+    YS__errmsg("NewDir(): dirpointers and dircoarseness must be at least 1");
+  dirptr->vec_index = DirVecWords(dir_type, num_nodes);
+  dirptr->cold_index = (num_nodes + 31) / 32;
 
   /* Initialize directory buffer, pending buffer, and queues */
   dirptr->buftotsz = 0;
@@ -2759,10 +3189,34 @@ DIR *NewDir(char *name, int node_num, int stat_level, rtfunc routing,
   dirptr->extra->WasHere = -1;
 
 
-  /* Start out the chain Hash table */
+  /* Start out the chain Hash table; DirHashLookup_FM grows it */
+  dirptr->hash_mask = HashIdxMask;
+  dirptr->num_lines = 0;
+  dirptr->data_hash = (Dirst **)malloc((HashIdxMask+1) * sizeof(Dirst *));
+  if (dirptr->data_hash == NULL)
+    YS__errmsg("NewDir(): malloc failed");
   for (i=0; i<HashIdxMask+1; i++)  {
     dirptr->data_hash[i] = NULL;
   }
+
+  /* A sparse directory bounds the lines tracked to DIR_SETS*DIR_ASSOC */
+  dirptr->dir_set = NULL;
+  dirptr->set_count = NULL;
+  dirptr->repl_seed = node_num + 1;
+  if (DIR_SETS)
+    {
+      if (DIR_SETS < 0 || DIR_ASSOC < 1)
+	YS__errmsg("NewDir(): dirsets must not be negative and dirassoc must be at least 1");
+      dirptr->dir_set = (Dirst **)malloc(DIR_SETS * sizeof(Dirst *));
+      dirptr->set_count = (int *)malloc(DIR_SETS * sizeof(int));
+      if (dirptr->dir_set == NULL || dirptr->set_count == NULL)
+	YS__errmsg("NewDir(): malloc failed");
+      for (i=0; i<DIR_SETS; i++)
+	{
+	  dirptr->dir_set[i] = NULL;
+	  dirptr->set_count[i] = 0;
+	}
+    }
   
   dirptr->cohe_rtn = cohe_rtn;      /* Dir_Cohe by default */
   if (link_para)   {
@@ -2779,10 +3233,16 @@ DIR *NewDir(char *name, int node_num, int stat_level, rtfunc routing,
   dirptr->num_buf_RAR = 0;
   dirptr->num_race_RAR = 0;
   dirptr->num_c2c = 0;
+  dirptr->num_overflow = 0;
+  dirptr->num_evict = 0;
+  dirptr->num_evict_invl = 0;
+  dirptr->num_set_full = 0;
   sprintf(evnt_name, "%s_NumInvlStat",name);
   dirptr->CoheNumInvlMeans = NewStatrec(evnt_name, POINT, MEANS, NOHIST, 0, 0, 0);
   sprintf(evnt_name, "%s_DirBufTotSize",name);
   dirptr->BufTotSzMeans = NewStatrec(evnt_name, INTERVAL, MEANS, NOHIST, 0, 0, 0);
+  StatrecSetUnit(dirptr->CoheNumInvlMeans,"invalidations");
+  StatrecSetUnit(dirptr->BufTotSzMeans,"requests");
   dirptr->utilization = 0.0;
   dirptr->time_of_last_clear = 0.0;
   return dirptr;
@@ -2853,6 +3313,7 @@ void DirStatReport (dirptr)
   out=simout;
   
 
+  StatOutScope("dir",dirptr->name);
   SMModuleStatReport(dirptr , &hitpr, &lat, &util);
 
   if (dirptr->stat_level > 1) {
@@ -2874,6 +3335,32 @@ void DirStatReport (dirptr)
     fprintf(simout,"              NumBufRAR \n");
     fprintf(simout,"         %10d(%6.4g) \n", 
 	    dirptr->num_buf_RAR, buffr);
+    if (dirptr->dir_type != CNTRL_FULL_MAP)
+      fprintf(simout,"              Pointer overflows: %d\n", dirptr->num_overflow);
+    if (dirptr->dir_set)
+      {
+	fprintf(simout,"              Evictions         EvictInvl      SetFull\n");
+	fprintf(simout,"         %10d(%6.4g) %8d %12d\n",
+		dirptr->num_evict,
+		dirptr->num_ref ? (double)dirptr->num_evict/(double)dirptr->num_ref : 0.0,
+		dirptr->num_evict_invl, dirptr->num_set_full);
+      }
+    if (StatOut)
+      {
+	STATOUT("num_read",dirptr->num_read,"count");
+	STATOUT("num_write",dirptr->num_write,"count");
+	STATOUT("num_local",dirptr->num_local,"count");
+	STATOUT("num_remote",dirptr->num_ref - dirptr->num_local,"count");
+	STATOUT("num_buf_RAR",dirptr->num_buf_RAR,"count");
+	if (dirptr->dir_type != CNTRL_FULL_MAP)
+	  STATOUT("pointer_overflows",dirptr->num_overflow,"count");
+	if (dirptr->dir_set)
+	  {
+	    STATOUT("evictions",dirptr->num_evict,"count");
+	    STATOUT("eviction_invalidations",dirptr->num_evict_invl,"count");
+	    STATOUT("set_full",dirptr->num_set_full,"count");
+	  }
+      }
   }
   
 }
@@ -2895,6 +3382,10 @@ void DirStatClear (dirptr)
     dirptr->num_buf_RAR = 0;
     dirptr->num_race_RAR = 0;
     dirptr->num_c2c = 0;
+    dirptr->num_overflow = 0;
+    dirptr->num_evict = 0;
+    dirptr->num_evict_invl = 0;
+    dirptr->num_set_full = 0;
     dirptr->utilization = 0.0;
     dirptr->time_of_last_clear = YS__Simtime;
   }
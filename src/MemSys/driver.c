@@ -65,6 +65,7 @@
 #include "MemSys/tr.driver.h"
 #include "Processor/simio.h"
 #include "MemSys/dbsim.h"
+#include "MemSys/hostprof.h"
 
 #include <fcntl.h>
 #include <signal.h>
@@ -154,6 +155,7 @@ void DriverReset()                 /* Resets the driver (Sets YS__Simtime to 0)*
 {
   STATREC *srptr;
   MESSAGE *mptr;
+  PACKET  *pkptr;
 
   if (YS__ActEvnt != NULL)
     YS__errmsg("Can not call DriverReset() from within a process or an event");
@@ -168,6 +170,8 @@ void DriverReset()                 /* Resets the driver (Sets YS__Simtime to 0)*
   YS__PoolReset(&YS__SemPool);
   YS__PoolReset(&YS__QelemPool);
   YS__PoolReset(&YS__PrcrPool);
+  for (pkptr = (PACKET*)YS__PktPool.p_head; pkptr != NULL; pkptr = (PACKET*)(pkptr->pnxt))
+    pkptr->headobj = pkptr->tailobj = NULL; /* their events were just reset */
   YS__PoolReset(&YS__PktPool);
   for (srptr = (STATREC*)YS__StatPool.p_head; 
        srptr != NULL;
@@ -252,7 +256,9 @@ int DriverRun(time)               /* Activates the simulation driver; returns a
 	  if (YS__ActEvnt->statptr)          /* Activity stats collected    */
 	    StatrecUpdate(YS__ActEvnt->statptr,(double)RUNNING,YS__Simtime);
 		    
+	  HOSTPROF_BEGIN(HostProfEventClass(YS__ActEvnt->body));
 	  (YS__ActEvnt->body)();             /* THE EVENT OCCURS            */
+	  HOSTPROF_END;
 		    
 	  YS__ActEvnt->status = LIMBO;       /* For statistics collection   */
 	  if (YS__ActEvnt->statptr)          /* Activity stats collected    */
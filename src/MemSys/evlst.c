@@ -57,18 +57,27 @@
 #include "MemSys/simsys.h"
 #include "MemSys/tr.evlst.h"
 #include "MemSys/dbsim.h"
+#include "MemSys/hostprof.h"
 
 /*****************************************************************************/
-/* EVENT LIST Operations: There are two implementations of the eventlist:    */
-/* a calendar queue and a simple linear list.  The choice of which list      */
-/* to use is determined by a command line argument or by the operation       */
-/* EventListSelect().  The implementaton of the calendar queue algorithm     */
-/* follows the description in "Calendar Queues: A Fast O(1) Priority         */
-/* Queue Implementation for the Simulation Event Set Problem," by Randy      */
-/* Brown, Comm. ACM, Oct. 1988, pp. 1220-1227.                               */
+/* EVENT LIST Operations: There are three implementations of the eventlist:  */
+/* a calendar queue, a simple linear list, and a timing wheel.  The choice   */
+/* of which list to use is determined by a command line argument or by the   */
+/* operation EventListSelect().  The implementaton of the calendar queue     */
+/* algorithm follows the description in "Calendar Queues: A Fast O(1)        */
+/* Priority Queue Implementation for the Simulation Event Set Problem," by   */
+/* Randy Brown, Comm. ACM, Oct. 1988, pp. 1220-1227.                         */
+/*                                                                           */
+/* The timing wheel divides time into ticks of 1/TWRES.  Level 0 has one     */
+/* slot per tick of the current block of TWSLOTS ticks; level 1 has one slot */
+/* per block for the next TWSLOTS blocks; anything later waits on a sorted   */
+/* overflow list.  Each level 0 slot is kept in time order, with equal times */
+/* in insertion order, so events come out exactly as from the linear list.  */
+/* Since nearly all events fall on a tick boundary and are inserted in time  */
+/* order, insertion is an append and removal takes the head of a slot.       */
 /*****************************************************************************/
 
-static int EventListType = CALQUE; /* Calendar queue = 0; Linear queue = 1 */
+static int EventListType = CALQUE; /* Calendar queue = 0; Linear queue = 1; Timing wheel = 2 */
 static STATREC *lengthstat = NULL; /* For collecting queue length statistics */
 
 /*  Static variables used when the event List is implemented as a simple linear list  */
@@ -100,6 +109,26 @@ static STATREC  *binsstat = NULL;     /* For collecting number of bins statistic
 static STATREC  *widthstat = NULL;    /* For collecting bin width statistics */
 static STATREC  *emptystat = NULL;    /* For collecting numbr of empty bins stats     */
 
+/*  Static variables used when the event list is implemented as a timing wheel */
+
+#define TWSHIFT  10                   /* log2 of the number of slots per level */
+#define TWSLOTS  (1<<TWSHIFT)         /* Number of slots in each wheel level   */
+#define TWMASK   (TWSLOTS-1)
+#define TWRES    2.0                  /* Ticks per unit of simulation time     */
+
+typedef long long TWTICK;
+
+static ACTIVITY *tw0head[TWSLOTS];    /* Level 0: one slot per tick          */
+static ACTIVITY *tw0tail[TWSLOTS];
+static ACTIVITY *tw1head[TWSLOTS];    /* Level 1: one slot per block of ticks */
+static ACTIVITY *tw1tail[TWSLOTS];
+static ACTIVITY *twfar;               /* Overflow list, sorted by time       */
+static ACTIVITY *twfartail;
+static TWTICK   twcur;                /* Current tick; no element is earlier */
+static int      tw0size;              /* Number of elements in level 0       */
+static int      tw1size;              /* Number of elements in level 1       */
+static int      twsize;               /* Total number of elements in the wheel */
+
 /* Function declarations for calendar queue operations */
 
 void     YS__CalQueInit();
@@ -299,6 +328,131 @@ void YS__CalQueFindHead()   /* Locates the new queue head after a dequeue or del
 
 /*****************************************************************************/
 
+static TWTICK YS__TimeWheelTick(t)   /* Returns the tick an element belongs to */
+double t;
+{
+   TWTICK k = (TWTICK)(t*TWRES);
+
+   if (k < twcur) return twcur;      /* Earlier than the head: current slot   */
+   return k;
+}
+
+/*****************************************************************************/
+
+static void YS__TimeWheelAdd(hp, tp, aptr)  /* Adds an element to a slot in  */
+ACTIVITY **hp;                              /* time order, after any element */
+ACTIVITY **tp;                              /* with the same time            */
+ACTIVITY *aptr;
+{
+   ACTIVITY *tp1;
+
+   if (*tp == NULL) {                       /* Slot empty                    */
+      aptr->next = NULL;
+      *hp = aptr;
+      *tp = aptr;
+   }
+   else if (aptr->time >= (*tp)->time) {    /* Usual case: put at the tail   */
+      (*tp)->next = (QE*)aptr;
+      aptr->next = NULL;
+      *tp = aptr;
+   }
+   else if (aptr->time < (*hp)->time) {     /* Put at the head               */
+      aptr->next = (QE*)(*hp);
+      *hp = aptr;
+   }
+   else {                                   /* Put in the middle             */
+      tp1 = *hp;
+      while (((ACTIVITY*)(tp1->next))->time <= aptr->time)
+         tp1 = (ACTIVITY*)(tp1->next);
+      aptr->next = tp1->next;
+      tp1->next = (QE*)aptr;
+   }
+}
+
+/*****************************************************************************/
+
+static void YS__TimeWheelPlace(aptr)   /* Puts an element in its level and slot */
+ACTIVITY *aptr;
+{
+   TWTICK k = YS__TimeWheelTick(aptr->time);
+   TWTICK d = (k>>TWSHIFT) - (twcur>>TWSHIFT);
+   int i;
+
+   if (d == 0) {                        /* In the current block: level 0     */
+      i = (int)(k & TWMASK);
+      YS__TimeWheelAdd(&tw0head[i],&tw0tail[i],aptr);
+      tw0size++;
+   }
+   else if (d < TWSLOTS) {              /* Level 1, kept in insertion order  */
+      i = (int)((k>>TWSHIFT) & TWMASK);
+      aptr->next = NULL;
+      if (tw1tail[i] == NULL) tw1head[i] = aptr;
+      else tw1tail[i]->next = (QE*)aptr;
+      tw1tail[i] = aptr;
+      tw1size++;
+   }
+   else                                 /* Too far ahead for the wheel       */
+      YS__TimeWheelAdd(&twfar,&twfartail,aptr);
+}
+
+/*****************************************************************************/
+
+static void YS__TimeWheelNextBlock()   /* Advances to the next block once    */
+{                                      /* level 0 is empty                   */
+   ACTIVITY *aptr, *nptr;
+   TWTICK   blk;
+   int      i;
+
+   if (tw1size == 0)                   /* Skip straight to the overflow list */
+      twcur = (((TWTICK)(twfar->time*TWRES))>>TWSHIFT)<<TWSHIFT;
+   else
+      twcur = ((twcur>>TWSHIFT)+1)<<TWSHIFT;
+   blk = twcur>>TWSHIFT;
+
+   /* Overflow elements now within reach of level 1 move there first, ahead
+      of anything inserted into those slots from now on */
+
+   while (twfar != NULL &&
+          (((TWTICK)(twfar->time*TWRES))>>TWSHIFT) - blk < TWSLOTS) {
+      aptr = twfar;
+      twfar = (ACTIVITY*)(aptr->next);
+      if (twfar == NULL) twfartail = NULL;
+      i = (int)((((TWTICK)(aptr->time*TWRES))>>TWSHIFT) & TWMASK);
+      aptr->next = NULL;
+      if (tw1tail[i] == NULL) tw1head[i] = aptr;
+      else tw1tail[i]->next = (QE*)aptr;
+      tw1tail[i] = aptr;
+      tw1size++;
+   }
+
+   /* Then spread this block's level 1 slot over level 0 */
+
+   i = (int)(blk & TWMASK);
+   aptr = tw1head[i];
+   tw1head[i] = NULL;
+   tw1tail[i] = NULL;
+   while (aptr != NULL) {
+      nptr = (ACTIVITY*)(aptr->next);
+      tw1size--;
+      YS__TimeWheelPlace(aptr);
+      aptr = nptr;
+   }
+}
+
+/*****************************************************************************/
+
+static ACTIVITY *YS__TimeWheelFindHead()  /* Moves twcur to the first non-   */
+{                                         /* empty slot and returns its head */
+   if (twsize == 0) return NULL;
+   while (tw0size == 0)
+      YS__TimeWheelNextBlock();
+   while (tw0head[twcur & TWMASK] == NULL)
+      twcur++;
+   return tw0head[twcur & TWMASK];
+}
+
+/*****************************************************************************/
+
 void YS__EventListSetBins(i)       /* Sets the number of bins to a fixed size*/
 int i;                             /* The new bin size                       */
 {
@@ -331,6 +485,20 @@ void YS__EventListInit()           /* Initializes the event list             */
       resizeon = 1;
    }
 
+   else if (EventListType == TIMEWHEEL)
+
+   /* Using timing wheel implementation for the event list */
+   {
+      int i;
+      for (i=0; i<TWSLOTS; i++) {
+         tw0head[i] = tw0tail[i] = NULL;
+         tw1head[i] = tw1tail[i] = NULL;
+      }
+      twfar = twfartail = NULL;
+      twcur = 0;
+      tw0size = tw1size = twsize = 0;
+   }
+
    else  /* Using simple linear search implementation for the event list */
    {
       TRACE_EVLST_init2;
@@ -349,6 +517,7 @@ ACTIVITY *aptr;                  /* Pointer to element to be enqueued        */
    ACTIVITY *tp1;
    ACTIVITY *tp2;
 
+   HOSTPROF_BEGIN(HP_EVLIST);
    TRACE_EVLST_insert;
 
    if (EventListType == CALQUE) /* Using calendar queue for the event list            */  
@@ -408,6 +577,14 @@ ACTIVITY *aptr;                  /* Pointer to element to be enqueued        */
       }
    }
 
+   else if (EventListType == TIMEWHEEL)  /* Using timing wheel for the event list */
+   {
+      YS__TimeWheelPlace(aptr);
+      twsize++;
+      if (lengthstat)                 /* Queue length statistics collected   */
+         StatrecUpdate(lengthstat,(double)twsize,1.0);
+   }
+
    else  /* Using simple linear search implementation for the event list */
    {
       if (head == NULL)  {          /* The queue is empty                    */
@@ -443,11 +620,12 @@ ACTIVITY *aptr;                  /* Pointer to element to be enqueued        */
          StatrecUpdate(lengthstat,(double)size,1.0);
    }
    TRACE_EVLST_show;
+   HOSTPROF_END;
 }
 
 /*****************************************************************************/
 
-ACTIVITY *YS__EventListGetHead()    /* Returns the head of the event list    */
+static ACTIVITY *YS__EventListRemoveHead()  /* Removes the event list head   */
 {
    ACTIVITY *retptr;
 
@@ -487,6 +665,27 @@ ACTIVITY *YS__EventListGetHead()    /* Returns the head of the event list    */
       return retptr;
    }
 
+   else if (EventListType == TIMEWHEEL)  /* Using timing wheel for the event list */
+   {
+      int i;
+
+      if ((retptr = YS__TimeWheelFindHead()) == NULL) { /* Wheel is empty   */
+         TRACE_EVLST_gethead1;
+         return NULL;
+      }
+      i = (int)(twcur & TWMASK);
+      tw0head[i] = (ACTIVITY*)(retptr->next);
+      if (tw0head[i] == NULL) tw0tail[i] = NULL;
+      retptr->next = NULL;
+      tw0size--;
+      twsize--;
+      if (lengthstat)              /* Queue length statistics collected     */
+         StatrecUpdate(lengthstat,(double)twsize,1.0);
+      TRACE_EVLST_gethead2;
+      TRACE_EVLST_show;
+      return retptr;
+   }
+
    else  /* Using simple linear search implementation for the event list */
    {
       if (head != NULL)  {         /* Queue not empty              */
@@ -512,6 +711,20 @@ ACTIVITY *YS__EventListGetHead()    /* Returns the head of the event list    */
 
 /*****************************************************************************/
 
+ACTIVITY *YS__EventListGetHead()    /* Returns the head of the event list    */
+{
+   ACTIVITY *retptr;
+
+   if (!HostProf)
+      return YS__EventListRemoveHead();
+   HostProfBegin(HP_EVLIST);        /* Charge the removal to the event list  */
+   retptr = YS__EventListRemoveHead();
+   HostProfEnd();
+   return retptr;
+}
+
+/*****************************************************************************/
+
 double YS__EventListHeadval()       /* Returns the time value of the event list head  */
 {
    double retval; 
@@ -528,6 +741,20 @@ double YS__EventListHeadval()       /* Returns the time value of the event list
       return retval;
    }
 
+   else if (EventListType == TIMEWHEEL)  /* Using timing wheel for the event list */
+   {
+      ACTIVITY *hptr = YS__TimeWheelFindHead();
+
+      if (hptr != NULL) {
+         retval = hptr->time;
+      }
+      else {
+         retval = -1.0;
+      }
+      TRACE_EVLST_headval;
+      return retval;
+   }
+
    else  /* Using simple linear search implementation for the event list */
    {
       if (head != NULL) {
@@ -599,6 +826,54 @@ ACTIVITY *aptr;                   /* Pointer to the element to remove        */
       return 1;
    }
 
+   else if (EventListType == TIMEWHEEL)  /* Using timing wheel for the event list */
+   {
+      ACTIVITY **hp, **tp;
+      TWTICK   k, d;
+      int      level;
+
+      TRACE_EVLST_delete;                 /* Deleting element from the Event List     */
+      k = YS__TimeWheelTick(aptr->time);  /* Locate the slot it was placed in */
+      d = (k>>TWSHIFT) - (twcur>>TWSHIFT);
+      if (d == 0) {
+         level = 0;
+         hp = &tw0head[k & TWMASK];
+         tp = &tw0tail[k & TWMASK];
+      }
+      else if (d < TWSLOTS) {
+         level = 1;
+         hp = &tw1head[(k>>TWSHIFT) & TWMASK];
+         tp = &tw1tail[(k>>TWSHIFT) & TWMASK];
+      }
+      else {
+         level = 2;
+         hp = &twfar;
+         tp = &twfartail;
+      }
+
+      if (*hp == aptr) {                  /* Element at head of slot; take it out     */
+         *hp = (ACTIVITY*)(aptr->next);
+         if (*tp == aptr) *tp = NULL;
+      }
+      else {                              /* Locate the element in the slot */
+         for (actptr = *hp;
+                actptr != NULL && actptr->next != (QE*)aptr;
+                actptr = (ACTIVITY*)(actptr->next));
+         if (actptr == NULL)              /* The element was not in the slot */
+            return 0;
+         actptr->next = aptr->next;
+         if (*tp == aptr) *tp = actptr;
+      }
+      aptr->next = NULL;
+      if (level == 0) tw0size--;
+      else if (level == 1) tw1size--;
+      twsize--;
+      if (lengthstat)                     /* Queue length statistics collected  */
+         StatrecUpdate(lengthstat,(double)twsize,1.0);
+      TRACE_EVLST_show;
+      return 1;
+   }
+
    else  /* Using simple linear search implementation for the event list */
    {
 
@@ -650,6 +925,29 @@ void YS__EventListPrint()    /* Lists the contents of the event list         */
       sprintf(YS__prbpkt,"\n");
       YS__SendPrbPkt(TEXTPROBE,"EventList",YS__prbpkt);
    }
+
+   else if (EventListType == TIMEWHEEL)  /* Using timing wheel for the event list */
+   {
+      sprintf(YS__prbpkt,"\n            EVENT LIST: Size = %d, Tick = %g\n",
+              twsize,1.0/TWRES);
+      YS__SendPrbPkt(TEXTPROBE,"EventList",YS__prbpkt);
+      for (i = 0; i <= 2*TWSLOTS; i++) {   /* Level 0, level 1, overflow    */
+         if (i < TWSLOTS) tp = tw0head[i];
+         else if (i < 2*TWSLOTS) tp = tw1head[i-TWSLOTS];
+         else tp = twfar;
+         if (tp == NULL) continue;
+         sprintf(YS__prbpkt,"                Slot %d:\n",i);
+         YS__SendPrbPkt(TEXTPROBE,"EventList",YS__prbpkt);
+         while (tp != NULL) {
+            sprintf(YS__prbpkt,"                    Time of activity %s[%d] is %g\n",
+                    tp->name, YS__QeId(tp),tp->time);
+            YS__SendPrbPkt(TEXTPROBE,"EventList",YS__prbpkt);
+            tp = (ACTIVITY*)(tp->next);
+         }
+      }
+      sprintf(YS__prbpkt,"\n");
+      YS__SendPrbPkt(TEXTPROBE,"EventList",YS__prbpkt);
+   }
    
    else  /* Using simple linear search implementation for the event list */
    {
@@ -682,12 +980,14 @@ int EventListSize()           /* Returns the number of elements in the eventlist
 {
    if (EventListType == CALQUE)    /* Calendar queue                         */
       return cqsize;
+   else if (EventListType == TIMEWHEEL)  /* Timing wheel                     */
+      return twsize;
    else                       /* Linear list                                 */
       return size;
 }
 
 void EventListSelect(type,bins,bwidth)  /* Selects the type of event list to use      */
-int type;                               /* CALQUE or LINQUE                  */
+int type;                               /* CALQUE, LINQUE or TIMEWHEEL       */
 int bins;                               /* Fix the number of bins            */
 double bwidth;                          /* Fix the width of the bins         */
 {
@@ -701,6 +1001,8 @@ double bwidth;                          /* Fix the width of the bins         */
       if (bwidth > 0.0) YS__EventListSetWidth(bwidth);  /* width automatic   */
       YS__EventListInit();
    }
+   else if (type == TIMEWHEEL)       /* bins and bwidth do not apply          */
+      YS__EventListInit();
 }
    
 void EventListCollectStats(type,meanflg,histflg,nbin,low,high)
@@ -0,0 +1,196 @@
+/*
+  hostprof.c
+
+  A profiler for the host time used by the simulator itself. Each
+  component in hostprof.h is charged the host time spent in it, not
+  counting components entered from it, so the times add up to the
+  elapsed time of the run. At each report the times are printed per
+  simulated cycle and per graduated instruction.
+
+  */
+/*****************************************************************************/
+/* This file is part of the RSIM Simulator.                                  */
+/*                                                                           */
+/******************************************************************************/
+/* University of Illinois/NCSA Open Source License                            */
+/*                                                                            */
+/* Copyright (c) 2002 The Board of Trustees of the University of Illinois and */
+/* William Marsh Rice University                                              */
+/*                                                                            */
+/* All rights reserved.                                                       */
+/*                                                                            */
+/* Developed by: Professor Sarita Adve's RSIM research group                  */
+/*               University of Illinois at Urbana-Champaign and William Marsh */
+/*                 Rice University                                            */
+/*               http://www.cs.uiuc.edu/rsim and                              */
+/*                 http://www.ece.rice.edu/~rsim/dist.html                    */
+/*                                                                            */
+/* Permission is hereby granted, free of charge, to any person obtaining a    */
+/* copy of this software and associated documentation files (the "Software"), */
+/* to deal with the Software without restriction, including without           */
+/* limitation the rights to use, copy, modify, merge, publish, distribute,    */
+/* sublicense, and/or sell copies of the Software, and to permit persons to   */
+/* whom the Software is furnished to do so, subject to the following          */
+/* conditions:                                                                */
+/*                                                                            */
+/*     * Redistributions of source code must retain the above copyright       */
+/* notice, this list of conditions and the following disclaimers.             */
+/*                                                                            */
+/*     * Redistributions in binary form must reproduce the above copyright    */
+/* notice, this list of conditions and the following disclaimers in the       */
+/* documentation and/or other materials provided with the distribution.       */
+/*                                                                            */
+/*     * Neither the names of Professor Sarita Adve's RSIM research group,    */
+/* the University of Illinois at Urbana-Champaign, William Marsh Rice         */
+/* University, nor the names of its contributors may be used to endorse or    */
+/* promote products derived from this Software without specific prior written */
+/* permission.                                                                */
+/*                                                                            */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    */
+/* THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR  */
+/* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,      */
+/* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR      */
+/* OTHER DEALINGS WITH THE SOFTWARE.                                          */
+/******************************************************************************/
+
+#include <sys/time.h>
+#include <time.h>
+#include "MemSys/simsys.h"
+#include "MemSys/net.h"
+#include "MemSys/bus.h"
+#include "MemSys/directory.h"
+#include "MemSys/hostprof.h"
+
+int HostProf = 0;
+
+#define HP_DEPTH 32                         /* maximum nesting           */
+
+static char *HostProfNames[HP_NUM] = {
+   "other", "RSIM_EVENT", "maindecode", "complete", "IssueQueues",
+   "L1CacheInSim", "L1CacheOutSim", "L2CacheInSim", "L2CacheOutSim",
+   "DirSim", "bus", "network", "event list"
+};
+
+static double HostProfTime[HP_NUM];         /* ns charged since report   */
+static int    HostProfStack[HP_DEPTH];      /* components being timed    */
+static int    HostProfTop = 0;              /* HostProfStack[0] is OTHER */
+static double HostProfMark = -1.0;          /* time of the last change   */
+static double HostProfLastCycle = 0.0;      /* values at the last report */
+static double HostProfLastGrads = 0.0;
+
+extern void YS__HeadEvent();
+extern void YS__TailEvent();
+extern void RSIM_EVENT();
+
+/*****************************************************************************/
+/* HostProfNow: host time in nanoseconds                                     */
+/*****************************************************************************/
+
+static double HostProfNow()
+{
+#ifdef CLOCK_MONOTONIC
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC,&ts);
+   return (double)ts.tv_sec*1e9 + (double)ts.tv_nsec;
+#else
+   struct timeval tv;
+   gettimeofday(&tv,NULL);
+   return (double)tv.tv_sec*1e9 + (double)tv.tv_usec*1e3;
+#endif
+}
+
+/*****************************************************************************/
+/* HostProfCharge: charge the time since the last change to the component    */
+/* on top of the stack                                                       */
+/*****************************************************************************/
+
+static void HostProfCharge()
+{
+   double now = HostProfNow();
+
+   if (HostProfMark >= 0.0)
+      HostProfTime[HostProfStack[HostProfTop]] += now - HostProfMark;
+   HostProfMark = now;
+}
+
+/*****************************************************************************/
+
+void HostProfBegin(c)
+int c;
+{
+   HostProfCharge();
+   if (HostProfTop == HP_DEPTH-1)
+      YS__errmsg("HostProfBegin(): components nested too deeply");
+   HostProfStack[++HostProfTop] = c;
+}
+
+/*****************************************************************************/
+
+void HostProfEnd()
+{
+   HostProfCharge();
+   if (HostProfTop == 0)
+      YS__errmsg("HostProfEnd(): no component to end");
+   HostProfTop--;
+}
+
+/*****************************************************************************/
+/* HostProfEventClass: the component a YACSIM event body is charged to       */
+/*****************************************************************************/
+
+int HostProfEventClass(body)
+void (*body)();
+{
+   if (body == DirSim)
+      return HP_DIR;
+   if (body == node_bus)
+      return HP_BUS;
+   if (body == SmnetSend || body == ReqSendSemaWait || body == ReplySendSemaWait ||
+       body == ReqRcvSemaWait || body == ReplyRcvSemaWait ||
+       body == YS__HeadEvent || body == YS__TailEvent ||
+       body == YS__PktNetEvent)
+      return HP_NET;
+   if (body == RSIM_EVENT)
+      return HP_RSIM;
+   return HP_OTHER;
+}
+
+/*****************************************************************************/
+/* HostProfReport: print the time charged to each component since the last  */
+/* report, per simulated cycle and per graduated instruction, given the      */
+/* current cycle and total instructions graduated by all processors          */
+/*****************************************************************************/
+
+void HostProfReport(out, cycle, grads)
+FILE *out;
+double cycle;
+double grads;
+{
+   double total = 0.0, cycles, insts;
+   int i;
+
+   HostProfCharge();
+   cycles = cycle - HostProfLastCycle;
+   insts = grads - HostProfLastGrads;
+   for (i = 0; i < HP_NUM; i++)
+      total += HostProfTime[i];
+
+   fprintf(out,"\nHOST TIME PROFILE (%.0f cycles, %.0f graduated instructions)\n",
+           cycles, insts);
+   fprintf(out,"%-16s %12s %10s %12s %7s\n","Component","host ms",
+           "ns/cycle","ns/inst","share");
+   for (i = 0; i < HP_NUM; i++) {
+      fprintf(out,"%-16s %12.1f %10.1f %12.1f %6.1f%%\n",HostProfNames[i],
+              HostProfTime[i]/1e6,
+              cycles > 0.0 ? HostProfTime[i]/cycles : 0.0,
+              insts > 0.0 ? HostProfTime[i]/insts : 0.0,
+              total > 0.0 ? 100.0*HostProfTime[i]/total : 0.0);
+      HostProfTime[i] = 0.0;
+   }
+   fprintf(out,"%-16s %12.1f %10.1f %12.1f\n\n","Total",total/1e6,
+           cycles > 0.0 ? total/cycles : 0.0, insts > 0.0 ? total/insts : 0.0);
+   HostProfLastCycle = cycle;
+   HostProfLastGrads = grads;
+}
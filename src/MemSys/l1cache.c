@@ -271,7 +271,7 @@ static int L1ProcessTagReq(CACHE *captr, REQ *req)
   int  hittype, type, data_type, reply;
   int req_sz, rep_sz, nxt_req_sz;
   long tag, address;
-  int set, set_ind, i1, i2;
+  int set, set_ind;
   int cohe_type, allo_type, allocate,  dest_node;
   int hittype_pres_mshr;
   CacheLineState cur_state, nxt_st, dummy3;
@@ -306,8 +306,6 @@ static int L1ProcessTagReq(CACHE *captr, REQ *req)
 	  
 #ifdef DEBUG_PRIMARY
 	  hittype = notpres(address,&tag,&set,&set_ind,captr);
-	  i1 = set_ind / SUB_SZ;
-	  i2 = set_ind % SUB_SZ;
 	  
 	  if (DEBUG_TIME < YS__Simtime)
 	    {
@@ -583,8 +581,6 @@ static int L1ProcessTagReq(CACHE *captr, REQ *req)
 #endif
 	  reply = req->s.reply; /* what type of reply is it? */
 	  hittype = notpres(address,&tag,&set,&set_ind,captr); /* is it in cache already? */
-	  i1 = set_ind / SUB_SZ;
-	  i2 = set_ind % SUB_SZ;
 	  
 #ifdef DEBUG_PRIMARY
 	  if (DEBUG_TIME < YS__Simtime)
@@ -644,7 +640,7 @@ static int L1ProcessTagReq(CACHE *captr, REQ *req)
 		  cache_get_cohe_type (captr, hittype, set_ind, address, &cohe_type,
 				       &allo_type, &dest_node);
 
-		  cur_state = captr->data[i1][i2].state.st; /* current state of line */
+		  cur_state = captr->data[set_ind].state.st; /* current state of line */
 		  captr->cohe_rtn(REPLY, cur_state, allo_type, req->req_type,
 				  cohe_type, req->dubref,  &nxt_st, &nxt_mod_req,
 				  &req_sz, &rep_sz, &nxt_req, &nxt_req_sz, &allocate); /* call coherence routing (cohe_pr) */
@@ -663,10 +659,10 @@ static int L1ProcessTagReq(CACHE *captr, REQ *req)
 		  req->invl_req=req->wrb_req=NULL; /* nothing was victimized
 						      by this REPLY */
 
-		  captr->data[i1][i2].state.st = nxt_st; /* next state */
+		  captr->data[set_ind].state.st = nxt_st; /* next state */
 		  cur_state = nxt_st; /* Now set that as cur_state for
 					 possible use later on */
-		  captr->data[i1][i2].state.mshr_out = 0; /* mshr_out is there for upgrades */
+		  captr->data[set_ind].state.mshr_out = 0; /* mshr_out is there for upgrades */
 		  if (pend_cohe) 
 		    {
 		      /* call the cohe function (cohe_pr) in order to find
@@ -675,8 +671,8 @@ static int L1ProcessTagReq(CACHE *captr, REQ *req)
 		      captr->cohe_rtn(COHE, cur_state, allo_type, pend_cohe,
 				      cohe_type, 0,  &nxt_st, &dummy2,
 				      &dummy, &dummy, &dummy2, &dummy, &dummy);
-		      captr->data[i1][i2].state.st = nxt_st; /* set state */
-		      if (captr->data[i1][i2].state.mshr_out)
+		      captr->data[set_ind].state.st = nxt_st; /* set state */
+		      if (captr->data[set_ind].state.mshr_out)
 			{
 			  YS__errmsg("should not be evicting a line with mshr_out.\n");
 			}
@@ -731,8 +727,6 @@ static int L1ProcessTagReq(CACHE *captr, REQ *req)
 			  return 1; /* don't stall regardless -- sink the REPLY */			  
 			}
 			
-		      i1 = set_ind/SUB_SZ;
-		      i2 = set_ind%SUB_SZ;
 
 		      /* if we're here, we're bringing a line into the
 			 cache, so we should determine COLD/CAP/CONF */
@@ -773,22 +767,22 @@ static int L1ProcessTagReq(CACHE *captr, REQ *req)
 		    }
 
 		  req->invl_req=req->wrb_req=NULL; /* by default */
-		  if (captr->data[i1][i2].state.st == INVALID)
+		  if (captr->data[set_ind].state.st == INVALID)
 		    {
 		      /* if victim tag is invalid, use the line without
 			 doing any replacement */
-		      if (captr->data[i1][i2].state.mshr_out)
+		      if (captr->data[set_ind].state.mshr_out)
 			{
 			  YS__errmsg("should not be replacing line with mshr_out!!!\n");
 			}
 
 		      /* Now fill in the information for the new line being
 			 brought in */
-		      captr->data[i1][i2].tag = tag; /* fill in new tag */
-		      captr->data[i1][i2].state.st = nxt_st; /* Change state */
-		      captr->data[i1][i2].state.cohe_type = cohe_type;
-		      captr->data[i1][i2].state.allo_type = allo_type;
-		      captr->data[i1][i2].dest_node = dest_node;
+		      captr->tags[set_ind] = tag; /* fill in new tag */
+		      captr->data[set_ind].state.st = nxt_st; /* Change state */
+		      captr->data[set_ind].state.cohe_type = cohe_type;
+		      captr->data[set_ind].state.allo_type = allo_type;
+		      captr->data[set_ind].dest_node = dest_node;
 		      cur_state = nxt_st; /* set this for later use */
 		      if (pend_cohe)
 			{
@@ -799,7 +793,7 @@ static int L1ProcessTagReq(CACHE *captr, REQ *req)
 			  captr->cohe_rtn(COHE, cur_state, allo_type, pend_cohe,
 					  cohe_type, 0,  &nxt_st, &dummy2,
 					  &dummy, &dummy, &dummy2, &dummy, &dummy);
-			  captr->data[i1][i2].state.st = nxt_st; /* set new state */
+			  captr->data[set_ind].state.st = nxt_st; /* set new state */
 #ifdef DEBUG_PRIMARY
 			  
 			  if (DEBUG_TIME < YS__Simtime)
@@ -815,10 +809,10 @@ static int L1ProcessTagReq(CACHE *captr, REQ *req)
 			 dest_node, cur_state, and tag of the line being
 			 replaced */
 		   
-		      cohe_type_repl = captr->data[i1][i2].state.cohe_type;
-		      allo_type_repl = captr->data[i1][i2].state.allo_type;  
-		      dest_node_repl = captr->data[i1][i2].dest_node;
-		      cur_state = captr->data[i1][i2].state.st;
+		      cohe_type_repl = captr->data[set_ind].state.cohe_type;
+		      allo_type_repl = captr->data[set_ind].state.allo_type;  
+		      dest_node_repl = captr->data[set_ind].dest_node;
+		      cur_state = captr->data[set_ind].state.st;
 		      if (cur_state == SH_CL)
 			captr->stat.shcl_victims++;
 		      else if (cur_state == PR_CL)
@@ -828,25 +822,25 @@ static int L1ProcessTagReq(CACHE *captr, REQ *req)
 
 		      /* Determine if replacement needs to go to next
 			 module, etc. by calling cohe_rtn (cohe_pr) */
-		      captr->cohe_rtn(REQUEST, captr->data[i1][i2].state.st, allo_type_repl,
+		      captr->cohe_rtn(REQUEST, captr->data[set_ind].state.st, allo_type_repl,
 				      REPL, cohe_type_repl, 0,  &dummy3, &blw_req_type,
 				      &req_sz_blw, &rep_sz_blw, &abv_req_type, &req_sz_abv,
 				      &rep_sz_abv);
 		      
 		      /* tag of replaced line */
-		      tag_repl = (captr->data[i1][i2].tag << captr->set_bits) | set ;
+		      tag_repl = (captr->tags[set_ind] << captr->set_bits) | set ;
 
 		      /* the fact that we've found something to replace
 			 indicates that it doesn't have an mshr_out */
 
 		      /* Set tags and states to reflect new line */
-		      captr->data[i1][i2].tag = tag; 
-		      captr->data[i1][i2].state.cohe_type = cohe_type;
-		      captr->data[i1][i2].state.allo_type = allo_type;
-		      captr->data[i1][i2].dest_node = dest_node;
-		      captr->data[i1][i2].state.st = nxt_st;
+		      captr->tags[set_ind] = tag; 
+		      captr->data[set_ind].state.cohe_type = cohe_type;
+		      captr->data[set_ind].state.allo_type = allo_type;
+		      captr->data[set_ind].dest_node = dest_node;
+		      captr->data[set_ind].state.st = nxt_st;
 		      cur_state = nxt_st; /* set this field for later use */
-		      if (captr->data[i1][i2].state.mshr_out)
+		      if (captr->data[set_ind].state.mshr_out)
 			{
 			  YS__errmsg("line shouldn't have mshr_out in replacement case\n");
 			}
@@ -890,8 +884,8 @@ static int L1ProcessTagReq(CACHE *captr, REQ *req)
 			  captr->cohe_rtn(COHE, cur_state, allo_type, pend_cohe,
 					  cohe_type, 0,  &nxt_st, &dummy2,
 					  &dummy, &dummy, &dummy2, &dummy, &dummy);
-			  captr->data[i1][i2].state.st = nxt_st; /* set new state */
-			  if (captr->data[i1][i2].state.mshr_out)
+			  captr->data[set_ind].state.st = nxt_st; /* set new state */
+			  if (captr->data[set_ind].state.mshr_out)
 			    {
 			      YS__errmsg("shouldn't be replacing  line with mshr_out\n");
 			    }
@@ -990,8 +984,6 @@ static int L1ProcessTagReq(CACHE *captr, REQ *req)
 	 req->size_req = REQ_SZ;
 	 
 	 hittype = notpres(address,&tag,&set,&set_ind,captr); /* is line present in cache? */
-	 i1= set_ind / SUB_SZ;
-	 i2 = set_ind % SUB_SZ;
 	 hittype_pres_mshr = notpres_mshr(captr,req); /* does line match an outstanding MSHR? */
 	 
 #ifdef DEBUG_PRIMARY
@@ -1120,8 +1112,8 @@ static int L1ProcessTagReq(CACHE *captr, REQ *req)
 		
 		if (hittype == 0) /* a hit */
 		  {		     
-		    captr->data[i1][i2].state.st = INVALID;
-		    captr->data[i1][i2].state.mshr_out = 0;
+		    captr->data[set_ind].state.st = INVALID;
+		    captr->data[set_ind].state.mshr_out = 0;
 		    captr->stat.cohe_reply_nack_docohe++;
 #ifdef DEBUG_PRIMARY
 		    if (DEBUG_TIME < YS__Simtime)
@@ -1173,7 +1165,7 @@ static int L1ProcessTagReq(CACHE *captr, REQ *req)
 		if (Speculative_Loads) /* this is an invalidation */
 		  SpecLoadBufCohe(captr->node_num,req->tag, SLB_Repl);
 
-		cur_state = captr->data[i1][i2].state.st;
+		cur_state = captr->data[set_ind].state.st;
 		if (cur_state != PR_DY)
 		  {
 		    /* NACK this, this means that we have the line, but we
@@ -1183,15 +1175,15 @@ static int L1ProcessTagReq(CACHE *captr, REQ *req)
 		      fprintf(simout,"8L1: %s nacking a WRB to a clean for tag %ld\n",captr->name,req->tag);
 #endif
 		    req->s.reply = NACK;
-		    captr->data[i1][i2].state.st = INVALID;
-		    if (captr->data[i1][i2].pref)
+		    captr->data[set_ind].state.st = INVALID;
+		    if (captr->prefs[set_ind].pref)
 		      {
 			captr->stat.pref_useless_cohe++;
-			captr->data[i1][i2].pref = 0;
-			captr->data[i1][i2].pref_tag_repl = -1;
+			captr->prefs[set_ind].pref = 0;
+			captr->prefs[set_ind].pref_tag_repl = -1;
 		      }
 		    captr->stat.cohe_reply_nack++;
-		    if (captr->data[i1][i2].state.mshr_out)
+		    if (captr->data[set_ind].state.mshr_out)
 		      {
 			YS__errmsg("coherence interfering with  line that has  mshr_out!!!\n");
 		      }
@@ -1206,14 +1198,14 @@ static int L1ProcessTagReq(CACHE *captr, REQ *req)
 		    req->s.reply = REPLY;
 		    req->size_st = LINESZ + REQ_SZ; /* send down a full line */
 		    req->size_req = LINESZ + REQ_SZ;		     
-		    captr->data[i1][i2].state.st = INVALID; /* set new state */
-		    if (captr->data[i1][i2].pref)
+		    captr->data[set_ind].state.st = INVALID; /* set new state */
+		    if (captr->prefs[set_ind].pref)
 		      {
 			captr->stat.pref_useless++; /* count this as a replacement, rather than a cohe */
-			captr->data[i1][i2].pref = 0;
-			captr->data[i1][i2].pref_tag_repl = -1;
+			captr->prefs[set_ind].pref = 0;
+			captr->prefs[set_ind].pref_tag_repl = -1;
 		      }
-		    if (captr->data[i1][i2].state.mshr_out)
+		    if (captr->data[set_ind].state.mshr_out)
 		      {
 			YS__errmsg("coherence interfering with line with mshr_out!!!\n");
 		      }
@@ -1224,8 +1216,8 @@ static int L1ProcessTagReq(CACHE *captr, REQ *req)
 		req->s.reply = REPLY; /* positive acknowledgment */
 		
 		/* here's where we need to change the state also */
-		cohe_type = captr->data[i1][i2].state.cohe_type;
-		cur_state = captr->data[i1][i2].state.st;
+		cohe_type = captr->data[set_ind].state.cohe_type;
+		cur_state = captr->data[set_ind].state.st;
 
 		/* Call coherence routine (cohe_pr) to set up nxt_state,
 		   determine other needed actions, etc. */
@@ -1235,20 +1227,20 @@ static int L1ProcessTagReq(CACHE *captr, REQ *req)
 				&nxt_req_sz,
 				&allocate);
 		 
-		captr->data[i1][i2].state.st = nxt_st; /* set new state */
+		captr->data[set_ind].state.st = nxt_st; /* set new state */
 
-		if (captr->data[i1][i2].state.mshr_out)
+		if (captr->data[set_ind].state.mshr_out)
 		  {
 		    YS__errmsg("Coherence transaction to line with mshr_out!!!\n");
 		  }
 		 
-		if (captr->data[i1][i2].pref && nxt_st == INVALID)
+		if (captr->prefs[set_ind].pref && nxt_st == INVALID)
 		  {
 		    captr->stat.pref_useless_cohe++;
-		    captr->data[i1][i2].pref = 0;
-		    captr->data[i1][i2].pref_tag_repl = -1;
+		    captr->prefs[set_ind].pref = 0;
+		    captr->prefs[set_ind].pref_tag_repl = -1;
 		  }
-		if (captr->data[i1][i2].pref && (cur_state == PR_DY  || cur_state == PR_CL) && (nxt_st == SH_CL))
+		if (captr->prefs[set_ind].pref && (cur_state == PR_DY  || cur_state == PR_CL) && (nxt_st == SH_CL))
 		  {
 		    captr->stat.pref_downgraded++;
 		  }
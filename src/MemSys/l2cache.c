@@ -480,7 +480,7 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
   int i, hittype, type, data_type, reply;
   int req_sz, rep_sz, nxt_req_sz;
   long tag, address;
-  int set, set_ind, i1, i2;
+  int set, set_ind;
   int cohe_type, allo_type, allocate,  dest_node;
   int hittype_pres_mshr, temp;
   ReqType nxt_mod_req,nxt_req ;
@@ -542,8 +542,6 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 	     appropriate REPLY types (REPLY_EXCL or REPLY_SH) to L1
 	     cache */
 	  hittype = notpres(address,&tag,&set,&set_ind,captr);
-	  i1 = set_ind / SUB_SZ;
-	  i2 = set_ind % SUB_SZ;
 	  hittype_pres_mshr = notpres_mshr(captr,req);
 	  
 #ifdef DEBUG_SECONDARY
@@ -669,7 +667,7 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 		 sent to L1 cache */
 	      if (AddToPipe(captr->pipe[L2ReqDATAPIPE(req)],req) == 0)
 		{
-		  if (captr->data[i1][i2].state.st == PR_CL || captr->data[i1][i2].state.st == PR_DY)
+		  if (captr->data[set_ind].state.st == PR_CL || captr->data[set_ind].state.st == PR_DY)
 		    req->req_type = REPLY_EXCL; /* L1 caches need to handle
 						   REPLY_EXCL as REPLY_UPGRADE
 						   also, since REQUESTs aren't
@@ -727,8 +725,6 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
       
 	  reply = req->s.reply;
 	  hittype = notpres(address,&tag,&set,&set_ind,captr);
-	  i1 = set_ind / SUB_SZ;
-	  i2 = set_ind % SUB_SZ;
 	  
 #ifdef DEBUG_SECONDARY
 	  if (DEBUG_TIME < YS__Simtime)
@@ -819,7 +815,7 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 		{
 		  cache_get_cohe_type (captr, hittype, set_ind, address, &cohe_type,
 				       &allo_type, &dest_node);
-		  cur_state = captr->data[i1][i2].state.st;
+		  cur_state = captr->data[set_ind].state.st;
 		  captr->cohe_rtn(REPLY, cur_state, allo_type, req->req_type,
 				  cohe_type, req->dubref, &nxt_st, &nxt_mod_req,
 				  &req_sz, &rep_sz, &nxt_req, &nxt_req_sz, &allocate);
@@ -847,9 +843,9 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 		    fprintf(simout,"%s wrb_buf size now %d -- line %d\n",captr->name,captr->wrb_buf_used, __LINE__);
 #endif
 
-		  captr->data[i1][i2].state.st = nxt_st;
+		  captr->data[set_ind].state.st = nxt_st;
 		  cur_state = nxt_st;
-		  captr->data[i1][i2].state.mshr_out = 0;
+		  captr->data[set_ind].state.mshr_out = 0;
 
 		  if (pend_cohe)
 		    {
@@ -878,8 +874,8 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 					  pend_cohe,cohe_type, 0,  &nxt_st,
 					  &dummy2,&dummy, &dummy,
 					  &dummy2, &dummy, &dummy);
-			  captr->data[i1][i2].state.st = nxt_st;
-			  if (captr->data[i1][i2].state.mshr_out)
+			  captr->data[set_ind].state.st = nxt_st;
+			  if (captr->data[set_ind].state.mshr_out)
 			    {
 			      YS__errmsg("replacing line with mshr_out.\n");
 			    }
@@ -940,8 +936,6 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 			  return 1;
 			}
 			
-	 	      i1 = set_ind/SUB_SZ;
-		      i2 = set_ind%SUB_SZ;
 		  
 		      ccdres = CCD_InsertNewCacheLine(captr->ccd,req->tag);
 
@@ -971,23 +965,23 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 		    }
 
 		  req->invl_req=req->wrb_req=NULL; /* by default */
-		  captr->data[i1][i2].state.cohe_pend=0; /* clear this bit for the new line */
-		  if (captr->data[i1][i2].state.st == INVALID)
+		  captr->data[set_ind].state.cohe_pend=0; /* clear this bit for the new line */
+		  if (captr->data[set_ind].state.st == INVALID)
 		    {
-		      if (captr->data[i1][i2].state.mshr_out)
+		      if (captr->data[set_ind].state.mshr_out)
 			{
 			  YS__errmsg("replacing line with mshr_out.\n");
 			}
 		      /* if victim tag is invalid, use the line */
-		      if (captr->data[i1][i2].state.mshr_out)
+		      if (captr->data[set_ind].state.mshr_out)
 			{
 			  YS__errmsg("replacing line with mshr_out.\n");
 			}
-		      captr->data[i1][i2].tag = tag; /* put in the new tag */
-		      captr->data[i1][i2].state.st = nxt_st; /* Change state */
-		      captr->data[i1][i2].state.cohe_type = cohe_type;
-		      captr->data[i1][i2].state.allo_type = allo_type;
-		      captr->data[i1][i2].dest_node = dest_node;
+		      captr->tags[set_ind] = tag; /* put in the new tag */
+		      captr->data[set_ind].state.st = nxt_st; /* Change state */
+		      captr->data[set_ind].state.cohe_type = cohe_type;
+		      captr->data[set_ind].state.allo_type = allo_type;
+		      captr->data[set_ind].dest_node = dest_node;
 		      cur_state = nxt_st;
 		      if (pend_cohe)
 			{
@@ -1016,7 +1010,7 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 			      captr->cohe_rtn(COHE, cur_state, allo_type, pend_cohe,
 					      cohe_type, 0, &nxt_st, &dummy2,
 					      &dummy, &dummy, &dummy2, &dummy, &dummy);
-			      captr->data[i1][i2].state.st = nxt_st;
+			      captr->data[set_ind].state.st = nxt_st;
 #ifdef DEBUG_SECONDARY
 			      
 			      if (DEBUG_TIME < YS__Simtime)
@@ -1043,11 +1037,11 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 		    {
 		      /* In this case, some sort of replacement is needed */
 		      /* Gather all information about line being replaced */
-		      cohe_type_repl = captr->data[i1][i2].state.cohe_type;
-		      allo_type_repl = captr->data[i1][i2].state.allo_type;  
-		      dest_node_repl = captr->data[i1][i2].dest_node;
-		      tag_repl = (captr->data[i1][i2].tag << captr->set_bits) | set ;
-		      cur_state = captr->data[i1][i2].state.st;
+		      cohe_type_repl = captr->data[set_ind].state.cohe_type;
+		      allo_type_repl = captr->data[set_ind].state.allo_type;  
+		      dest_node_repl = captr->data[set_ind].dest_node;
+		      tag_repl = (captr->tags[set_ind] << captr->set_bits) | set ;
+		      cur_state = captr->data[set_ind].state.st;
 		      if (cur_state == SH_CL)
 			captr->stat.shcl_victims++;
 		      else if (cur_state == PR_CL)
@@ -1057,23 +1051,23 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 #ifdef DEBUG_SECONDARY
 		      if(YS__Simtime > DEBUG_TIME)
 			fprintf(simout, "5L2: REPL %s Tag:%ld (%ld) in state %s at %g\n",
-				captr->name, tag_repl, captr->data[i1][i2].tag,
-				State[captr->data[i1][i2].state.st], YS__Simtime);
+				captr->name, tag_repl, captr->tags[set_ind],
+				State[captr->data[set_ind].state.st], YS__Simtime);
 #endif
 		      /* Determine if replaced needs to go to next module etc
 			 by calling cohe_rtn (cohe_sl) */
-		      captr->cohe_rtn(REQUEST, captr->data[i1][i2].state.st, allo_type_repl,
+		      captr->cohe_rtn(REQUEST, captr->data[set_ind].state.st, allo_type_repl,
 				      REPL, cohe_type_repl, 0, &dummy3, &blw_req_type,
 				      &req_sz_blw, &rep_sz_blw, &abv_req_type, &req_sz_abv,
 				      &rep_sz_abv);
 		      
 		      /* Set tags and states to reflect new line */
-		      captr->data[i1][i2].tag = tag; 
-		      captr->data[i1][i2].state.cohe_type = cohe_type;
-		      captr->data[i1][i2].state.allo_type = allo_type;
-		      captr->data[i1][i2].dest_node = dest_node;
-		      captr->data[i1][i2].state.st = nxt_st;
-		      if (captr->data[i1][i2].state.mshr_out)
+		      captr->tags[set_ind] = tag; 
+		      captr->data[set_ind].state.cohe_type = cohe_type;
+		      captr->data[set_ind].state.allo_type = allo_type;
+		      captr->data[set_ind].dest_node = dest_node;
+		      captr->data[set_ind].state.st = nxt_st;
+		      if (captr->data[set_ind].state.mshr_out)
 			{
 			  YS__errmsg("replacing line with mshr_out!!!\n");
 			}
@@ -1272,8 +1266,8 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 			      captr->cohe_rtn(COHE, cur_state, allo_type, pend_cohe,
 					      cohe_type, 0, &nxt_st, &dummy2,
 					      &dummy, &dummy, &dummy2, &dummy, &dummy);
-			      captr->data[i1][i2].state.st = nxt_st;
-			      if (captr->data[i1][i2].state.mshr_out)
+			      captr->data[set_ind].state.st = nxt_st;
+			      if (captr->data[set_ind].state.mshr_out)
 				{
 				  YS__errmsg("replacing line with mshr_out.\n");
 				}
@@ -1451,8 +1445,6 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
      if (req->progress == 0)
        {
 	 hittype = notpres(address,&tag,&set,&set_ind,captr);
-	 i1= set_ind / SUB_SZ;
-	 i2 = set_ind % SUB_SZ;
 	 hittype_pres_mshr = notpres_mshr(captr,req);
 
 	 captr->stat.cohe++;
@@ -1472,7 +1464,7 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 		from this line between now and the actual action, as
 		that could easily lead to problems such as inclusion
 		failures. So, cache sets a cohe_pend bit on the line */
-	     if (captr->data[i1][i2].state.cohe_pend) /* If cohe_pend already set. */
+	     if (captr->data[set_ind].state.cohe_pend) /* If cohe_pend already set. */
 	       {
 #ifdef DEBUG_SECONDARY
 		 if (YS__Simtime > DEBUG_TIME)
@@ -1487,7 +1479,7 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 		 if (YS__Simtime > DEBUG_TIME)
 		   fprintf(simout,"Cache %s marking tag %ld with cohe_pend @%.1f",captr->name,req->tag,YS__Simtime);
 #endif
-		 captr->data[i1][i2].state.cohe_pend=1;
+		 captr->data[set_ind].state.cohe_pend=1;
 	       }
 	   }
 
@@ -1553,12 +1545,10 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 
 	  /* but first be sure to unset the cohe_pend bit! */
 	  hittype = notpres(address,&tag,&set,&set_ind,captr);
-	  i1= set_ind / SUB_SZ;
-	  i2 = set_ind % SUB_SZ;
 
-	  if (hittype == 0 && captr->data[i1][i2].state.cohe_pend)
+	  if (hittype == 0 && captr->data[set_ind].state.cohe_pend)
 	    {
-	      captr->data[i1][i2].state.cohe_pend=0;
+	      captr->data[set_ind].state.cohe_pend=0;
 #ifdef DEBUG_SECONDARY
 	      if (YS__Simtime > DEBUG_TIME)
 		fprintf(simout,"Cache %s unmarking cohe_pend on tag %ld on NACK_PEND propogated @%.1f\n",captr->name,req->tag,YS__Simtime);
@@ -1583,8 +1573,6 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 	 captr->stat.cohe_reply++;
 
 	 hittype = notpres(address,&tag,&set,&set_ind,captr);
-	 i1= set_ind / SUB_SZ;
-	 i2 = set_ind % SUB_SZ;
 	 hittype_pres_mshr = notpres_mshr(captr,req);
 
 
@@ -1599,9 +1587,9 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 #endif
 
 	 /* NOTE: unmark cohe_pend for COHE_REPLY */
-	  if (hittype == 0 && captr->data[i1][i2].state.cohe_pend)
+	  if (hittype == 0 && captr->data[set_ind].state.cohe_pend)
 	    {
-	      captr->data[i1][i2].state.cohe_pend=0;
+	      captr->data[set_ind].state.cohe_pend=0;
 #ifdef DEBUG_SECONDARY
 	      if (YS__Simtime > DEBUG_TIME)
 		fprintf(simout,"Cache %s unmarking cohe_pend on tag %ld on COHE_REPLY @%.1f\n",captr->name,req->tag,YS__Simtime);
@@ -1683,13 +1671,13 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 		   YS__errmsg("COPYBACK message not valid in this case\n");
 		 }
 		 captr->stat.cohe_reply_nack_docohe++;
-		 captr->data[i1][i2].state.st = INVALID;
-		 captr->data[i1][i2].state.mshr_out = 0;
+		 captr->data[set_ind].state.st = INVALID;
+		 captr->data[set_ind].state.mshr_out = 0;
 #ifdef DEBUG_SECONDARY
 		 if (DEBUG_TIME < YS__Simtime)
 		   fprintf(simout,"L2: Forcing MSHR_out to be 0 for tag %ld at time %f\n",req->tag,YS__Simtime);
 #endif
-		 if (captr->data[i1][i2].pref)
+		 if (captr->prefs[set_ind].pref)
 		   {
 #ifdef DEBUG_SECONDARY
 		     if (DEBUG_TIME < YS__Simtime)
@@ -1698,8 +1686,8 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 		       }
 #endif
 		     captr->stat.pref_useless_cohe++;
-		     captr->data[i1][i2].pref = 0;
-		     captr->data[i1][i2].pref_tag_repl = -1;
+		     captr->prefs[set_ind].pref = 0;
+		     captr->prefs[set_ind].pref_tag_repl = -1;
 		   }
 	       }
 	     req->progress = 8;
@@ -1925,8 +1913,8 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 	       {
 		 if (req->forward_to != -1)
 		   captr->stat.cohe_cache_to_cache_good++;
-		 cohe_type = captr->data[i1][i2].state.cohe_type;
-		 cur_state = captr->data[i1][i2].state.st;
+		 cohe_type = captr->data[set_ind].state.cohe_type;
+		 cur_state = captr->data[set_ind].state.st;
 
 		 if (req->req_type != WRB) /* external COHE transaction */
 		   {
@@ -1939,7 +1927,7 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 		       {
 			 cur_state = PR_DY; 
 			 nxt_st = PR_DY;
-			 captr->data[i1][i2].state.st = nxt_st;
+			 captr->data[set_ind].state.st = nxt_st;
 		       }
 
 		     /* Call cohe_rtn (cohe_sl) to determine nxt_st,
@@ -1950,9 +1938,9 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 				     &nxt_req_sz,
 				     &allocate);
 		     
-		     captr->data[i1][i2].state.st = nxt_st;
+		     captr->data[set_ind].state.st = nxt_st;
 		     
-		     if (nxt_st == INVALID && captr->data[i1][i2].pref)
+		     if (nxt_st == INVALID && captr->prefs[set_ind].pref)
 		       {
 #ifdef DEBUG_SECONDARY
 			 if (DEBUG_TIME < YS__Simtime)
@@ -1961,10 +1949,10 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 			   }
 #endif
 			 captr->stat.pref_useless_cohe++;
-			 captr->data[i1][i2].pref = 0;
-			 captr->data[i1][i2].pref_tag_repl = -1;
+			 captr->prefs[set_ind].pref = 0;
+			 captr->prefs[set_ind].pref_tag_repl = -1;
 		       }
-		     if (captr->data[i1][i2].pref && (cur_state == PR_DY || cur_state == PR_CL) && (nxt_st == SH_CL))
+		     if (captr->prefs[set_ind].pref && (cur_state == PR_DY || cur_state == PR_CL) && (nxt_st == SH_CL))
 		       {
 #ifdef DEBUG_SECONDARY
 			 if (DEBUG_TIME < YS__Simtime)
@@ -1974,7 +1962,7 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 #endif
 			 captr->stat.pref_downgraded++;
 		       }
-		     if (captr->data[i1][i2].state.mshr_out)
+		     if (captr->data[set_ind].state.mshr_out)
 		       {
 			 YS__errmsg("coherence transaction to a line with mshr_out!!!\n");
 		       }
@@ -1985,7 +1973,7 @@ int L2ProcessTagReq(CACHE *captr, REQ *req)
 		       {
 			 cur_state = PR_DY;
 			 nxt_st = PR_DY;
-			 captr->data[i1][i2].state.st = nxt_st;
+			 captr->data[set_ind].state.st = nxt_st;
 		       }
 		     else if (cur_state != PR_DY)
 		       YS__errmsg("L1 WRB received to bad line\n");
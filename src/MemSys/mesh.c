@@ -80,6 +80,13 @@
   
   The routing function is called MeshRoute() and is defined in this file.
   The only new changes are renaming the function, and the removal of b_thresh.
+
+  Two adaptive routing functions for 2-dimensional meshes may be passed
+  instead: MeshWestFirstRoute() and MeshOddEvenRoute(). Both are minimal
+  and follow a turn model, so they stay deadlock free without virtual
+  channels. Among the productive outputs the turn model allows, they
+  pick the one whose downstream buffer has the most free flits.
+  Dimension 0 is the x ("east-west") dimension; direction 1 is east.
   
   ****************************************************************************/
 
@@ -102,8 +109,9 @@ void CreateComponent ();
 void ConnectComponents ();
 void NodeIntraConnect ();
 static int MyRoute(int *src, int *dest, int id);
-IPORT *cpu_iport[256];
-OPORT *cpu_oport[256];
+static int MeshExitIndex(int id, int dim, int dir);
+IPORT **cpu_iport;	/* message-passing ports of the reply network */
+OPORT **cpu_oport;
 
 FILE *fp;
 int 	end_node, buf_size, port_size, (*router)();
@@ -114,6 +122,9 @@ static int	num_nodes, incr, *mesh_size, actual_dim, log_dim;
 int meshnum;
 MODULE	**table;
 
+int NetRouting = DOR_ROUTING;	/* which routing function CreateMESH gets */
+char *NetRoutingName[] = {"dimension-order", "west-first", "odd-even"};
+
 int mesh_first = 0;
 
 static int MyLog2 (dim)
@@ -128,24 +139,22 @@ static int MyLog2 (dim)
 
 
 /*****************************************************************************/
-/* CreateMESH: Mesh initialization function.                                 */
+/* NetStatsInit: creates the statistics of a network whose packets travel    */
+/* at most max_hops hops. Called by each of the network builders.            */
 /*****************************************************************************/
 
-void CreateMESH (int dim, int *m_size, int b_size, int p_size, IPORT **iport_ptr, OPORT **oport_ptr, int (*routefunc)(int *,int *,int), int mesh_num)
+void NetStatsInit(int mesh_num, int max_hops)
 {
-  
-  int 	i;
+  int i;
   char name[32];
-  
+
   if (mesh_num < 2) {
     /*Only two cases taken care of --  REQ_NET = 0, REPLY_NET = 1 */
     buf_index[mesh_num] = 0;
     oport_index[mesh_num] = 0;
     meshnum = mesh_num;
 
-    NUM_HOPS = 0;
-    for (i=0; i<dim; i++)
-      NUM_HOPS += m_size[i]-1;   /* Sum up hops in x direction + hops in y direction */
+    NUM_HOPS = max_hops;
 
     /* Produce new statistics for network */
     
@@ -155,6 +164,8 @@ void CreateMESH (int dim, int *m_size, int b_size, int p_size, IPORT **iport_ptr
     sprintf(name, "PktSzHist_Net%d",mesh_num);
     PktSzHist[mesh_num] = NewStatrec(name, POINT, MEANS, HISTSPECIAL, 128, 
 				     0.0, 128.0);
+    StatrecSetUnit(PktNumHopsHist[mesh_num],"hops");
+    StatrecSetUnit(PktSzHist[mesh_num],"flits");
     
     PktHpsTimeTotalMean[mesh_num] =  (STATREC **)malloc(sizeof(STATREC *)*(NUM_HOPS+1));
     PktHpsTimeNetMean[mesh_num] =  (STATREC **)malloc(sizeof(STATREC *)*(NUM_HOPS+1));
@@ -167,6 +178,9 @@ void CreateMESH (int dim, int *m_size, int b_size, int p_size, IPORT **iport_ptr
       PktSzTimeNetMean[mesh_num][i] = NewStatrec(name, POINT, MEANS,NOHIST,0, 0.0, 0);
       sprintf(name, "PktSzTimeBlkMean_Net%d_Sz%d",mesh_num, i);
       PktSzTimeBlkMean[mesh_num][i] = NewStatrec(name, POINT, MEANS,NOHIST,0, 0.0, 0);
+      StatrecSetUnit(PktSzTimeTotalMean[mesh_num][i],"cycles");
+      StatrecSetUnit(PktSzTimeNetMean[mesh_num][i],"cycles");
+      StatrecSetUnit(PktSzTimeBlkMean[mesh_num][i],"cycles");
     }
     
     for (i=0; i<(NUM_HOPS+1); i++) {
@@ -176,6 +190,9 @@ void CreateMESH (int dim, int *m_size, int b_size, int p_size, IPORT **iport_ptr
       PktHpsTimeNetMean[mesh_num][i] = NewStatrec(name, POINT, MEANS,NOHIST,0, 0.0, 0);
       sprintf(name, "PktHpsTimeBlkMean_Net%d_Hop%d",mesh_num, i);
       PktHpsTimeBlkMean[mesh_num][i] = NewStatrec(name, POINT, MEANS,NOHIST,0, 0.0, 0);
+      StatrecSetUnit(PktHpsTimeTotalMean[mesh_num][i],"cycles");
+      StatrecSetUnit(PktHpsTimeNetMean[mesh_num][i],"cycles");
+      StatrecSetUnit(PktHpsTimeBlkMean[mesh_num][i],"cycles");
     }
     
     sprintf(name, "PktTOTimeTotalMean_Net%d",mesh_num);
@@ -184,6 +201,9 @@ void CreateMESH (int dim, int *m_size, int b_size, int p_size, IPORT **iport_ptr
     PktTOTimeNetMean[mesh_num] = NewStatrec(name, POINT, MEANS,NOHIST,400, 0.0, 4000.0);
     sprintf(name, "PktTOTimeBlkMean_Net%d",mesh_num);
     PktTOTimeBlkMean[mesh_num] = NewStatrec(name, POINT, MEANS,NOHIST,400, 0.0, 4000.0);
+    StatrecSetUnit(PktTOTimeTotalMean[mesh_num],"cycles");
+    StatrecSetUnit(PktTOTimeNetMean[mesh_num],"cycles");
+    StatrecSetUnit(PktTOTimeBlkMean[mesh_num],"cycles");
 
     for (i=0; i<1024; i++)
       net_index[i] = -1;
@@ -191,16 +211,43 @@ void CreateMESH (int dim, int *m_size, int b_size, int p_size, IPORT **iport_ptr
       rev_index[i] = -1;
     cur_index = 0;
   }
+}
+
+
+/*****************************************************************************/
+/* CreateMESH: Mesh initialization function.                                 */
+/*****************************************************************************/
+
+void CreateMESH (int dim, int *m_size, int b_size, int p_size, IPORT **iport_ptr, OPORT **oport_ptr, int (*routefunc)(int *,int *,int), int mesh_num)
+{
+  
+  int 	i, max_hops;
+  
+  max_hops = 0;
+  for (i=0; i<dim; i++)
+    max_hops += m_size[i]-1;   /* Sum up hops in x direction + hops in y direction */
+  NetStatsInit(mesh_num, max_hops);
+
+  if (NetModel == PACKET_NETMODEL) { /* no switches; see pktnet.c */
+    PktNetCreate(MESH_NET, dim, m_size, 1, p_size, iport_ptr, oport_ptr, mesh_num);
+    return;
+  }
   
   num_nodes = 1;		
   
   fp  = fopen ("/dev/null", "w");  /* Turned off this tracing */
   router = routefunc ? routefunc : MeshRoute;
+  if (router != MeshRoute && dim != 2)
+    YS__errmsg("Adaptive mesh routing needs a 2-dimensional mesh");
   mesh_size = (int *) malloc (dim * sizeof(int));
   for (i = 0; i < dim; i++) {
     mesh_size[i] = m_size[i];
     num_nodes *= mesh_size[i];
   }
+  if (mesh_num == REPLY_NET) {
+    cpu_iport = (IPORT **) malloc (num_nodes * sizeof(IPORT *));
+    cpu_oport = (OPORT **) malloc (num_nodes * sizeof(OPORT *));
+  }
   
   actual_dim = dim;
   buf_size = b_size;
@@ -536,8 +583,7 @@ void NodeIntraConnect (iport_ptr, oport_ptr)
 int MeshRoute (int *src, int *dest, int id) 
 {
   
-  int	radix, src_index, dest_index, curr_node, dest_node, dim, dir,
-  src_demux_id, exit_demux_id, exit_index, temp;
+  int	radix, src_index, dest_index, curr_node, dest_node, dim, dir, temp;
   
   
   curr_node = id / (0x01 << (MODULE_BITS + log_dim + 1));
@@ -581,11 +627,25 @@ int MeshRoute (int *src, int *dest, int id)
   
   dir = (src_index < dest_index);
   
-  /* Now we can find out the component through which the packet must leave
-     this node. The index through which the demux must be left can be found
+  /*fprintf (fp, " Exit module %d\n", (exit_demux_id & ~0x02) + temp); */
+  return MeshExitIndex(id, dim, dir);
+  
+}
+
+
+/*****************************************************************************/
+/* MeshExitIndex: the output of demux id that leads to the mux of the        */
+/* component for dimension dim and direction dir in the same node.           */
+/*****************************************************************************/
+
+static int MeshExitIndex (int id, int dim, int dir)
+{
+  int src_demux_id, exit_demux_id, exit_index;
+
+  /* The index through which the demux must be left can be found
      easily by comparing the source demux id with the id of the demux in the
-     destination component. This is what we do next. See indexing rules in
-     NodeIntraConnect for more details.  src_demux_id != id. */
+     destination component. See indexing rules in NodeIntraConnect for more
+     details.  src_demux_id != id. */
   
   src_demux_id = id & (~(~0x00 << (1 + log_dim + MODULE_BITS)));
   
@@ -596,9 +656,124 @@ int MeshRoute (int *src, int *dest, int id)
   if (exit_demux_id > src_demux_id)
     exit_index--;
   
-  /*fprintf (fp, " Exit module %d\n", (exit_demux_id & ~0x02) + temp); */
   return exit_index;
-  
+}
+
+
+/*****************************************************************************/
+/* MeshExitSpace: free flits in the buffer of the next node reached through  */
+/* output exit_index of the demux being routed (YS__RouteDemux).             */
+/*****************************************************************************/
+
+static int MeshExitSpace (int exit_index)
+{
+  MUX *mux;
+
+  mux = (MUX *) YS__RouteDemux->nextmodule[exit_index];
+  if (mux == NULL || mux->nextmodule == NULL ||
+      mux->nextmodule->type != BUFFERTYPE)
+    return 0;
+  return ((BUFFER *) mux->nextmodule)->free;
+}
+
+
+/*****************************************************************************/
+/* MeshAdaptiveExit: picks, among the allowed productive directions, the     */
+/* exit with the most free downstream buffer space. x_dir and y_dir are the  */
+/* productive directions in dimensions 0 and 1; x_ok and y_ok say whether    */
+/* the turn model allows them. Ties go to dimension 1, as in MeshRoute().    */
+/*****************************************************************************/
+
+static int MeshAdaptiveExit (int id, int x_ok, int x_dir, int y_ok, int y_dir)
+{
+  int x_exit, y_exit;
+
+  if (!x_ok)
+    return MeshExitIndex(id, 1, y_dir);
+  x_exit = MeshExitIndex(id, 0, x_dir);
+  if (!y_ok)
+    return x_exit;
+  y_exit = MeshExitIndex(id, 1, y_dir);
+  if (MeshExitSpace(x_exit) > MeshExitSpace(y_exit))
+    return x_exit;
+  return y_exit;
+}
+
+
+/*****************************************************************************/
+/* MeshWestFirstRoute: west-first turn model for a 2-D mesh. A packet that   */
+/* must go west does so first; after that it never turns west again, and it  */
+/* may take any productive direction among east, north and south.            */
+/*****************************************************************************/
+
+int MeshWestFirstRoute (int *src, int *dest, int id) 
+{
+  int curr_node, dest_node, cx, cy, dx, dy;
+
+  curr_node = id / (0x01 << (MODULE_BITS + log_dim + 1));
+  dest_node = (*dest & 0x0fff);
+
+  if (*src == dest_node) {
+    fprintf (simerr, "WARNING: Processor %d sending to itself %d %d @%1.0f\n",
+	     *src, dest_node, *dest, YS__Simtime); 
+    return (2*actual_dim);
+  }
+  if (curr_node == dest_node)
+    return (2*actual_dim - 1);
+
+  cx = curr_node % mesh_size[0];
+  cy = curr_node / mesh_size[0];
+  dx = dest_node % mesh_size[0];
+  dy = dest_node / mesh_size[0];
+
+  if (dx < cx)				/* west first */
+    return MeshExitIndex(id, 0, 0);
+  return MeshAdaptiveExit(id, dx != cx, 1, dy != cy, cy < dy);
+}
+
+
+/*****************************************************************************/
+/* MeshOddEvenRoute: odd-even turn model for a 2-D mesh (Chiu). Packets may  */
+/* not turn from east to north or south in an even column, nor from north or */
+/* south to west in an odd column. Unlike west-first, westbound packets may  */
+/* also move adaptively.                                                     */
+/*****************************************************************************/
+
+int MeshOddEvenRoute (int *src, int *dest, int id) 
+{
+  int curr_node, dest_node, cx, cy, sx, dx, dy;
+
+  curr_node = id / (0x01 << (MODULE_BITS + log_dim + 1));
+  dest_node = (*dest & 0x0fff);
+
+  if (*src == dest_node) {
+    fprintf (simerr, "WARNING: Processor %d sending to itself %d %d @%1.0f\n",
+	     *src, dest_node, *dest, YS__Simtime); 
+    return (2*actual_dim);
+  }
+  if (curr_node == dest_node)
+    return (2*actual_dim - 1);
+
+  cx = curr_node % mesh_size[0];
+  cy = curr_node / mesh_size[0];
+  sx = *src % mesh_size[0];
+  dx = dest_node % mesh_size[0];
+  dy = dest_node / mesh_size[0];
+
+  if (dx == cx)				/* only north or south left */
+    return MeshExitIndex(id, 1, cy < dy);
+
+  if (dx > cx) {			/* eastbound */
+    if (dy == cy)
+      return MeshExitIndex(id, 0, 1);
+    return MeshAdaptiveExit(id,
+			    (dx % 2 == 1) || (dx - cx != 1), 1,
+			    (cx % 2 == 1) || (cx == sx), cy < dy);
+  }
+
+  /* westbound: a north or south move is only allowed in an even column,
+     so that the packet can still turn west afterwards */
+  return MeshAdaptiveExit(id, 1, 0, (dy != cy) && (cx % 2 == 0), cy < dy);
 }
 
 /**************************************************************************/
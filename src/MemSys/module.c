@@ -66,6 +66,7 @@
 #include "MemSys/directory.h"
 #include "MemSys/bus.h"
 #include "MemSys/arch.h"
+#include "MemSys/statout.h"
 #include "Processor/simio.h"
 
 #include <malloc.h>
@@ -142,11 +143,16 @@ int q_size;                     /* Size of queues in each port */
 
 void StatReportAll()
 {
+  static int reports = 0;     /* the phase of structured output records */
   int i;
   double net_util[2], net_util_total;
   int req_buf_reduced = 0, req_oport_reduced = 0, reply_buf_reduced = 0, reply_oport_reduced = 0;
+  char field[40];
 
   fprintf(simout,"\nTIME FOR EXECUTION:\t%g\n",YS__Simtime); 
+  StatOutPhase(reports++);
+  StatOutScope("system","system");
+  STATOUT("execution_time",YS__Simtime,"cycles");
 
   CacheStatReportAll(); /* prints out all stats for caches */
   fflush(simout);
@@ -157,6 +163,8 @@ void StatReportAll()
   fprintf(simout,"\n### Memory Interleaving Statistics ###\n\n");
   for (i=0; i< YS__NumNodes; i++)
     {
+      sprintf(field,"node%d",i);
+      StatOutScope("memory",field);
       StatrecReport(InterleavingStats[i]);
     }  
   fflush(simout);
@@ -168,9 +176,13 @@ void StatReportAll()
   if (YS__NumNodes != 1) /* print system and network statistics, if present */
     {
       fprintf(simout,"\n#### General System Statistics ####\n\n");
+      StatOutScope("system","system");
       StatrecReport(CoheNumInvlHist);
       
-      fprintf(simout,"\n#### REQUEST NET STATISTICS ####\n\n");
+      StatOutScope("net","request");
+      
+      fprintf(simout,"\n#### REQUEST NET STATISTICS (%s routing) ####\n\n",
+	      NetRoutingName[NetRouting]);
       if (PktNumHopsHist[REQ_NET])		
 	StatrecReport(PktNumHopsHist[REQ_NET]); /* Report statistics for # of hops
 						   traveled by packets in REQ_NET */
@@ -208,7 +220,9 @@ void StatReportAll()
       
       /* Repeat above actions for REPLY network rather than REQUEST network... */
       
-      fprintf(simout,"\n\n#### REPLY NET STATISTICS ####\n\n");
+      fprintf(simout,"\n\n#### REPLY NET STATISTICS (%s routing) ####\n\n",
+	      NetRoutingName[NetRouting]);
+      StatOutScope("net","reply");
       if (PktNumHopsHist)	
 	StatrecReport(PktNumHopsHist[REPLY_NET]);
       StatrecReport(PktSzHist[REPLY_NET]);
@@ -257,6 +271,11 @@ void StatReportAll()
 	      fprintf(simout, "Utilization of buffer %s in network Reply = %g\n",
 		      WhichBuf[REPLY_NET][i], BufTable[REPLY_NET][i]->channel_busy/
 		      (YS__Simtime - BufTable[REPLY_NET][i]->time_of_last_clear) );
+	      if (StatOut)
+		StatOutValue("buffer_utilization",WhichBuf[REPLY_NET][i],
+			     BufTable[REPLY_NET][i]->channel_busy/
+			     (YS__Simtime - BufTable[REPLY_NET][i]->time_of_last_clear),
+			     "fraction");
 	      net_util[REPLY_NET] += BufTable[REPLY_NET][i]->channel_busy/
 		(YS__Simtime - BufTable[REPLY_NET][i]->time_of_last_clear) ;
 	    }
@@ -269,6 +288,14 @@ void StatReportAll()
 	      fprintf(simout, "Utilization of oport %d in network Reply = %g\n",
 		      i, OportTable[REPLY_NET][i]->channel_busy/
 		      (YS__Simtime - OportTable[REPLY_NET][i]->time_of_last_clear)); 
+	      if (StatOut)
+		{
+		  sprintf(field,"oport%d",i);
+		  StatOutValue("oport_utilization",field,
+			       OportTable[REPLY_NET][i]->channel_busy/
+			       (YS__Simtime - OportTable[REPLY_NET][i]->time_of_last_clear),
+			       "fraction");
+		}
 	      net_util[REPLY_NET] +=  OportTable[REPLY_NET][i]->channel_busy /
 		(YS__Simtime - OportTable[REPLY_NET][i]->time_of_last_clear) ;
 	    }
@@ -280,11 +307,13 @@ void StatReportAll()
 	net_util_total = net_util[REPLY_NET];
 	net_util[REPLY_NET] = net_util[REPLY_NET]/(double)(buf_index[REPLY_NET]+oport_index[REPLY_NET]-reply_buf_reduced-reply_oport_reduced); 
 	fprintf(simout,"Reply Network Utilization: %g\n",net_util[REPLY_NET]);
+	STATOUT("network_utilization",net_util[REPLY_NET],"fraction");
       }
       
 
       /* Repeat above for REQUEST network */
       if (buf_index[REQ_NET] || oport_index[REQ_NET]) {
+	StatOutScope("net","request");
 	net_util[REQ_NET] = 0.0;
 	if (buf_index[REQ_NET]) 
 	  buf_index[REQ_NET] --;
@@ -296,6 +325,11 @@ void StatReportAll()
 	      fprintf(simout, "Utilization of buffer %s in network Request = %g\n",
 		      WhichBuf[REQ_NET][i], BufTable[REQ_NET][i]->channel_busy/
 		      (YS__Simtime - BufTable[REQ_NET][i]->time_of_last_clear));
+	      if (StatOut)
+		StatOutValue("buffer_utilization",WhichBuf[REQ_NET][i],
+			     BufTable[REQ_NET][i]->channel_busy/
+			     (YS__Simtime - BufTable[REQ_NET][i]->time_of_last_clear),
+			     "fraction");
 	      net_util[REQ_NET] +=  (BufTable[REQ_NET][i]->channel_busy / 
 				     (YS__Simtime - BufTable[REQ_NET][i]->time_of_last_clear)) ;
 	    }
@@ -308,6 +342,14 @@ void StatReportAll()
 	      fprintf(simout, "Utilization of oport %d in network Request = %g\n",
 		      i, OportTable[REQ_NET][i]->channel_busy/
 		      (YS__Simtime - OportTable[REQ_NET][i]->time_of_last_clear) ); 
+	      if (StatOut)
+		{
+		  sprintf(field,"oport%d",i);
+		  StatOutValue("oport_utilization",field,
+			       OportTable[REQ_NET][i]->channel_busy/
+			       (YS__Simtime - OportTable[REQ_NET][i]->time_of_last_clear),
+			       "fraction");
+		}
 	      net_util[REQ_NET] +=  (OportTable[REQ_NET][i]->channel_busy / 
 				     (YS__Simtime - OportTable[REQ_NET][i]->time_of_last_clear)) ;
 	    }
@@ -319,13 +361,18 @@ void StatReportAll()
 	net_util_total += net_util[REQ_NET];
 	net_util[REQ_NET] = net_util[REQ_NET]/(double)(buf_index[REQ_NET]+oport_index[REQ_NET]-req_buf_reduced-req_oport_reduced); 
 	fprintf(simout,"Req Network Utilization: %g\n",net_util[REQ_NET]);
+	STATOUT("network_utilization",net_util[REQ_NET],"fraction");
       }
       if (buf_index[REQ_NET] || oport_index[REQ_NET] || buf_index[REQ_NET] || oport_index[REQ_NET]) {
 	net_util_total = net_util_total/(double)(buf_index[REQ_NET]+oport_index[REQ_NET]+buf_index[REPLY_NET]+oport_index[REPLY_NET]-req_buf_reduced-reply_buf_reduced-req_oport_reduced-reply_oport_reduced); 
 	fprintf(simout,"Total Network Utilization: %g\n", net_util_total);
+	StatOutScope("net","total");
+	STATOUT("network_utilization",net_util_total,"fraction");
       }
       NetworkStatRept(); /* print additional stats for Network, if any */
     }
+  if (StatOut)
+    fflush(StatOut);
 }
 
 /*****************************************************************************/
@@ -465,6 +512,11 @@ double *hitpr, *lat, *util;
   fprintf(simout,"\nName          Num_Ref          Num_Hit;Hit_Rate   Miss_latency     Utilization\n");
   fprintf(simout,"%s%s%10d       %10d(%5.2g%%)     %6.4g             %6.4g\n", 
 	  mptr->name, s,mptr->num_ref, num_hit, *hitpr, *lat, *util);
+  STATOUT("num_ref",mptr->num_ref,"count");
+  STATOUT("num_hit",num_hit,"count");
+  STATOUT("hit_rate",*hitpr,"percent");
+  STATOUT("miss_latency",*lat,"cycles");
+  STATOUT("utilization",*util,"fraction");
 }
 
 /*****************************************************************************/
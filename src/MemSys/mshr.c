@@ -65,14 +65,102 @@
 #include "MemSys/arch.h"
 #include "Processor/simio.h"
 
+#include <malloc.h>
+#include <strings.h>
+
 int DISCRIMINATE_PREFETCH = 0; /* Will prefetches drop if they don't get
 				  an MSHR? */
 
 /*****************************************************************************/
 /* MSHR operations: The MSHRs implement the non blocking nature of the       */
-/* caches. They are implemented as an array of outstanding REQ's.            */
+/* caches. They are implemented as an array of outstanding REQ's. The valid  */
+/* MSHRs are also chained by line tag in a small hash table (mshr_hash), and */
+/* a bit vector (mshr_free) marks the free ones, so that neither looking up  */
+/* an access nor allocating an MSHR has to scan the whole array.             */
 /*****************************************************************************/
 
+/*****************************************************************************/
+/* InitMSHRs: allocate the MSHR array of a cache and its lookup structures.  */
+/*****************************************************************************/
+
+void InitMSHRs(CACHE *captr, int max_mshrs)
+{
+  int i, words;
+
+  captr->max_mshrs = max_mshrs;
+  captr->mshrs = (MSHRITEM *)malloc(sizeof(MSHRITEM) * max_mshrs);
+
+  /* at least two buckets per MSHR, to keep the chains short */
+  for (i = 1; i < 2 * max_mshrs; i <<= 1);
+  captr->mshr_hash_mask = i - 1;
+  captr->mshr_hash = (MSHRITEM **)malloc(sizeof(MSHRITEM *) * i);
+
+  words = (max_mshrs + 31) / 32;
+  captr->mshr_free = (unsigned *)malloc(sizeof(unsigned) * words);
+  if (captr->mshrs == NULL || captr->mshr_hash == NULL || captr->mshr_free == NULL)
+    YS__errmsg("InitMSHRs(): malloc failed");
+
+  for (i=0; i <= captr->mshr_hash_mask; i++)
+    captr->mshr_hash[i] = NULL;
+  for (i=0; i < words; i++)
+    captr->mshr_free[i] = 0;
+  for (i=0; i < max_mshrs; i++)
+    {
+      captr->mshrs[i].valid = 0;
+      captr->mshrs[i].next = NULL;
+      captr->mshr_free[i / 32] |= 1 << (i % 32);
+    }
+}
+
+/*****************************************************************************/
+/* MSHRLookup: returns the first (lowest numbered) valid MSHR whose main     */
+/* REQUEST has the given tag, or -1 -- the same MSHR a scan of the array     */
+/* would find.                                                               */
+/*****************************************************************************/
+
+static int MSHRLookup(CACHE *captr, long tag)
+{
+  MSHRITEM *temp;
+  int hit = -1, i;
+
+  for (temp = captr->mshr_hash[tag & captr->mshr_hash_mask]; temp; temp = temp->next)
+    {
+      if (temp->tag == tag)
+	{
+	  i = temp - captr->mshrs;
+	  if (hit == -1 || i < hit)
+	    hit = i;
+	}
+    }
+  return hit;
+}
+
+/* MSHRHashAdd, MSHRHashRm: link an MSHR into, or out of, the chain for its
+   stored line tag (never read through mainreq, which may already be freed) */
+static void MSHRHashAdd(CACHE *captr, int mshr_num)
+{
+  MSHRITEM **head;
+
+  head = &captr->mshr_hash[captr->mshrs[mshr_num].tag & captr->mshr_hash_mask];
+  captr->mshrs[mshr_num].next = *head;
+  *head = &captr->mshrs[mshr_num];
+}
+
+static void MSHRHashRm(CACHE *captr, int mshr_num)
+{
+  MSHRITEM **temp;
+
+  temp = &captr->mshr_hash[captr->mshrs[mshr_num].tag & captr->mshr_hash_mask];
+  while (*temp != &captr->mshrs[mshr_num])
+    {
+      if (*temp == NULL)
+	YS__errmsg("MSHRHashRm(): MSHR not found in its chain");
+      temp = &(*temp)->next;
+    }
+  *temp = captr->mshrs[mshr_num].next;
+  captr->mshrs[mshr_num].next = NULL;
+}
+
 /*****************************************************************************/
 /* notpres_mshr: This function is called for all incoming REQUESTs,          */
 /* COHEs, and COHE_REPLYs and checks whether the incoming transaction        */
@@ -89,7 +177,7 @@ enum MSHR_Response notpres_mshr(CACHE *captr, REQ *req)
   int i, hittype, type, data_type;
   int req_sz, rep_sz, nxt_req_sz;
   long tag, address;
-  int set, set_ind, i1, i2;
+  int set, set_ind;
   int cohe_type, allo_type, allocate,  dest_node;
   ReqType nxt_mod_req, nxt_req;
   CacheLineState cur_state, nxt_st;
@@ -114,25 +202,17 @@ enum MSHR_Response notpres_mshr(CACHE *captr, REQ *req)
       
       /* This function first determines whether the incoming
 	 transaction matches anything in the MSHRs */
-      for(i=0;i<captr->max_mshrs;i++)
-	{
-	  if((captr->mshrs[i].valid == 1) &&
-	     (req->tag == captr->mshrs[i].mainreq->tag)) /* same tag, so match */
-	    {
-	      hit = i; /* mark down the MSHR of the match */
-	      break;
-	    }
-	}
+      hit = MSHRLookup(captr, req->tag);
     }
 
   if(hit == -1) /* no match */
     {
       /* Find first free MSHR in case we need to allocate a new mshr  */
-      for(i=0;i<captr->max_mshrs;i++)
+      for(i=0;i<(captr->max_mshrs+31)/32;i++)
 	{
-	  if(captr->mshrs[i].valid != 1)
+	  if(captr->mshr_free[i])
 	    {
-	      free_mshr = i;
+	      free_mshr = i*32 + ffs(captr->mshr_free[i]) - 1;
 	      break;
 	    }
 	}
@@ -152,15 +232,13 @@ enum MSHR_Response notpres_mshr(CACHE *captr, REQ *req)
       /* The "notpres" function is called to determine if the desired line
 	 is available in the cache. */
       hittype = notpres(req->address,&tag,&set,&set_ind,captr);
-      i1 = set_ind / SUB_SZ;
-      i2 = set_ind % SUB_SZ;
       if(hit == -1) /* the line is not present in any MSHR */
 	{
 	  if(hittype != 0) /* not in cache either */
 	    cur_state=INVALID;
 	  else /* in cache, so find current state */
 	    {
-	      cur_state = captr->data[i1][i2].state.st;
+	      cur_state = captr->data[set_ind].state.st;
 	    }
 
 	  /* Determine cohe_type of cache and access */
@@ -186,7 +264,7 @@ enum MSHR_Response notpres_mshr(CACHE *captr, REQ *req)
 
 	  if(!nxt_mod_req) /* no lower request needed */
 	    {
-	      if (captr->data[i1][i2].state.cohe_pend) /* L2 cache line with outstanding COHE inflight to L1 */
+	      if (captr->data[set_ind].state.cohe_pend) /* L2 cache line with outstanding COHE inflight to L1 */
 		{
 		  if (MemsimStatOn)
 		    captr->stat.pipe_stall_PEND_COHE++;
@@ -199,7 +277,7 @@ enum MSHR_Response notpres_mshr(CACHE *captr, REQ *req)
 	      if (cur_state != nxt_st) 
 		{
 		  /* Set cache line state accordingly */
-		  captr->data[i1][i2].state.st=nxt_st;
+		  captr->data[set_ind].state.st=nxt_st;
 		}
 	      hit_update(set_ind, captr, set, req); /* update LRU ages */
 	      StatSet(captr,req,CACHE_HIT);
@@ -281,8 +359,11 @@ enum MSHR_Response notpres_mshr(CACHE *captr, REQ *req)
 	  StatrecUpdate(captr->mshr_req_count,(double)captr->reqs_at_mshr_count,YS__Simtime);
       
 	  captr->mshrs[free_mshr].valid = 1; /* Set to valid */
+	  captr->mshr_free[free_mshr / 32] &= ~(1 << (free_mshr % 32));
 	  captr->mshrs[free_mshr].setnum = set; /* just to store state */
 	  captr->mshrs[free_mshr].mainreq = req;
+	  captr->mshrs[free_mshr].tag = req->tag;
+	  MSHRHashAdd(captr, free_mshr);
 	  captr->mshrs[free_mshr].counter = 0;     /* Number of coalesces -- set to 0 */
 	  captr->mshrs[free_mshr].pend_cohe_type = BAD_REQ_TYPE; 
 	  captr->mshrs[free_mshr].stall_WAR = 0;
@@ -318,7 +399,7 @@ enum MSHR_Response notpres_mshr(CACHE *captr, REQ *req)
 	      hit_update(set_ind, captr, set, req);
 	      
 	      if (captr->cache_level_type != FIRSTLEVEL_WT)
-		captr->data[i1][i2].state.mshr_out = 1; /* mark an upgrade so we don't kick it out */
+		captr->data[set_ind].state.mshr_out = 1; /* mark an upgrade so we don't kick it out */
 
 	      response = MSHR_FWD; /* upgrade */
 	    }
@@ -776,7 +857,7 @@ int RemoveMSHR(CACHE *captr, int mshr_num, REQ *subst)
   
 #ifdef DEBUG_MSHR
   if (YS__Simtime > DEBUG_TIME)
-    fprintf(simout,"MSHR: %s Going to free an MSHR for tag %ld, set %d\n",captr->name, captr->mshrs[mshr_num].mainreq->tag,set);
+    fprintf(simout,"MSHR: %s Going to free an MSHR for tag %ld, set %d\n",captr->name, captr->mshrs[mshr_num].tag,set);
 #endif
   
   if (captr->mshrs[mshr_num].demand > 0.0) /* in other words, there was a late prefetch */
@@ -792,19 +873,23 @@ int RemoveMSHR(CACHE *captr, int mshr_num, REQ *subst)
   
   /* subst is used to put a WRB or such request into a smart MSHR
      in place of a former request */
+  MSHRHashRm(captr, mshr_num);
   if (subst == NULL)
     {
       captr->mshr_count--;
       captr->mshrs[mshr_num].valid = 0;
+      captr->mshr_free[mshr_num / 32] |= 1 << (mshr_num % 32);
     }
   else
     {
 #ifdef DEBUG_MSHR
       if (YS__Simtime > DEBUG_TIME)
-	fprintf(simout,"MSHR: %s Substituting in %s for tag %ld, set %d\n",captr->name, Req_Type[subst->req_type],captr->mshrs[mshr_num].mainreq->tag,set);
+	fprintf(simout,"MSHR: %s Substituting in %s for tag %ld, set %d\n",captr->name, Req_Type[subst->req_type],captr->mshrs[mshr_num].tag,set);
 #endif
   
       captr->mshrs[mshr_num].mainreq = subst;
+      captr->mshrs[mshr_num].tag = subst->tag;
+      MSHRHashAdd(captr, mshr_num); /* now found under the tag of subst */
       /* keep valid, total mshr count constant */
     }
 
@@ -819,25 +904,9 @@ int RemoveMSHR(CACHE *captr, int mshr_num, REQ *subst)
 
 int FindInMshrEntries(CACHE *captr,REQ *req)
 {
-  int hit= -1, i;
-  
   if(captr->mshr_count == 0)
-    hit = -1;
-  else
-    {
-      /* Let us see when the first hit occurs */
-      for(i=0;i<captr->max_mshrs;i++)
-	{
-	  if((captr->mshrs[i].valid == 1) &&
-	     (req->tag == captr->mshrs[i].mainreq->tag))
-	    {
-	      hit = i;
-	      break;
-	    }
-	}
-    }
-  
-  return hit;
+    return -1;
+  return MSHRLookup(captr, req->tag);
 }
 
 /*****************************************************************************/
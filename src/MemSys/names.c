@@ -117,7 +117,8 @@ char *Cohe[Cohe_max] = {"","PR_WT","PR_WB","WT_INV","WT_UPD","WB_REF","WB_NREF",
    Dir_Cohe */
 char *DirRtnStatus[Directory_rtn_max] = {"", "WAIT_CNT", "WAIT_PEND", "VISIT_MEM", "DIR_REPLY", 
                                 "", "", "SPECIAL_REPLY",
-			        "FORWARD_REQUEST", "ACK_REPLY", "WAIT_FOR_WRB"};
+			        "FORWARD_REQUEST", "ACK_REPLY", "WAIT_FOR_WRB",
+				"EVICT_REPLY"};
 
 /* MSHRret -- corresponds to enum MSHR_Response in mshr.h -- responses
               from notpres_mshr  */
@@ -56,6 +56,7 @@
 
 
 #include "MemSys/simsys.h"
+#include "MemSys/net.h"
 #include "MemSys/tr.net.h"
 #include <malloc.h>
 #include <math.h>
@@ -116,6 +117,10 @@ static STATREC *oporttimestat = NULL;
 static STATREC *movetimestat  = NULL;
 static STATREC *lifetimestat  = NULL;
 
+DEMUX *YS__RouteDemux = NULL;    /* Demux whose routing function is running;
+				    lets adaptive routers look at the
+				    modules on its outputs */
+
 /*****************************************************************************/
 /* MUX Operations: Multiplexers control access to a shared data path         */
 /* by performing arbitration whenever two or more packets want to use the    */
@@ -670,7 +675,9 @@ int    dest;                           /* ID of destination CPU              */
    EVENT *headevent; 
    EVENT *tailevent;
    double x; 
+#ifdef POOL_AS_MALLOC
    char namestr[31];
+#endif
 
    TRACE_IPORT_send1;                   /* Attempting to send packet ...     */
 
@@ -698,22 +705,8 @@ int    dest;                           /* ID of destination CPU              */
          /* Ready could be < qfree if a process, maybe this one, has
           waited at and decremented semaphore portrdy, prior to the
           activation of this routine */
-                                        
-      /* Create the head event */
-
-      sprintf(namestr,"Head%d",pkt->data.seqno);
-      headevent = NewEvent(namestr,YS__HeadEvent,NODELETE,0);
-      ActivitySetArg((ACTIVITY *)headevent,pkt,HEADTYPE);       /* Gives head access to pkt info  */
-      pkt->headev = headevent;
 
-      /* Create the tail event */
-
-      sprintf(namestr,"Tail%d",pkt->data.seqno);
-      tailevent = NewEvent(namestr,YS__TailEvent,NODELETE,0);
-      ActivitySetArg((ACTIVITY *)tailevent,pkt,TAILTYPE);       /* Gives tail access to pkt info  */
-      pkt->SleepingTail = tailevent;                /* Tail waiting for head to signal*/
-
-      /* Synchronize the head event with the network cycle time and schedule it */
+      /* Synchronize the head with the network cycle time */
 
       if (cycletime > 0.0) {
         x = fmod(YS__Simtime,cycletime);
@@ -725,6 +718,45 @@ int    dest;                           /* ID of destination CPU              */
          pkt->data.nettime - (YS__Simtime + x); /* Will add later Simtime to get diff */
 
       x = x + (pkt->data.pktsize)*pktdelay;       /* Plus time for pkt to enter port  */
+
+      if (NetModel == PACKET_NETMODEL) {  /* Packet-level model: no head/tail events */
+         PktNetSend(pkt,port,x,flitdelay,arbdelay);
+         TRACE_IPORT_send3;
+         return x;
+      }
+
+#ifndef POOL_AS_MALLOC
+      /* Reuse the head and tail events owned by this packet descriptor;
+         they are only created the first time the descriptor is sent */
+
+      if (pkt->headobj == NULL) {
+         pkt->headobj = NewEvent("Head",YS__HeadEvent,NODELETE,0);
+         pkt->tailobj = NewEvent("Tail",YS__TailEvent,NODELETE,0);
+      }
+      headevent = pkt->headobj;
+      EventSetState(headevent,Head_Start);
+      tailevent = pkt->tailobj;
+      EventSetState(tailevent,Tail_Start);
+#ifdef debug
+      if (TraceLevel > 0) {             /* Names only show up in traces      */
+         sprintf(headevent->name,"Head%d",pkt->data.seqno);
+         sprintf(tailevent->name,"Tail%d",pkt->data.seqno);
+      }
+#endif
+#else
+      /* Create the head and tail events */
+
+      sprintf(namestr,"Head%d",pkt->data.seqno);
+      headevent = NewEvent(namestr,YS__HeadEvent,NODELETE,0);
+      sprintf(namestr,"Tail%d",pkt->data.seqno);
+      tailevent = NewEvent(namestr,YS__TailEvent,NODELETE,0);
+#endif
+
+      ActivitySetArg((ACTIVITY *)headevent,pkt,HEADTYPE);       /* Gives head access to pkt info  */
+      pkt->headev = headevent;
+      ActivitySetArg((ACTIVITY *)tailevent,pkt,TAILTYPE);       /* Gives tail access to pkt info  */
+      pkt->SleepingTail = tailevent;                /* Tail waiting for head to signal*/
+
       ActivitySchedTime((ACTIVITY *)headevent,x,INDEPENDENT); /* Head wakes up when pkt in port   */
                                                   /* Ports use saf flit control       */
       TRACE_IPORT_send3;                /* - Port ready, packet queued ...   */
@@ -955,6 +987,7 @@ PACKET *pkt;                  /* Pointer to the packet                       */
 
             demux = (DEMUX*)pkt->module;             /* Cast module to type DEMUX     */
             TRACE_HEAD_nextdemux1;                   /* Head's next module is a demux */
+            YS__RouteDemux = demux;
             pkt->index =                             /* Calling routing function      */
                (demux->router)(&(pkt->data.srccpu),&(pkt->data.destcpu),demux->id);
 	    pkt->data.num_hops ++; /* Increment number of hops */
@@ -1143,9 +1176,11 @@ PACKET *pkt;                  /* Pointer to the packet                       */
             TRACE_HEAD_tooport;                /* Head moves to oport        */
 	    if (((OPORT *)pkt->module)->count == 0)
 	      ((OPORT *)pkt->module)->begin_util = YS__Simtime; /* for util stats     */
-            pkt->headev = NULL;                /* Head event will be deleted */
+            pkt->headev = NULL;                /* Head event is done         */
             pkt->headbuf = pkt->module;        /* But head flit is in the oport       */
+#ifdef POOL_AS_MALLOC
             EventSetDelFlag();                 /* Delete the head event      */
+#endif
             return;
          }
 
@@ -1333,7 +1368,9 @@ PACKET *pkt;                  /* Pointer to the packet                       */
 
          SemaphoreSignal(oport->pktavail); /* Releases  activities waiting on packets */
 
+#ifdef POOL_AS_MALLOC
          EventSetDelFlag();                /* Tail event dies                */
+#endif                                     /* else it waits for the next pkt */
          return;
    }
 }
@@ -0,0 +1,418 @@
+/*
+  pktnet.c
+
+  A packet-level model of the mesh interconnection network, used in
+  place of the flit-level wormhole model of net.c and mesh.c when the
+  configuration file sets "netmodel packet". Each packet reserves the
+  channels on its route when it is sent, and a single event then frees
+  its input port and delivers it to its output port.
+
+  */
+/*****************************************************************************/
+/* This file is part of the RSIM Simulator.                                  */
+/*                                                                           */
+/******************************************************************************/
+/* University of Illinois/NCSA Open Source License                            */
+/*                                                                            */
+/* Copyright (c) 2002 The Board of Trustees of the University of Illinois and */
+/* William Marsh Rice University                                              */
+/*                                                                            */
+/* All rights reserved.                                                       */
+/*                                                                            */
+/* Developed by: Professor Sarita Adve's RSIM research group                  */
+/*               University of Illinois at Urbana-Champaign and William Marsh */
+/*                 Rice University                                            */
+/*               http://www.cs.uiuc.edu/rsim and                              */
+/*                 http://www.ece.rice.edu/~rsim/dist.html                    */
+/*                                                                            */
+/* Permission is hereby granted, free of charge, to any person obtaining a    */
+/* copy of this software and associated documentation files (the "Software"), */
+/* to deal with the Software without restriction, including without           */
+/* limitation the rights to use, copy, modify, merge, publish, distribute,    */
+/* sublicense, and/or sell copies of the Software, and to permit persons to   */
+/* whom the Software is furnished to do so, subject to the following          */
+/* conditions:                                                                */
+/*                                                                            */
+/*     * Redistributions of source code must retain the above copyright       */
+/* notice, this list of conditions and the following disclaimers.             */
+/*                                                                            */
+/*     * Redistributions in binary form must reproduce the above copyright    */
+/* notice, this list of conditions and the following disclaimers in the       */
+/* documentation and/or other materials provided with the distribution.       */
+/*                                                                            */
+/*     * Neither the names of Professor Sarita Adve's RSIM research group,    */
+/* the University of Illinois at Urbana-Champaign, William Marsh Rice         */
+/* University, nor the names of its contributors may be used to endorse or    */
+/* promote products derived from this Software without specific prior written */
+/* permission.                                                                */
+/*                                                                            */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    */
+/* THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR  */
+/* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,      */
+/* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR      */
+/* OTHER DEALINGS WITH THE SOFTWARE.                                          */
+/******************************************************************************/
+
+#include "MemSys/simsys.h"
+#include "MemSys/net.h"
+#include <malloc.h>
+
+/******************************************************************************
+  The packet-level model keeps the NETSIM port interface (PacketSend,
+  PacketReceive and the port semaphores), so the network interfaces in
+  smnet.c work unchanged with either model.
+
+  When a packet is sent, its head is walked along its route: the
+  injection channel of the source node, one link per hop in dimension
+  order (highest dimension first, as in MeshRoute()), and the ejection
+  channel of the destination node. Each channel has a
+  reservation table entry holding the time it next becomes free. The
+  head waits at each channel until that time, moves through it in one
+  flit delay (plus the arbitration delay between channels), and leaves
+  the channel busy for the pktsize flits that follow it. Time spent
+  waiting is counted as blocked time.
+
+  Channels are reserved in the order packets are sent, and switch
+  buffers are not modelled, so a packet is never stopped by a full
+  buffer further along its route. Only a full output port holds a
+  packet back, exactly as in the flit model.
+
+  Three topologies are built on the same tables:
+    MESH_NET   n-dimensional mesh, one node per router (CreateMESH).
+    TORUS_NET  k-ary n-cube (CreateTORUS). Each dimension wraps around
+               and packets take the shorter way round, going up on a
+               tie. Since there are no buffers, the dateline virtual
+               channels a flit-level torus needs to stay deadlock free
+               do not appear here; both of them share the physical
+               link that is reserved.
+    CMESH_NET  concentrated mesh (CreateCMESH): conc consecutive nodes
+               share a router, each with its own injection and
+               ejection channel, and the routers form a mesh.
+ ****************************************************************************/
+
+int NetModel = FLIT_NETMODEL;   /* FLIT_NETMODEL or PACKET_NETMODEL */
+
+#define PktNet_Release  0       /* Event states: tail leaves the iport     */
+#define PktNet_Deliver  1       /* packet reaches the oport                */
+#define PktNet_Enqueue  2       /* oport space granted, queue the packet   */
+
+#define PKTNET_CHUNK    64      /* transfers allocated at a time           */
+
+typedef struct YS__PktNet {
+   int    topology;             /* MESH_NET, TORUS_NET or CMESH_NET        */
+   int    nodes;                /* number of nodes in this network         */
+   int    routers;              /* number of routers (nodes / conc)        */
+   int    conc;                 /* nodes per router                        */
+   int    dim;                  /* number of dimensions                    */
+   int    *size;                /* routers in each dimension               */
+   IPORT  **iport;              /* network input port of each node         */
+   OPORT  **oport;              /* network output port of each node        */
+   double *link;                /* free time of each link [router][dim][dir] */
+   double *inj;                 /* free time of each injection channel     */
+   double *ej;                  /* free time of each ejection channel      */
+} PKTNET;
+
+typedef struct YS__PktXfer {
+   EVENT  *ev;                  /* event moving this packet                */
+   PACKET *pkt;                 /* packet in flight                        */
+   OPORT  *oport;               /* destination port                        */
+   double deliver;              /* time the tail reaches the oport         */
+   struct YS__PktXfer *next;    /* free list                               */
+} PKTXFER;
+
+static PKTNET  PktNets[2];      /* REQ_NET and REPLY_NET                   */
+static PKTXFER *PktXferFree = NULL;
+
+
+/*****************************************************************************/
+/* CreateTORUS: builds a k-ary n-cube with m_size[i] nodes in dimension i.   */
+/* Arguments are those of CreateMESH, less the switch buffer size and the    */
+/* routing function. Only available with the packet-level model.             */
+/*****************************************************************************/
+
+void CreateTORUS(int dim, int *m_size, int p_size, IPORT **iport_ptr, OPORT **oport_ptr, int mesh_num)
+{
+   int i, max_hops;
+
+   if (NetModel != PACKET_NETMODEL)
+      YS__errmsg("The torus network requires \"netmodel packet\"");
+
+   max_hops = 0;
+   for (i = 0; i < dim; i++)
+      max_hops += m_size[i]/2;    /* at most half way round each ring */
+   NetStatsInit(mesh_num, max_hops);
+
+   PktNetCreate(TORUS_NET, dim, m_size, 1, p_size, iport_ptr, oport_ptr, mesh_num);
+}
+
+
+/*****************************************************************************/
+/* CreateCMESH: builds a mesh of routers with r_size[i] routers in           */
+/* dimension i and conc nodes on each router. Only available with the        */
+/* packet-level model.                                                       */
+/*****************************************************************************/
+
+void CreateCMESH(int dim, int *r_size, int conc, int p_size, IPORT **iport_ptr, OPORT **oport_ptr, int mesh_num)
+{
+   int i, max_hops;
+
+   if (NetModel != PACKET_NETMODEL)
+      YS__errmsg("The concentrated mesh network requires \"netmodel packet\"");
+
+   max_hops = 0;
+   for (i = 0; i < dim; i++)
+      max_hops += r_size[i]-1;
+   NetStatsInit(mesh_num, max_hops);
+
+   PktNetCreate(CMESH_NET, dim, r_size, conc, p_size, iport_ptr, oport_ptr, mesh_num);
+}
+
+
+/*****************************************************************************/
+/* PktNetCreate: packet-level counterpart of MeshCreate/NodeIntraConnect.    */
+/* Creates the ports of each node and the channel reservation tables of a    */
+/* network with m_size[i] routers in dimension i and conc nodes per router.  */
+/*****************************************************************************/
+
+void PktNetCreate(int topology, int dim, int *m_size, int conc, int p_size, IPORT **iport_ptr, OPORT **oport_ptr, int mesh_num)
+{
+   PKTNET *net;
+   int    i, routers, nodes;
+
+   if (mesh_num != REQ_NET && mesh_num != REPLY_NET)
+      YS__errmsg("PktNetCreate(): only the request and reply networks are supported");
+
+   routers = 1;
+   for (i = 0; i < dim; i++)
+      routers *= m_size[i];
+   nodes = routers * conc;
+
+   net = &PktNets[mesh_num];
+   net->topology = topology;
+   net->nodes = nodes;
+   net->routers = routers;
+   net->conc = conc;
+   net->dim = dim;
+   net->size = (int *)malloc(dim * sizeof(int));
+   net->iport = (IPORT **)malloc(nodes * sizeof(IPORT *));
+   net->oport = (OPORT **)malloc(nodes * sizeof(OPORT *));
+   net->link = (double *)malloc(routers * dim * 2 * sizeof(double));
+   net->inj = (double *)malloc(nodes * sizeof(double));
+   net->ej = (double *)malloc(nodes * sizeof(double));
+   if (!net->size || !net->iport || !net->oport || !net->link || !net->inj || !net->ej)
+      YS__errmsg("malloc failed in PktNetCreate");
+
+   for (i = 0; i < dim; i++)
+      net->size[i] = m_size[i];
+   for (i = 0; i < routers * dim * 2; i++)
+      net->link[i] = 0.0;
+
+   if (mesh_num == REPLY_NET) {   /* message-passing ports, as in mesh.c */
+      cpu_iport = (IPORT **)malloc(nodes * sizeof(IPORT *));
+      cpu_oport = (OPORT **)malloc(nodes * sizeof(OPORT *));
+      if (!cpu_iport || !cpu_oport)
+         YS__errmsg("malloc failed in PktNetCreate");
+   }
+
+   for (i = 0; i < nodes; i++) {
+      net->inj[i] = 0.0;
+      net->ej[i] = 0.0;
+      net->iport[i] = iport_ptr[i] = NewIPort(i, p_size);
+      net->oport[i] = oport_ptr[i] = NewOPort(i, p_size);
+      if (oport_index[mesh_num] < 200)
+         OportTable[mesh_num][oport_index[mesh_num]++] = oport_ptr[i];
+      if (mesh_num == REPLY_NET) {
+         cpu_iport[i] = NewIPort(i, p_size);
+         cpu_oport[i] = NewOPort(i, p_size);
+      }
+   }
+}
+
+
+/*****************************************************************************/
+/* PktNetReserve: the head arrives at a channel at time t; wait until the    */
+/* channel is free, move through it, and hold it for the whole packet.       */
+/* Returns the time the head leaves the channel.                             */
+/*****************************************************************************/
+
+static double PktNetReserve(double *chan, double t, PACKET *pkt, double flitdelay)
+{
+   if (*chan > t) {
+      pkt->data.blktime += *chan - t;
+      t = *chan;
+   }
+   *chan = t + pkt->data.pktsize * flitdelay;
+   return t + flitdelay;
+}
+
+
+/*****************************************************************************/
+/* PktNetSend: called by PacketSend() in place of the head and tail events.  */
+/* The packet enters the network x time units from now.                      */
+/*****************************************************************************/
+
+void PktNetSend(PACKET *pkt, IPORT *port, double x, double flitdelay, double arbdelay)
+{
+   PKTNET  *net;
+   PKTXFER *xfer;
+   double  t, release;
+   int     i, mesh_num, src, dest, curr, radix, d, k, from, to, dir, n, hops;
+
+   src = pkt->data.srccpu;
+   dest = pkt->data.destcpu & 0x0fff;
+
+   for (mesh_num = 0; mesh_num < 2; mesh_num++)
+      if (PktNets[mesh_num].iport && src < PktNets[mesh_num].nodes &&
+          PktNets[mesh_num].iport[src] == port)
+         break;
+   if (mesh_num == 2) {
+      if (port != cpu_iport[src])
+         YS__errmsg("PktNetSend(): packet sent through an unknown port");
+      mesh_num = REPLY_NET;
+   }
+   net = &PktNets[mesh_num];
+   if (dest >= net->nodes)
+      YS__errmsg("PktNetSend(): destination node out of range");
+
+   /* Injection: the packet moves out of the iport into the network */
+
+   t = PktNetReserve(&net->inj[src], YS__Simtime + x, pkt, flitdelay);
+   release = net->inj[src];
+   if (mesh_num == REPLY_NET)       /* extra mux ahead of the processor demux */
+      t += arbdelay;
+
+   /* Route in the highest dimension first, as MeshRoute() does */
+
+   hops = 0;
+   curr = src / net->conc;
+   radix = net->routers;
+   for (d = net->dim - 1; d >= 0; d--) {
+      k = net->size[d];
+      radix /= k;
+      from = (curr / radix) % k;
+      to = (dest / net->conc / radix) % k;
+      if (from == to)
+         continue;
+      dir = from < to;
+      n = dir ? to - from : from - to;
+      if (net->topology == TORUS_NET) {
+         if (2*n > k) {         /* shorter the other way */
+            dir = !dir;
+            n = k - n;
+         }
+         else if (2*n == k)     /* a tie: both ways are n hops, go up */
+            dir = 1;
+      }
+      for (; n > 0; n--) {
+         t = PktNetReserve(&net->link[(curr * net->dim + d) * 2 + dir],
+                           t + arbdelay, pkt, flitdelay);
+         curr -= from * radix;
+         from = dir ? (from + 1) % k : (from + k - 1) % k;
+         curr += from * radix;
+         hops++;
+      }
+   }
+
+   /* Ejection: the packet moves from the last switch into the oport */
+
+   t = PktNetReserve(&net->ej[dest], t + arbdelay, pkt, flitdelay);
+
+   /* The flit model counts one hop per demux passed through */
+
+   pkt->data.num_hops = hops + (mesh_num == REPLY_NET ? 2 : 1);
+
+   if (PktXferFree == NULL) {
+      xfer = (PKTXFER *)malloc(PKTNET_CHUNK * sizeof(PKTXFER));
+      if (!xfer) YS__errmsg("malloc failed in PktNetSend");
+      for (i = 0; i < PKTNET_CHUNK; i++) {
+         xfer[i].ev = NewEvent("PktNet", YS__PktNetEvent, NODELETE, 0);
+         ActivitySetArg((ACTIVITY *)xfer[i].ev, (char *)&xfer[i], sizeof(PKTXFER));
+         xfer[i].next = PktXferFree;
+         PktXferFree = &xfer[i];
+      }
+   }
+   xfer = PktXferFree;
+   PktXferFree = xfer->next;
+
+   xfer->pkt = pkt;
+   xfer->oport = (pkt->data.destcpu & 0x1000) ? cpu_oport[dest] : net->oport[dest];
+   xfer->deliver = t + (pkt->data.pktsize - 1) * flitdelay;
+   pkt->headev = xfer->ev;
+   pkt->SleepingTail = NULL;
+
+   EventSetState(xfer->ev, PktNet_Release);
+   ActivitySchedTime((ACTIVITY *)xfer->ev, release - YS__Simtime, INDEPENDENT);
+}
+
+
+/*****************************************************************************/
+/* YS__PktNetEvent: frees the iport once the tail has left it, then puts     */
+/* the packet in its oport, waiting for oport space if necessary.            */
+/*****************************************************************************/
+
+void YS__PktNetEvent()
+{
+   PKTXFER *xfer;
+   PACKET  *pkt;
+   OPORT   *oport;
+
+   xfer = (PKTXFER *)ActivityGetArg(ME);
+   pkt = xfer->pkt;
+   oport = xfer->oport;
+
+   switch (EventGetState()) {
+
+      case PktNet_Release:
+
+         if (pkt->data.mesgptr) {            /* This packet associated with a mesg */
+            pkt->data.mesgptr->pktosend--;   /* One more packet of message sent    */
+            if (pkt->data.mesgptr->pktosend == 0 &&  /* This was the last packet  */
+                pkt->data.mesgptr->blockflag == BLOCK_UNTIL_SENT) /* Sender blocked */
+               ActivitySchedTime(pkt->data.mesgptr->source, 0.0, INDEPENDENT);
+         }
+         pkt->lastiport->qfree++;            /* One fewer packet in the port       */
+         SemaphoreSignal(pkt->lastiport->portrdy); /* One more free pkt position   */
+         pkt->lastiport = NULL;
+
+         EventReschedTime(xfer->deliver - YS__Simtime, PktNet_Deliver);
+         return;
+
+      case PktNet_Deliver:
+
+         if (SemaphoreValue(oport->freespace) > 0)
+            SemaphoreDecr(oport->freespace);
+         else {                              /* Output port full, wait for space   */
+            pkt->data.blktime -= YS__Simtime;
+            EventReschedSema(oport->freespace, PktNet_Enqueue);
+            return;
+         }
+         break;
+
+      case PktNet_Enqueue:
+
+         pkt->data.blktime += YS__Simtime;
+         break;
+   }
+
+   if (oport->count == 0)                    /* for utilization stats              */
+      oport->begin_util = YS__Simtime;
+   pkt->next = NULL;
+   if (oport->qhead == NULL) {
+      oport->qhead = pkt;
+      oport->qtail = pkt;
+   }
+   else {
+      oport->qtail->next = pkt;
+      oport->qtail = pkt;
+   }
+   oport->count++;
+   pkt->data.oporttime -= YS__Simtime;       /* Start counting time in oport       */
+   pkt->headev = NULL;
+
+   SemaphoreSignal(oport->pktavail);         /* Wake up a waiting receiver         */
+
+   xfer->next = PktXferFree;                 /* Event goes back to the pool        */
+   PktXferFree = xfer;
+}
@@ -62,6 +62,7 @@
 #include <malloc.h>
 
 #include <string.h>
+#include <stddef.h>
 
 /*****************************************************************************/
 /* POOL Operations: used to manage the allocation of memory used for         */
@@ -196,6 +197,13 @@ void YS__PoolReturnObj(POOL *pptr,void *optr)       /* Return an object to
        rptr->inuse=0;
        rptr->forward_to = -1;       
      }
+#ifndef POOL_AS_MALLOC
+   else if (pptr == &YS__PktPool) /* packets keep their head and tail events */
+     {
+       memset((char *)optr + sizeof(optr)*2, '\0',
+	      offsetof(PACKET, headobj) - sizeof(optr)*2);
+     }
+#endif
    else
      {
        memset((char *)optr + sizeof(optr)*2, '\0', pptr->objsize - sizeof(optr)*2);
@@ -62,6 +62,7 @@
 #include "MemSys/net.h"
 #include "MemSys/misc.h"
 #include "MemSys/arch.h"
+#include "MemSys/statout.h"
 #include "Processor/simio.h"
 #include <malloc.h>
 #include <string.h>
@@ -220,6 +221,10 @@ SMNET *NewSmnetSend(char *name, int node_num, int stat_level, rtfunc routing,
     smnetptr->reqQTStat = NewStatrec(name, POINT, MEANS, NOHIST, 0,0,0);
     sprintf(name,"ReplyQTim_%d",node_num);
     smnetptr->replyQTStat = NewStatrec(name, POINT, MEANS, NOHIST, 0,0,0);
+    StatrecSetUnit(smnetptr->reqQLStat,"messages");
+    StatrecSetUnit(smnetptr->replyQLStat,"messages");
+    StatrecSetUnit(smnetptr->reqQTStat,"cycles");
+    StatrecSetUnit(smnetptr->replyQTStat,"cycles");
   }
   return smnetptr;
 }
@@ -743,6 +748,10 @@ SMNET *NewSmnetRcv(name, node_num, stat_level, routing, Delays, ports_abv,
     smnetptr->reqQTStat = NewStatrec(name, POINT, MEANS, NOHIST, 0,0,0);
     sprintf(name,"ReplyQTim_%d",node_num);
     smnetptr->replyQTStat = NewStatrec(name, POINT, MEANS, NOHIST, 0,0,0);
+    StatrecSetUnit(smnetptr->reqQLStat,"messages");
+    StatrecSetUnit(smnetptr->replyQLStat,"messages");
+    StatrecSetUnit(smnetptr->reqQTStat,"cycles");
+    StatrecSetUnit(smnetptr->replyQTStat,"cycles");
   }
   return smnetptr;
 }
@@ -1216,6 +1225,26 @@ void SmnetStatClearAll()
 }
 
 
+/*****************************************************************************/
+/* SmnetStatOut :                                                            */
+/* Writes the message counts of a smnet module as structured records.        */
+/*****************************************************************************/
+
+static void SmnetStatOut (smnetptr)
+SMNET *smnetptr;
+{
+  if (StatOut == NULL)
+    return;
+  StatOutValue("messages","request",smnetptr->num_req,"count");
+  StatOutValue("messages","reply",smnetptr->num_rep,"count");
+  StatOutValue("messages","coherence",smnetptr->num_cohe,"count");
+  StatOutValue("messages","cohe_reply",smnetptr->num_cohe_rep,"count");
+  StatOutValue("message_sizes","word",smnetptr->num_sz_ref[SZ_WORD],"count");
+  StatOutValue("message_sizes","double",smnetptr->num_sz_ref[SZ_DBL],"count");
+  StatOutValue("message_sizes","line",smnetptr->num_sz_ref[SZ_BLK],"count");
+  StatOutValue("message_sizes","other",smnetptr->num_sz_ref[SZ_OTHER],"count");
+}
+
 /*****************************************************************************/
 /* SmnetSendStatReport :                                                     */
 /* Reports statistics of a smnet module.                                     */
@@ -1229,6 +1258,7 @@ SMNET *smnetptr;
   double szfr[NUM_SIZES];
   double  hitpr, util, lat;
 
+  StatOutScope("smnet",smnetptr->name);
   SMModuleStatReport(smnetptr , &hitpr, &lat, &util);
   gnum_ref [0] += smnetptr->num_ref;
   ghitpr [0] += hitpr; glat[0] +=lat; gutil [0] += util;
@@ -1266,6 +1296,7 @@ SMNET *smnetptr;
 	    smnetptr->num_sz_ref[SZ_DBL], szfr[SZ_DBL], 
 	    smnetptr->num_sz_ref[SZ_BLK], szfr[SZ_BLK], 
 	    smnetptr->num_sz_ref[SZ_OTHER], szfr[SZ_OTHER]);
+    SmnetStatOut(smnetptr);
   }
   
   if (smnetptr->stat_level > 2) {
@@ -1289,6 +1320,7 @@ SMNET *smnetptr;
   double szfr[NUM_SIZES];
   double  hitpr, util, lat;
 
+  StatOutScope("smnet",smnetptr->name);
   SMModuleStatReport(smnetptr , &hitpr, &lat, &util);
   gnum_ref [1] += smnetptr->num_ref;
   ghitpr [1] += hitpr; glat[1] +=lat; gutil [1] += util;
@@ -1324,6 +1356,7 @@ SMNET *smnetptr;
 	    smnetptr->num_sz_ref[SZ_DBL], szfr[SZ_DBL], 
 	    smnetptr->num_sz_ref[SZ_BLK], szfr[SZ_BLK], 
 	    smnetptr->num_sz_ref[SZ_OTHER], szfr[SZ_OTHER]);
+    SmnetStatOut(smnetptr);
   }
     
   if (smnetptr->stat_level > 2) {
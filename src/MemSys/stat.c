@@ -56,6 +56,7 @@
 #include "MemSys/simsys.h"
 #include "MemSys/misc.h"
 #include "MemSys/tr.stat.h"
+#include "MemSys/statout.h"
 #include "Processor/simio.h"
 #include <malloc.h>
 #include <string.h>
@@ -94,6 +95,7 @@ double  highbin;         /* Max of high histogram bin                        */
    srptr->id = YS__idctr++;
    strncpy(srptr->name,srname,31); /* copy its name */
    srptr->name[31] = '\0';
+   srptr->unit = NULL;
    srptr->meanflag = meanflg;
    srptr->sum = 0.0;
    srptr->sumsq = 0.0;
@@ -152,6 +154,15 @@ int i;                      /* New size                                      */
 
 /*****************************************************************************/
 
+void StatrecSetUnit(srptr,unit)  /* Sets the unit of the values, used only  */
+STATREC *srptr;                  /* by the structured statistics output     */
+const char *unit;                /* Unit name; kept, not copied             */
+{
+   srptr->unit = unit;
+}
+
+/*****************************************************************************/
+
 int YS__StatrecId(srptr)    /* Returns the system defined ID or 0 if
 			       TrID is 0        */
 STATREC *srptr;             /* Pointer to the statrec                        */
@@ -189,13 +200,36 @@ STATREC *srptr;                          /* Pointer to the statrec           */
 
 /*****************************************************************************/
 
+static int StatrecBin(srptr,v)           /* Returns the histogram bin for v  */
+STATREC *srptr;                          /* Pointer to the statrec           */
+double v;                                /* Value                            */
+{
+   /* Bin 0 holds values below LOWBIN, bin i values in
+      [LOWBIN+(i-1)*BININC, LOWBIN+i*BININC), and the last bin everything
+      else. The bins are of equal width, so the bin is found by division
+      and then nudged until it meets exactly the comparisons above, so
+      that rounding never puts a value in a different bin than a scan
+      of the bin bounds would.                                           */
+   int i, last = srptr->bins-1;
+   double x;
+
+   if (v < LOWBIN) return 0;
+   if (!(BININC > 0.0) || !(v >= LOWBIN)) return last; /* no bins, or NaN  */
+   x = (v - LOWBIN) / BININC + 1.0;
+   if (x >= (double)last) i = last;
+   else i = (int)x;
+   while (i > 1 && v < LOWBIN + (i-1)*BININC) i--;
+   while (i < last && !(v < LOWBIN + i*BININC)) i++;
+   return i;
+}
+
+/*****************************************************************************/
+
 void StatrecUpdate(srptr,v,t)            /* Updates a statrec                */
 STATREC *srptr;                          /* Pointer to the statrec           */
 double v;                                /* New value                        */
 double t;                                /* Weight or interval               */
 {
-   int i;
-
    PSDELAY;
 
    if (srptr->type == INTSTATTYPE) {   /* This is an interval statistics
@@ -215,11 +249,9 @@ double t;                                /* Weight or interval               */
             srptr->sumwt += srptr->interval;                
          }
          if (srptr->hist) {                                    /* Collect histograms  */
-            if (srptr->interval >= 0.0)  {                     /* Inteval is valid    */
-               for (i=0; i<srptr->bins-1; i++)                 /* Find the bin */
-                  if (srptr->lastv < LOWBIN + i*BININC) break; /* and increment it    */
-               srptr->hist[i] += srptr->interval;
-         }  }
+            if (srptr->interval >= 0.0)                        /* Inteval is valid    */
+               srptr->hist[StatrecBin(srptr,srptr->lastv)] += srptr->interval;
+         }
          if (v > srptr->maxval) srptr->maxval = v;
          if (v < srptr->minval) srptr->minval = v;
          srptr->lastv = v;     /* Remember last value & time to compute next interval */
@@ -239,11 +271,9 @@ double t;                                /* Weight or interval               */
          srptr->sumsq += t*v*v;
          srptr->sumwt += t;
       }
-      if (srptr->hist) {                      /* Collect histograms          */
-         for (i=0; i<srptr->bins-1; i++)      /* Find the bin                */
-           if (v < LOWBIN + i*BININC) break;  
-         srptr->hist[i] += t;                 /* and increment it            */
-      }
+      if (srptr->hist)                        /* Collect histograms          */
+         srptr->hist[StatrecBin(srptr,v)] += t;
+
       if (v > srptr->maxval) srptr->maxval = v;
       if (v < srptr->minval) srptr->minval = v;
       srptr->samples++;
@@ -265,6 +295,9 @@ STATREC *srptr;                          /* Pointer to the statrec
 
    PSDELAY;
 
+   if (StatOut)                      /* Also as structured records */
+     StatOutStatrec(srptr->name,srptr);
+
    if (srptr->type == PNTSTATTYPE) { /* This is a point statrec */
      fprintf(simout,"\nStatistics Record %s:\n",srptr->name);
      fprintf(simout,"   Number of samples = %d,   Max Value = %g,   Min Value = %g\n",
@@ -528,3 +561,80 @@ STATREC *srptr;                          /* Pointer to the statrec           */
 
    srptr->time1 = YS__Simtime;
 }
+
+/*****************************************************************************/
+/* STATCTR Operations: A per-cycle counter batches integer samples bound     */
+/* for a POINT statrec. Each update only adds its weight to a slot for the   */
+/* sample value; the slots are folded into the statrec, as if every sample   */
+/* had been given to StatrecUpdate, when StatctrFold is called. Fold before  */
+/* the statrec is reported, reset or otherwise read.                         */
+/*****************************************************************************/
+
+STATCTR *NewStatctr(srptr,maxval)        /* Creates a per-cycle counter      */
+STATREC *srptr;                          /* Statrec to fold the samples into */
+int maxval;                              /* Largest sample value batched     */
+{
+   STATCTR *ctr;
+
+   if (srptr->type != PNTSTATTYPE)
+      YS__errmsg("Per-cycle counters can only feed POINT statistics records");
+   if (maxval < 0) maxval = 0;
+
+   ctr = (STATCTR*)malloc(sizeof(STATCTR));
+   if (ctr == NULL) YS__errmsg("Malloc fails in NewStatctr");
+   ctr->sr = srptr;
+   ctr->maxval = maxval;
+   ctr->wt = (double*)calloc(maxval+1,sizeof(double));
+   ctr->n = (int*)calloc(maxval+1,sizeof(int));
+   if (ctr->wt == NULL || ctr->n == NULL) YS__errmsg("Malloc fails in NewStatctr");
+   ctr->pending = 0;
+   return ctr;
+}
+
+/*****************************************************************************/
+
+void StatctrFold(ctr)                    /* Folds batched samples into the statrec */
+STATCTR *ctr;                            /* Pointer to the counter           */
+{
+   STATREC *srptr = ctr->sr;
+   int v;
+   double t;
+
+   if (!ctr->pending)
+      return;
+   for (v = 0; v <= ctr->maxval; v++) {
+      if (ctr->n[v] == 0)
+         continue;
+      t = ctr->wt[v];
+      if (srptr->samples == 0) {         /* This is the first sample         */
+         srptr->maxval = v;
+         srptr->minval = v;
+      }
+      if (srptr->meanflag == MEANS) {    /* Same sums as n separate updates  */
+         srptr->sum += v*t;
+         srptr->sumsq += t*v*v;
+         srptr->sumwt += t;
+      }
+      if (srptr->hist)
+         srptr->hist[StatrecBin(srptr,(double)v)] += t;
+      if (v > srptr->maxval) srptr->maxval = v;
+      if (v < srptr->minval) srptr->minval = v;
+      srptr->samples += ctr->n[v];
+      ctr->wt[v] = 0.0;
+      ctr->n[v] = 0;
+   }
+   srptr->time1 = YS__Simtime;
+   ctr->pending = 0;
+}
+
+/*****************************************************************************/
+
+void StatctrReset(ctr)                   /* Discards batched samples         */
+STATCTR *ctr;                            /* Pointer to the counter           */
+{
+   if (ctr->pending) {
+      memset(ctr->wt,0,(ctr->maxval+1)*sizeof(double));
+      memset(ctr->n,0,(ctr->maxval+1)*sizeof(int));
+      ctr->pending = 0;
+   }
+}
@@ -0,0 +1,218 @@
+/*
+  statout.c
+
+  Structured statistics output. With -j, each statistic printed by the
+  report routines is also written to a separate file as a record with
+  named fields (see statout.h), either as JSON Lines or as CSV, so that
+  results can be read back without depending on the layout of the text
+  reports. The report routines set the phase, scope and module of the
+  records that follow with StatOutPhase and StatOutScope.
+
+  */
+/*****************************************************************************/
+/* This file is part of the RSIM Simulator.                                  */
+/*                                                                           */
+/******************************************************************************/
+/* University of Illinois/NCSA Open Source License                            */
+/*                                                                            */
+/* Copyright (c) 2002 The Board of Trustees of the University of Illinois and */
+/* William Marsh Rice University                                              */
+/*                                                                            */
+/* All rights reserved.                                                       */
+/*                                                                            */
+/* Developed by: Professor Sarita Adve's RSIM research group                  */
+/*               University of Illinois at Urbana-Champaign and William Marsh */
+/*                 Rice University                                            */
+/*               http://www.cs.uiuc.edu/rsim and                              */
+/*                 http://www.ece.rice.edu/~rsim/dist.html                    */
+/*                                                                            */
+/* Permission is hereby granted, free of charge, to any person obtaining a    */
+/* copy of this software and associated documentation files (the "Software"), */
+/* to deal with the Software without restriction, including without           */
+/* limitation the rights to use, copy, modify, merge, publish, distribute,    */
+/* sublicense, and/or sell copies of the Software, and to permit persons to   */
+/* whom the Software is furnished to do so, subject to the following          */
+/* conditions:                                                                */
+/*                                                                            */
+/*     * Redistributions of source code must retain the above copyright       */
+/* notice, this list of conditions and the following disclaimers.             */
+/*                                                                            */
+/*     * Redistributions in binary form must reproduce the above copyright    */
+/* notice, this list of conditions and the following disclaimers in the       */
+/* documentation and/or other materials provided with the distribution.       */
+/*                                                                            */
+/*     * Neither the names of Professor Sarita Adve's RSIM research group,    */
+/* the University of Illinois at Urbana-Champaign, William Marsh Rice         */
+/* University, nor the names of its contributors may be used to endorse or    */
+/* promote products derived from this Software without specific prior written */
+/* permission.                                                                */
+/*                                                                            */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    */
+/* THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR  */
+/* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,      */
+/* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR      */
+/* OTHER DEALINGS WITH THE SOFTWARE.                                          */
+/******************************************************************************/
+
+#include <string.h>
+#include <math.h>
+#include "MemSys/simsys.h"
+#include "MemSys/statout.h"
+#include "Processor/simio.h"
+
+FILE *StatOut = NULL;
+
+static int  StatOutCSV = 0;                 /* CSV rather than JSON Lines */
+static char StatOutScopeName[16] = "";      /* context of later records  */
+static char StatOutModuleName[40] = "";
+static int  StatOutPhaseNum = 0;
+
+/*****************************************************************************/
+/* StatOutOpen: start writing records to the named file                      */
+/*****************************************************************************/
+
+void StatOutOpen(fname)
+const char *fname;
+{
+   int l = strlen(fname);
+
+   StatOut = fopen(fname,"w");
+   if (StatOut == NULL) {
+      fprintf(simerr,"Unable to open statistics output file %s\n",fname);
+      return;
+   }
+   StatOutCSV = (l > 4 && strcmp(fname+l-4,".csv") == 0);
+   if (StatOutCSV)
+      fprintf(StatOut,"time,phase,scope,module,stat,field,value,unit\n");
+}
+
+/*****************************************************************************/
+/* StatOutPhase, StatOutScope: set the phase, scope and module of the        */
+/* records that follow                                                       */
+/*****************************************************************************/
+
+void StatOutPhase(phase)
+int phase;
+{
+   StatOutPhaseNum = phase;
+}
+
+void StatOutScope(scope, module)
+const char *scope;
+const char *module;
+{
+   strncpy(StatOutScopeName,scope,sizeof(StatOutScopeName)-1);
+   strncpy(StatOutModuleName,module,sizeof(StatOutModuleName)-1);
+}
+
+/*****************************************************************************/
+/* StatOutString: write a string field, quoted for JSON or CSV               */
+/*****************************************************************************/
+
+static void StatOutString(s)
+const char *s;
+{
+   putc('"',StatOut);
+   for (; *s; s++) {
+      if (StatOutCSV) {
+         if (*s == '"') putc('"',StatOut);
+         putc(*s,StatOut);
+      }
+      else if (*s == '"' || *s == '\\') {
+         putc('\\',StatOut);
+         putc(*s,StatOut);
+      }
+      else if ((unsigned char)*s < ' ')
+         fprintf(StatOut,"\\u%04x",(unsigned char)*s);
+      else
+         putc(*s,StatOut);
+   }
+   putc('"',StatOut);
+}
+
+/*****************************************************************************/
+/* StatOutValue: write one record                                            */
+/*****************************************************************************/
+
+void StatOutValue(stat, field, v, unit)
+const char *stat;
+const char *field;
+double v;
+const char *unit;
+{
+   if (StatOut == NULL)
+      return;
+
+   if (StatOutCSV) {
+      fprintf(StatOut,"%.15g,%d,",YS__Simtime,StatOutPhaseNum);
+      StatOutString(StatOutScopeName);
+      putc(',',StatOut);
+      StatOutString(StatOutModuleName);
+      putc(',',StatOut);
+      StatOutString(stat);
+      putc(',',StatOut);
+      StatOutString(field);
+      putc(',',StatOut);
+      if (!isnan(v) && !isinf(v))
+         fprintf(StatOut,"%.15g",v);
+      putc(',',StatOut);
+      StatOutString(unit ? unit : "");
+   }
+   else {
+      fprintf(StatOut,"{\"time\":%.15g,\"phase\":%d,\"scope\":",
+              YS__Simtime,StatOutPhaseNum);
+      StatOutString(StatOutScopeName);
+      fprintf(StatOut,",\"module\":");
+      StatOutString(StatOutModuleName);
+      fprintf(StatOut,",\"stat\":");
+      StatOutString(stat);
+      fprintf(StatOut,",\"field\":");
+      StatOutString(field);
+      if (!isnan(v) && !isinf(v))
+         fprintf(StatOut,",\"value\":%.15g,\"unit\":",v);
+      else
+         fprintf(StatOut,",\"value\":null,\"unit\":");
+      StatOutString(unit ? unit : "");
+      putc('}',StatOut);
+   }
+   putc('\n',StatOut);
+}
+
+/*****************************************************************************/
+/* StatOutStatrec: write the sample count, mean, standard deviation, extreme */
+/* values and histogram of a statrec, in the unit given with StatrecSetUnit  */
+/*****************************************************************************/
+
+void StatOutStatrec(stat, srptr)
+const char *stat;
+STATREC *srptr;
+{
+   char field[16];
+   int i;
+
+   if (StatOut == NULL)
+      return;
+
+   StatOutValue(stat,"samples",(double)srptr->samples,"count");
+   if (srptr->meanflag == MEANS) {
+      StatOutValue(stat,"mean",StatrecMean(srptr),srptr->unit);
+      StatOutValue(stat,"stddev",StatrecSdv(srptr),srptr->unit);
+   }
+   if (srptr->samples) {
+      StatOutValue(stat,"min",srptr->minval,srptr->unit);
+      StatOutValue(stat,"max",srptr->maxval,srptr->unit);
+   }
+   if (srptr->hist) {
+      /* bin 0 is below binlow, bin i covers [binlow+(i-1)*binsize,
+         binlow+i*binsize), and the last bin everything above */
+      StatOutValue(stat,"binlow",StatrecLowBin(srptr),srptr->unit);
+      StatOutValue(stat,"binsize",StatrecBinSize(srptr),srptr->unit);
+      for (i = 0; i < srptr->bins; i++) {
+         sprintf(field,"bin%d",i);
+         StatOutValue(stat,field,srptr->hist[i],
+                      srptr->type == INTSTATTYPE ? "cycles" : "weight");
+      }
+   }
+}
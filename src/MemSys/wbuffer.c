@@ -59,6 +59,7 @@
 #include "MemSys/cache.h"
 #include "MemSys/module.h"
 #include "MemSys/net.h"
+#include "MemSys/statout.h"
 #include "Processor/simio.h"
 #include <malloc.h>
 
@@ -200,6 +201,14 @@ void WBufferStatReport(WBUFFER *wbufptr)
     fprintf(simout,"%s\tCoalescings: %d\tStalls\tFull: %d\tMAX_COAL: %d\tread_match: %d\n",
 	    wbufptr->name, wbufptr->coals,wbufptr->stall_wb_full,
 	    wbufptr->stall_coal_max,wbufptr->stall_read_match);
+    if (StatOut)
+      {
+	StatOutScope("wbuf",wbufptr->name);
+	STATOUT("coalescings",wbufptr->coals,"count");
+	StatOutValue("stalls","full",wbufptr->stall_wb_full,"count");
+	StatOutValue("stalls","MAX_COAL",wbufptr->stall_coal_max,"count");
+	StatOutValue("stalls","read_match",wbufptr->stall_read_match,"count");
+      }
 }
 
 /*****************************************************************************/
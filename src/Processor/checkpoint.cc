@@ -0,0 +1,284 @@
+/*
+  checkpoint.cc
+
+  Saves the architectural state of a uniprocessor simulation to a file
+  and restores it later in place of the normal ELF startup. This lets
+  long initialization phases be simulated once and then skipped.
+
+  A checkpoint is taken only at a fork or newphase trap executed while
+  there is still a single processor. At that point the pipeline has
+  been drained by the exception handler and the store queue is empty,
+  so the logical register files and the simulated memory image fully
+  describe the program. The memory system (caches, directories, MSHRs,
+  network) is not saved; a restored run starts with a cold memory
+  system at cycle 0. Host file descriptors opened by the application
+  and the simin read offset are not restored either.
+
+  */
+/*****************************************************************************/
+/* This file is part of the RSIM Simulator.                                  */
+/*                                                                           */
+/******************************************************************************/
+/* University of Illinois/NCSA Open Source License                            */
+/*                                                                            */
+/* Copyright (c) 2002 The Board of Trustees of the University of Illinois and */
+/* William Marsh Rice University                                              */
+/*                                                                            */
+/* All rights reserved.                                                       */
+/*                                                                            */
+/* Developed by: Professor Sarita Adve's RSIM research group                  */
+/*               University of Illinois at Urbana-Champaign and William Marsh */
+/*                 Rice University                                            */
+/*               http://www.cs.uiuc.edu/rsim and                              */
+/*                 http://www.ece.rice.edu/~rsim/dist.html                    */
+/*                                                                            */
+/* Permission is hereby granted, free of charge, to any person obtaining a    */
+/* copy of this software and associated documentation files (the "Software"), */
+/* to deal with the Software without restriction, including without           */
+/* limitation the rights to use, copy, modify, merge, publish, distribute,    */
+/* sublicense, and/or sell copies of the Software, and to permit persons to   */
+/* whom the Software is furnished to do so, subject to the following          */
+/* conditions:                                                                */
+/*                                                                            */
+/*     * Redistributions of source code must retain the above copyright       */
+/* notice, this list of conditions and the following disclaimers.             */
+/*                                                                            */
+/*     * Redistributions in binary form must reproduce the above copyright    */
+/* notice, this list of conditions and the following disclaimers in the       */
+/* documentation and/or other materials provided with the distribution.       */
+/*                                                                            */
+/*     * Neither the names of Professor Sarita Adve's RSIM research group,    */
+/* the University of Illinois at Urbana-Champaign, William Marsh Rice         */
+/* University, nor the names of its contributors may be used to endorse or    */
+/* promote products derived from this Software without specific prior written */
+/* permission.                                                                */
+/*                                                                            */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    */
+/* THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR  */
+/* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,      */
+/* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR      */
+/* OTHER DEALINGS WITH THE SOFTWARE.                                          */
+/******************************************************************************/
+
+
+#include "Processor/state.h"
+#include "Processor/instance.h"
+#include "Processor/mainsim.h"
+#include "Processor/checkpoint.h"
+#include "Processor/simio.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+
+extern "C"
+{
+#include "MemSys/simsys.h"
+#include "MemSys/associate.h"
+}
+
+extern int entry_pt;
+
+char *checkpoint_save_file = NULL;
+char *checkpoint_restore_file = NULL;
+
+#define CKPT_MAGIC     0x5253434b  /* "RSCK" */
+#define CKPT_VERSION   1
+#define CKPT_BYTEORDER 0x01020304
+#define CKPT_ENDPAGES  0xffffffff  /* terminates a list of saved pages */
+
+struct CheckpointHeader
+{
+  int magic;
+  int version;
+  int byteorder;		/* detects a checkpoint from another host */
+  int intsize;
+  int ninstrs;			/* num_instructions of the .dec file */
+  int pcbase;
+};
+
+/***********************************************************************/
+/* SavePages : write every page in [lo,hi) present in table, each one  */
+/*           : preceded by its page number; end with CKPT_ENDPAGES     */
+/***********************************************************************/
+
+static void SavePages(FILE *fp, PageMap *table,
+		      unsigned lo, unsigned hi)
+{
+  unsigned pg;
+  char *addr;
+  for (pg = lo; pg < hi; pg++)
+    {
+      if (table->lookup(pg,addr))
+	{
+	  fwrite((char *)&pg,sizeof(unsigned),1,fp);
+	  fwrite(addr,ALLOC_SIZE,1,fp);
+	}
+    }
+  pg = CKPT_ENDPAGES;
+  fwrite((char *)&pg,sizeof(unsigned),1,fp);
+}
+
+/***********************************************************************/
+/* RestorePages : read pages written by SavePages into table           */
+/***********************************************************************/
+
+static void RestorePages(FILE *fp, PageMap *table)
+{
+  unsigned pg;
+  while (fread((char *)&pg,sizeof(unsigned),1,fp) == 1)
+    {
+      if (pg == CKPT_ENDPAGES)
+	return;
+      char *chunk = (char *)malloc(ALLOC_SIZE);
+      if (chunk == NULL || fread(chunk,ALLOC_SIZE,1,fp) != 1)
+	break;
+      table->insert(pg,chunk);
+    }
+  fprintf(simerr,"Checkpoint file %s is truncated\n",checkpoint_restore_file);
+  exit(-1);
+}
+
+/***********************************************************************/
+/* CheckpointSave : called at a system trap with the pipeline drained; */
+/*                : dumps the program state and exits the simulator    */
+/***********************************************************************/
+
+int CheckpointSave(instance *inst, state *proc)
+{
+  int code = inst->code->aux2;
+  if (code != 13 && code != 35) // only fork and newphase are checkpoints
+    return 0;
+  if (state::numprocs != 1)
+    return 0;
+  if (proc->StoreQueue.NumItems() != 0)
+    {
+      fprintf(simerr,"Checkpoint skipped at trap %d: stores still outstanding\n",code);
+      return 0;
+    }
+
+  FILE *fp = fopen(checkpoint_save_file,"w");
+  if (fp == NULL)
+    {
+      fprintf(simerr,"Couldn't open checkpoint file %s\n",checkpoint_save_file);
+      exit(-1);
+    }
+
+  CheckpointHeader hdr;
+  hdr.magic = CKPT_MAGIC;
+  hdr.version = CKPT_VERSION;
+  hdr.byteorder = CKPT_BYTEORDER;
+  hdr.intsize = sizeof(int);
+  hdr.ninstrs = num_instructions;
+  hdr.pcbase = pcbase;
+  fwrite((char *)&hdr,sizeof(hdr),1,fp);
+
+  /* global address space bookkeeping */
+  fwrite((char *)&entry_pt,sizeof(int),1,fp);
+  fwrite((char *)&highsharedused,sizeof(unsigned),1,fp);
+
+  /* processor state -- restart at the trap so that it executes again */
+  int pc = inst->pc, npc = inst->pc+1;
+  fwrite((char *)&pc,sizeof(int),1,fp);
+  fwrite((char *)&npc,sizeof(int),1,fp);
+  fwrite((char *)&proc->cwp,sizeof(int),1,fp);
+  fwrite((char *)&proc->CANSAVE,sizeof(int),1,fp);
+  fwrite((char *)&proc->CANRESTORE,sizeof(int),1,fp);
+  fwrite((char *)&proc->privstate,sizeof(int),1,fp);
+  fwrite((char *)&proc->trappc,sizeof(int),1,fp);
+  fwrite((char *)&proc->trapnpc,sizeof(int),1,fp);
+  fwrite((char *)&proc->MEMSYS,sizeof(int),1,fp);
+  fwrite((char *)&proc->highheap,sizeof(unsigned),1,fp);
+  fwrite((char *)&proc->lowstack,sizeof(unsigned),1,fp);
+  fwrite((char *)proc->logical_int_reg_file,sizeof(proc->logical_int_reg_file),1,fp);
+  fwrite((char *)proc->logical_fp_reg_file,sizeof(proc->logical_fp_reg_file),1,fp);
+
+  /* memory image: heap/data, stack, then the shared segment */
+  SavePages(fp,&proc->PageTable,0,UP_TO_PAGE(proc->highheap)/ALLOC_SIZE);
+  SavePages(fp,&proc->PageTable,proc->lowstack/ALLOC_SIZE,lowshared/ALLOC_SIZE);
+  SavePages(fp,SharedPageTable,lowshared/ALLOC_SIZE,
+	    UP_TO_PAGE(highsharedused)/ALLOC_SIZE);
+
+  /* home node and coherence assignments made so far */
+  AssociateSave(fp);
+
+  if (fclose(fp) != 0)
+    {
+      fprintf(simerr,"Error writing checkpoint file %s\n",checkpoint_save_file);
+      exit(-1);
+    }
+  fprintf(simerr,"Checkpoint written to %s at cycle %d\n",
+	  checkpoint_save_file,proc->curr_cycle);
+  exit(0);
+  return 1;
+}
+
+/***********************************************************************/
+/* CheckpointRestore : replaces startup(); loads a checkpoint into     */
+/*                   : the (single) processor proc                     */
+/***********************************************************************/
+
+int CheckpointRestore(state *proc)
+{
+  FILE *fp = fopen(checkpoint_restore_file,"r");
+  if (fp == NULL)
+    {
+      fprintf(simerr,"Couldn't open checkpoint file %s\n",checkpoint_restore_file);
+      return -1;
+    }
+
+  CheckpointHeader hdr;
+  if (fread((char *)&hdr,sizeof(hdr),1,fp) != 1 ||
+      hdr.magic != CKPT_MAGIC || hdr.version != CKPT_VERSION)
+    {
+      fprintf(simerr,"%s is not an RSIM checkpoint of this version\n",checkpoint_restore_file);
+      return -1;
+    }
+  if (hdr.byteorder != CKPT_BYTEORDER || hdr.intsize != sizeof(int))
+    {
+      fprintf(simerr,"Checkpoint %s was written on an incompatible host\n",checkpoint_restore_file);
+      return -1;
+    }
+  if (hdr.ninstrs != num_instructions)
+    {
+      fprintf(simerr,"Checkpoint %s does not match this application binary\n",checkpoint_restore_file);
+      return -1;
+    }
+  pcbase = hdr.pcbase;
+
+  int ok = 1;
+  ok &= fread((char *)&entry_pt,sizeof(int),1,fp);
+  ok &= fread((char *)&highsharedused,sizeof(unsigned),1,fp);
+  ok &= fread((char *)&proc->pc,sizeof(int),1,fp);
+  ok &= fread((char *)&proc->npc,sizeof(int),1,fp);
+  ok &= fread((char *)&proc->cwp,sizeof(int),1,fp);
+  ok &= fread((char *)&proc->CANSAVE,sizeof(int),1,fp);
+  ok &= fread((char *)&proc->CANRESTORE,sizeof(int),1,fp);
+  ok &= fread((char *)&proc->privstate,sizeof(int),1,fp);
+  ok &= fread((char *)&proc->trappc,sizeof(int),1,fp);
+  ok &= fread((char *)&proc->trapnpc,sizeof(int),1,fp);
+  ok &= fread((char *)&proc->MEMSYS,sizeof(int),1,fp);
+  ok &= fread((char *)&proc->highheap,sizeof(unsigned),1,fp);
+  ok &= fread((char *)&proc->lowstack,sizeof(unsigned),1,fp);
+  ok &= fread((char *)proc->logical_int_reg_file,sizeof(proc->logical_int_reg_file),1,fp);
+  ok &= fread((char *)proc->logical_fp_reg_file,sizeof(proc->logical_fp_reg_file),1,fp);
+  if (!ok)
+    {
+      fprintf(simerr,"Checkpoint file %s is truncated\n",checkpoint_restore_file);
+      return -1;
+    }
+
+  RestorePages(fp,&proc->PageTable);
+  RestorePages(fp,&proc->PageTable);
+  RestorePages(fp,SharedPageTable);
+  AssociateRestore(fp);
+  fclose(fp);
+
+  /* copy the logical registers into the physical file and reset mappers */
+  reset_lists(proc);
+
+  fprintf(simerr,"Restored checkpoint %s\n\n",checkpoint_restore_file);
+  return 0;
+}
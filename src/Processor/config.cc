@@ -60,6 +60,7 @@
 
 extern "C"
 {
+#include "MemSys/simsys.h"
 #include "MemSys/module.h"
 #include "MemSys/cache.h"
 #include "MemSys/arch.h"
@@ -77,12 +78,20 @@ static void ConfigureBusWidth(void *,char *);
 static void ConfigureProt(void *,char *);
 static void ConfigureCacheType(void *,char *);
 static void ConfigureBPBType(void *,char *);
+static void ConfigureEventList(void *,char *);
+static void ConfigureNetModel(void *,char *);
+static void ConfigureNetTopology(void *,char *);
+static void ConfigureNetRouting(void *,char *);
+static void ConfigureDirType(void *,char *);
+static void ConfigureDirRepl(void *,char *);
 
 int ALU_UNITS=2;
 int FPU_UNITS=2;
 int ADDR_UNITS=2;
 int MEM_UNITS=L1_DEFAULT_NUM_PORTS;
 
+static int EVENTLIST_type=CALQUE;
+
 /************************************************************************/
 /* ParseConfigFile: parse the input file passed in for each of the      */
 /* parameter types and call the function specified to determine how     */
@@ -121,6 +130,12 @@ void ParseConfigFile()
     {"linesize",&ARCH_linesz,ConfigureInt},
     {"wbufsize",&ARCH_wbufsz,ConfigureInt},
     {"dirbufsize",&ARCH_dirbufsz,ConfigureInt},
+    {"dirtype",&ARCH_dirtype,ConfigureDirType}, /* reads a string */
+    {"dirpointers",&DIR_POINTERS,ConfigureInt},
+    {"dircoarseness",&DIR_COARSENESS,ConfigureInt},
+    {"dirsets",&DIR_SETS,ConfigureInt},
+    {"dirassoc",&DIR_ASSOC,ConfigureInt},
+    {"dirrepl",&DIR_REPL,ConfigureDirRepl}, /* reads a string */
     {"l1size",&ARCH_cacsz1,ConfigureInt},
     {"l1assoc",&ARCH_setsz1,ConfigureInt},
     {"l1ports",&L1_NUM_PORTS,ConfigureL1Ports}, /* separate since multiple variables must be set */
@@ -136,6 +151,9 @@ void ParseConfigFile()
     {"flitsize",&ARCH_flitsz,ConfigureInt},
     {"netbufsize",&ARCH_NetBufsz,ConfigureInt},
     {"netportsize",&ARCH_NetPortsz,ConfigureInt},
+    {"netmodel",&NetModel,ConfigureNetModel}, /* reads a string */
+    {"nettopology",&ARCH_nettype,ConfigureNetTopology}, /* reads a string */
+    {"netrouting",&NetRouting,ConfigureNetRouting}, /* reads a string */
     {"ccprot",&CCProtocol,ConfigureProt}, /* reads a string */
     {"meminterleaving",&INTERLEAVING_FACTOR,ConfigureInt},
     {"dircycle",&DIRCYCLE,ConfigureDoubleInt}, /* sets a double */
@@ -188,7 +206,8 @@ void ParseConfigFile()
     {"portszl2buscr",&portszl2buscr,ConfigureInt},
     {"portszbusother",&portszbusother,ConfigureInt},
     {"portszdir",&portszdir,ConfigureInt},
-#define NUM_CONFIG_ENTRIES 72 /* This parameter must be set correctly */
+    {"eventlist",&EVENTLIST_type,ConfigureEventList},
+#define NUM_CONFIG_ENTRIES 82 /* This parameter must be set correctly */
   };
 
   char buf1[1000], buf2[1000];
@@ -289,3 +308,96 @@ static void ConfigureBPBType(void *dp, char *s)
     }
 }
 
+static void ConfigureEventList(void *dp, char *s)
+{
+  if (strcasecmp(s,"calendar") == 0)
+    *((int *)dp) = CALQUE;
+  else if (strcasecmp(s,"linear") == 0)
+    *((int *)dp) = LINQUE;
+  else if (strcasecmp(s,"wheel") == 0)
+    *((int *)dp) = TIMEWHEEL;
+  else
+    {
+      fprintf(simerr,"Unknown event list type %s\n",s);
+      exit(1);
+    }
+  if (EventListSize() != 0)
+    {
+      fprintf(simerr,"Event list type must be set before any events are scheduled\n");
+      exit(1);
+    }
+  EventListSelect(*((int *)dp),0,0.0);
+}
+
+static void ConfigureNetModel(void *dp, char *s)
+{
+  if (strcasecmp(s,"flit") == 0)
+    *((int *)dp) = FLIT_NETMODEL;
+  else if (strcasecmp(s,"packet") == 0)
+    *((int *)dp) = PACKET_NETMODEL;
+  else
+    {
+      fprintf(simerr,"Unknown network model %s\n",s);
+      exit(1);
+    }
+}
+
+static void ConfigureNetTopology(void *dp, char *s)
+{
+  if (strcasecmp(s,"mesh") == 0)
+    *((int *)dp) = MESH_NET;
+  else if (strcasecmp(s,"torus") == 0)
+    *((int *)dp) = TORUS_NET;
+  else if (strcasecmp(s,"cmesh") == 0)
+    *((int *)dp) = CMESH_NET;
+  else
+    {
+      fprintf(simerr,"Unknown network topology %s\n",s);
+      exit(1);
+    }
+}
+
+static void ConfigureNetRouting(void *dp, char *s)
+{
+  if (strcasecmp(s,"dor") == 0)
+    *((int *)dp) = DOR_ROUTING;
+  else if (strcasecmp(s,"westfirst") == 0)
+    *((int *)dp) = WESTFIRST_ROUTING;
+  else if (strcasecmp(s,"oddeven") == 0)
+    *((int *)dp) = ODDEVEN_ROUTING;
+  else
+    {
+      fprintf(simerr,"Unknown network routing %s\n",s);
+      exit(1);
+    }
+}
+
+static void ConfigureDirType(void *dp, char *s)
+{
+  if (strcasecmp(s,"fullmap") == 0)
+    *((int *)dp) = CNTRL_FULL_MAP;
+  else if (strcasecmp(s,"limitedptr") == 0)
+    *((int *)dp) = CNTRL_LIMITED_PTR;
+  else if (strcasecmp(s,"coarsevector") == 0)
+    *((int *)dp) = CNTRL_COARSE_VEC;
+  else
+    {
+      fprintf(simerr,"Unknown directory type %s\n",s);
+      exit(1);
+    }
+}
+
+static void ConfigureDirRepl(void *dp, char *s)
+{
+  if (strcasecmp(s,"lru") == 0)
+    *((int *)dp) = LRU;
+  else if (strcasecmp(s,"fifo") == 0)
+    *((int *)dp) = FIFO;
+  else if (strcasecmp(s,"random") == 0)
+    *((int *)dp) = RANDOM;
+  else
+    {
+      fprintf(simerr,"Unknown directory replacement policy %s\n",s);
+      exit(1);
+    }
+}
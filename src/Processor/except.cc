@@ -157,7 +157,6 @@ int ExceptionHandler(int tag, state *proc)
   FlushActiveList(tag, proc);
   int post = proc->active_list->NumElements();
   StatrecUpdate(proc->except_flushed,double(pre-post),1.0);
-  int except_rate = NO_OF_EXCEPT_FLUSHES_PER_CYCLE;
 
 #ifdef COREFILE
   if(proc->curr_cycle > DEBUG_TIME)
@@ -188,11 +187,26 @@ int ExceptionHandler(int tag, state *proc)
     }
 #endif
   
+  return ProcessException(&icopy,proc,pre);
+}
+
+/*************************************************************************/
+/* ProcessException : Emulate the effect of an exception on architected  */
+/*                  : state once the pipeline has been flushed. "pre" is */
+/*                  : the number of instructions flushed, used to charge */
+/*                  : the flush delay. Also used by the functional       */
+/*                  : fast-forward engine, which has no pipeline.        */
+/*************************************************************************/
+
+int ProcessException(instance *inst, state *proc, int pre)
+{
+  int except_rate = NO_OF_EXCEPT_FLUSHES_PER_CYCLE;
+
   /* Let us look at the type of exception first */
-  switch(icopy.exception_code){
+  switch(inst->exception_code){
   case OK:
     /* No exception, we should not have come here */
-    fprintf(simerr, "ERROR -- P%d(%d) @ %d, exception flagged when none!\n",proc->proc_id,icopy.tag,proc->curr_cycle);
+    fprintf(simerr, "ERROR -- P%d(%d) @ %d, exception flagged when none!\n",proc->proc_id,inst->tag,proc->curr_cycle);
 #ifdef COREFILE
     fprintf(corefile, "ERROR, exception flagged when none!\n");
 #endif
@@ -207,14 +221,14 @@ int ExceptionHandler(int tag, state *proc)
        Let real errors fall through to the next case without a break, since
        the next case handles non-returnable fatal errors*/
     {
-      unsigned addr = icopy.addr;
+      unsigned addr = inst->addr;
       if (addr < lowshared)
 	{
 	  if (addr < proc->highheap)
 	    {
 #ifdef COREFILE
 	      if (YS__Simtime > DEBUG_TIME)
-		fprintf(corefile,"Heap overrun with exception on %d\n",icopy.tag);
+		fprintf(corefile,"Heap overrun with exception on %d\n",inst->tag);
 #endif
 	      /* fall through since this is a regular seg fault */
 	    }
@@ -222,7 +236,7 @@ int ExceptionHandler(int tag, state *proc)
 	    {
 #ifdef COREFILE
 	      if (YS__Simtime > DEBUG_TIME)
-		fprintf(corefile,"Stack request exceeds MAXSTACKSIZE for exception on %d\n",icopy.tag);
+		fprintf(corefile,"Stack request exceeds MAXSTACKSIZE for exception on %d\n",inst->tag);
 #endif
 	      /* fall through since this is a regular seg fault */
 	    }
@@ -230,14 +244,14 @@ int ExceptionHandler(int tag, state *proc)
 	    {
 #ifdef COREFILE
 	      if (YS__Simtime > DEBUG_TIME)
-		fprintf(corefile,"Growing stack for exception on %d\n",icopy.tag);
+		fprintf(corefile,"Growing stack for exception on %d\n",inst->tag);
 #endif
 	      if (except_rate != 0)
 		proc->DELAY = pre / except_rate;
 	      StackTrapHandle(addr,proc);
 	      /* now we can restart from this instruction itself */
 	      reset_lists(proc);
-	      proc->pc = icopy.pc; // we need to restart the instruction
+	      proc->pc = inst->pc; // we need to restart the instruction
 	      proc->npc = proc->pc+1;
 	      break;
 	    }
@@ -248,7 +262,7 @@ int ExceptionHandler(int tag, state *proc)
 	   definitely a regular seg fault*/
 #ifdef COREFILE
 	  if (YS__Simtime > DEBUG_TIME)
-	    fprintf(corefile,"SEGV in shared region tag %d\n",icopy.tag);
+	    fprintf(corefile,"SEGV in shared region tag %d\n",inst->tag);
 #endif
 	  /* fall through */
 	}
@@ -263,7 +277,7 @@ int ExceptionHandler(int tag, state *proc)
     /* Non returnable error */
     if (except_rate != 0)
       proc->DELAY = pre / except_rate;
-    FatalException(&icopy,proc);
+    FatalException(inst,proc);
     return -1;
     break;
   case BUSERR:
@@ -273,8 +287,8 @@ int ExceptionHandler(int tag, state *proc)
     // The latter case is expected to be rare, but must be supported.
     if (except_rate != 0)
       proc->DELAY = pre / except_rate;
-    if (((icopy.addr & (mem_length[icopy.code->instruction]-1) != 0)) &&
-	((icopy.addr & (mem_align[icopy.code->instruction]-1) == 0)))
+    if (((inst->addr & (mem_length[inst->code->instruction]-1) != 0)) &&
+	((inst->addr & (mem_align[inst->code->instruction]-1) == 0)))
       {
 	/* Properly handling such unaligned accesses would need more
 	   complicated memory simulation, may cause multiple cache
@@ -283,25 +297,25 @@ int ExceptionHandler(int tag, state *proc)
 	   difficult to simulate... */
 
 	fprintf(simerr,"Misaligned instruction trap\n");
-	instr_func[icopy.code->instruction](&icopy,proc); /* just do the data update and run...*/
+	instr_func[inst->code->instruction](inst,proc); /* just do the data update and run...*/
 	
-	if (icopy.code->instruction == iLDDF)
-	  proc->physical_fp_reg_file[icopy.lrd] =
-	    proc->logical_fp_reg_file[icopy.lrd] = icopy.rs1valf;
-	else if (icopy.code->instruction == iLDQF) /* fix later */
-	  proc->physical_fp_reg_file[icopy.lrd] =
-	    proc->logical_fp_reg_file[icopy.lrd] = icopy.rs1valf;
+	if (inst->code->instruction == iLDDF)
+	  proc->physical_fp_reg_file[inst->lrd] =
+	    proc->logical_fp_reg_file[inst->lrd] = inst->rs1valf;
+	else if (inst->code->instruction == iLDQF) /* fix later */
+	  proc->physical_fp_reg_file[inst->lrd] =
+	    proc->logical_fp_reg_file[inst->lrd] = inst->rs1valf;
 
 	/* STDF etc don't actually change the reg. file, so nothing
 	   to do there... */
 	
-	proc->pc = icopy.npc; // go on to next instruction
+	proc->pc = inst->npc; // go on to next instruction
 	proc->npc = proc->pc+1;
 	break;
       }
     else
       {
-	FatalException(&icopy,proc);
+	FatalException(inst,proc);
 	return -1;
       }
     break;
@@ -310,9 +324,9 @@ int ExceptionHandler(int tag, state *proc)
     if (except_rate != 0)
       proc->DELAY = pre / except_rate;
     reset_lists(proc);
-    proc->pc = icopy.npc; // in this case, we don't restart this instruction
+    proc->pc = inst->npc; // in this case, we don't restart this instruction
     proc->npc = proc->pc+1;
-    SysTrapHandle(&icopy,proc);
+    SysTrapHandle(inst,proc);
     break;
   case SOFT_SL_REPL:
     proc->sl_repl_soft_exceptions++;
@@ -330,20 +344,20 @@ int ExceptionHandler(int tag, state *proc)
     if (soft_rate != 0)
       proc->DELAY = pre / soft_rate;
     reset_lists(proc);
-    proc->pc = icopy.pc; // we need to restart the instruction
-    proc->npc = icopy.npc; 
+    proc->pc = inst->pc; // we need to restart the instruction
+    proc->npc = inst->npc; 
     break;
   case SERIALIZE:
     if (except_rate != 0)
       proc->DELAY = pre / except_rate;
     reset_lists(proc);
-    if (ProcessSerializedInstruction(&icopy,proc))
+    if (ProcessSerializedInstruction(inst,proc))
       /* if it returns non-zero,then it has set the PC as it desires */
       {
       }
     else
       {
-	proc->pc = icopy.npc; // don't restart the instruction separately
+	proc->pc = inst->npc; // don't restart the instruction separately
 	proc->npc = proc->pc + 1;
       }
     break;
@@ -351,10 +365,10 @@ int ExceptionHandler(int tag, state *proc)
     if (except_rate != 0)
       proc->DELAY = pre / except_rate;
     reset_lists(proc);
-    if (icopy.code->wpchange < 0) // save
-      TrapTableHandle(&icopy,proc, TRAP_OVERFLOW);
+    if (inst->code->wpchange < 0) // save
+      TrapTableHandle(inst,proc, TRAP_OVERFLOW);
     else // restore
-      TrapTableHandle(&icopy,proc, TRAP_UNDERFLOW);
+      TrapTableHandle(inst,proc, TRAP_UNDERFLOW);
       
      // TTH will set pc, save aside the old pc, etc.
     break;
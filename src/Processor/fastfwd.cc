@@ -0,0 +1,523 @@
+/*
+  fastfwd.cc
+
+  Functional fast-forward. With -s, every processor executes its
+  instructions one at a time straight off the logical register files,
+  without renaming, issue queues, or the memory hierarchy, until some
+  processor reaches the first newphase() marker. At that point all
+  processors switch to the detailed pipeline; the newphase trap itself
+  is left to the detailed pipeline so that statistics are reset in the
+  usual way.
+
+  Branches still train the branch predictor (the branch functions call
+  BPBComplete) and calls and returns maintain the return address
+  stack. Caches are NOT warmed: installing lines in the L1/L2 without
+  the directory having granted them would violate the coherence
+  protocol's invariants. A detailed warmup interval should be used
+  before measurements that are sensitive to cold caches.
+
+  The same engine drives statistical sampling (-b). Each processor
+  cycles through a fast-forward interval, a detailed warmup interval
+  and a measured detailed interval. At the end of a measured interval
+  fetch stops until the pipeline has drained and every graduated store
+  has issued; the logical register files are then exact, and the next
+  fast-forward interval starts from them.
+
+  */
+/*****************************************************************************/
+/* This file is part of the RSIM Simulator.                                  */
+/*                                                                           */
+/******************************************************************************/
+/* University of Illinois/NCSA Open Source License                            */
+/*                                                                            */
+/* Copyright (c) 2002 The Board of Trustees of the University of Illinois and */
+/* William Marsh Rice University                                              */
+/*                                                                            */
+/* All rights reserved.                                                       */
+/*                                                                            */
+/* Developed by: Professor Sarita Adve's RSIM research group                  */
+/*               University of Illinois at Urbana-Champaign and William Marsh */
+/*                 Rice University                                            */
+/*               http://www.cs.uiuc.edu/rsim and                              */
+/*                 http://www.ece.rice.edu/~rsim/dist.html                    */
+/*                                                                            */
+/* Permission is hereby granted, free of charge, to any person obtaining a    */
+/* copy of this software and associated documentation files (the "Software"), */
+/* to deal with the Software without restriction, including without           */
+/* limitation the rights to use, copy, modify, merge, publish, distribute,    */
+/* sublicense, and/or sell copies of the Software, and to permit persons to   */
+/* whom the Software is furnished to do so, subject to the following          */
+/* conditions:                                                                */
+/*                                                                            */
+/*     * Redistributions of source code must retain the above copyright       */
+/* notice, this list of conditions and the following disclaimers.             */
+/*                                                                            */
+/*     * Redistributions in binary form must reproduce the above copyright    */
+/* notice, this list of conditions and the following disclaimers in the       */
+/* documentation and/or other materials provided with the distribution.       */
+/*                                                                            */
+/*     * Neither the names of Professor Sarita Adve's RSIM research group,    */
+/* the University of Illinois at Urbana-Champaign, William Marsh Rice         */
+/* University, nor the names of its contributors may be used to endorse or    */
+/* promote products derived from this Software without specific prior written */
+
+
+#include "Processor/state.h"
+#include "Processor/instance.h"
+#include "Processor/mainsim.h"
+#include "Processor/exec.h"
+#include "Processor/active.h"
+#include "Processor/units.h"
+#include "Processor/memory.h"
+#include "Processor/branchq.h"
+#include "Processor/traps.h"
+#include "Processor/fastfwd.h"
+#include "Processor/simio.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern "C"
+{
+#include "MemSys/simsys.h"
+}
+
+int fast_forward = 0;
+long long ff_instructions = 0;
+
+int sampling = 0;
+int sample_ff = 0, sample_warm = 0, sample_measure = 0;
+
+extern state *AllProcs[];
+extern unsigned GetAddr(instance *);
+
+static instance ffinst; /* reused for every fast-forwarded instruction */
+static instr TheBadPC(iSETHI); /* as in pipestages.cc */
+
+/*************************************************************************/
+/* FFDecode : fill in inst for instrn at the current pc; the functional  */
+/*          : counterpart of instance::decode_instruction. Logical and   */
+/*          : physical register numbers are the same here.              */
+/*************************************************************************/
+
+static void FFDecode(instance *inst, instr *instrn, state *proc)
+{
+  inst->code = instrn;
+  inst->unit_type = unit[instrn->instruction];
+  inst->tag = proc->instruction_count;
+  inst->pc = proc->pc;
+  inst->npc = proc->npc;
+  inst->win_num = proc->cwp;
+
+  inst->addr = 0;
+  inst->addrdep = 0;
+  inst->newpc = 0;
+  inst->exception_code = OK;
+  inst->mispredicted = inst->annulled = inst->taken = 0;
+  inst->memprogress = 0;
+  inst->global_perform = 0;
+  inst->miss = mtL1HIT;
+  inst->rs1valf = inst->rs2valf = 0;
+  inst->rsccvali = 0;
+  inst->rsdvalf = 0;
+  inst->rccvali = inst->rdvali = 0;
+
+  switch (instrn->rs1_regtype)
+    {
+    case REG_INT:
+    case REG_INT64:
+      inst->lrs1 = convert_to_logical(inst->win_num, instrn->rs1);
+      break;
+    case REG_FP:
+    case REG_FPHALF:
+      inst->lrs1 = instrn->rs1;
+      break;
+    case REG_INTPAIR:
+      if (instrn->rs1 & 1) /* odd source reg. */
+	{
+	  inst->exception_code = ILLEGAL;
+	  inst->lrs1 = 0;
+	}
+      else
+	inst->lrs1 = convert_to_logical(inst->win_num, instrn->rs1);
+      break;
+    default:
+      break;
+    }
+
+  switch (instrn->rs2_regtype)
+    {
+    case REG_INT:
+    case REG_INT64:
+      inst->lrs2 = convert_to_logical(inst->win_num, instrn->rs2);
+      break;
+    case REG_FP:
+    case REG_FPHALF:
+      inst->lrs2 = instrn->rs2;
+      break;
+    default:
+      break;
+    }
+
+  inst->lrscc = convert_to_logical(inst->win_num, instrn->rscc);
+  if (instrn->rd_regtype == REG_FPHALF)
+    inst->lrsd = instrn->rd;
+
+  inst->prs1 = inst->lrs1;	/* only for FatalException messages */
+  inst->prs2 = inst->lrs2;
+
+  /* Sources see the old window, destinations the new one */
+  int dests = 1;
+  if (instrn->wpchange == WPC_SAVE)
+    {
+      if (proc->CANSAVE || proc->privstate)
+	inst->win_num = unsigned(inst->win_num-1) & (NUM_WINS-1);
+      else
+	{
+	  inst->exception_code = WINTRAP;
+	  dests = 0;
+	}
+    }
+  else if (instrn->wpchange == WPC_RESTORE)
+    {
+      if (proc->CANRESTORE || proc->privstate)
+	inst->win_num = unsigned(inst->win_num+1) & (NUM_WINS-1);
+      else
+	{
+	  inst->exception_code = WINTRAP;
+	  dests = 0;
+	}
+    }
+
+  inst->lrd = inst->lrcc = 0;
+  if (dests)
+    {
+      inst->lrcc = convert_to_logical(inst->win_num, instrn->rcc);
+      if (instrn->rd_regtype == REG_FP || instrn->rd_regtype == REG_FPHALF)
+	inst->lrd = instrn->rd;
+      else
+	inst->lrd = convert_to_logical(inst->win_num, instrn->rd);
+      if (instrn->rd_regtype == REG_INTPAIR && (instrn->rd & 1))
+	inst->exception_code = ILLEGAL; /* odd destination register */
+    }
+  inst->prd = inst->lrd;
+}
+
+/*************************************************************************/
+/* FFReadSources : read source operands from the logical register files */
+/*               : (the functional counterpart of SendToFU)             */
+/*************************************************************************/
+
+static void FFReadSources(instance *inst, state *proc)
+{
+  float *address;
+
+  switch (inst->code->rs1_regtype)
+    {
+    case REG_INT:
+      inst->rs1vali = proc->logical_int_reg_file[inst->lrs1];
+      break;
+    case REG_INT64:
+      inst->rs1valll = proc->logical_int_reg_file[inst->lrs1];
+      break;
+    case REG_FP:
+      inst->rs1valf = proc->logical_fp_reg_file[inst->lrs1];
+      break;
+    case REG_FPHALF:
+      address = (float *) (&proc->logical_fp_reg_file[unsigned(inst->lrs1)&~1U]);
+      if (inst->code->rs1 & 1) /* the odd half */
+	address += 1;
+      inst->rs1valfh = *address;
+      break;
+    case REG_INTPAIR:
+      inst->rs1valipair.a = proc->logical_int_reg_file[inst->lrs1];
+      inst->rs1valipair.b = proc->logical_int_reg_file[inst->lrs1+1];
+      break;
+    default:
+      fprintf(simerr,"Unexpected regtype\n");
+      exit(-1);
+    }
+
+  switch (inst->code->rs2_regtype)
+    {
+    case REG_INT:
+      inst->rs2vali = proc->logical_int_reg_file[inst->lrs2];
+      break;
+    case REG_INT64:
+      inst->rs2valll = proc->logical_int_reg_file[inst->lrs2];
+      break;
+    case REG_FP:
+      inst->rs2valf = proc->logical_fp_reg_file[inst->lrs2];
+      break;
+    case REG_FPHALF:
+      address = (float *) (&proc->logical_fp_reg_file[unsigned(inst->lrs2)&~1U]);
+      if (inst->code->rs2 & 1) /* the odd half */
+	address += 1;
+      inst->rs2valfh = *address;
+      break;
+    default:
+      fprintf(simerr,"Unexpected regtype\n");
+      exit(-1);
+    }
+
+  if (inst->code->rd_regtype == REG_FPHALF)
+    inst->rsdvalf = proc->logical_fp_reg_file[unsigned(inst->lrsd)&~1U];
+
+  inst->rsccvali = proc->logical_int_reg_file[inst->lrscc];
+}
+
+/*************************************************************************/
+/* FFWriteback : retire inst's results straight into the logical files   */
+/*             : (the functional counterpart of writeback + graduation)  */
+/*************************************************************************/
+
+static void FFWriteback(instance *inst, state *proc)
+{
+  float *address;
+
+  switch (inst->code->rd_regtype)
+    {
+    case REG_INT:
+    case REG_INT64:
+      if (inst->lrd != ZEROREG)
+	proc->logical_int_reg_file[inst->lrd] = inst->rdvali;
+      break;
+    case REG_FP:
+      proc->logical_fp_reg_file[inst->lrd] = inst->rdvalf;
+      break;
+    case REG_FPHALF:
+      proc->logical_fp_reg_file[unsigned(inst->lrd)&~1U] = inst->rsdvalf;
+      address = (float *) (&proc->logical_fp_reg_file[unsigned(inst->lrd)&~1U]);
+      if (inst->code->rd & 1) /* the odd half */
+	address += 1;
+      *address = inst->rdvalfh;
+      break;
+    case REG_INTPAIR:
+      if (inst->lrd != ZEROREG)
+	proc->logical_int_reg_file[inst->lrd] = inst->rdvalipair.a;
+      proc->logical_int_reg_file[inst->lrd+1] = inst->rdvalipair.b;
+      return; /* the pair takes the place of the cc destination */
+    default:
+      break;
+    }
+
+  if (inst->lrcc != ZEROREG)
+    proc->logical_int_reg_file[inst->lrcc] = inst->rccvali;
+}
+
+/*************************************************************************/
+/* FFNextPC : set pc and npc after a completed instruction, following    */
+/*          : the same delay slot and annulment rules as                 */
+/*          : decode_branch_instruction, but with the actual outcome     */
+/*************************************************************************/
+
+static void FFNextPC(instance *inst, state *proc, int target)
+{
+  instr *code = inst->code;
+
+  if (code->cond_branch)
+    {
+      /* inst->taken was 0 when executed, so a misprediction means taken */
+      int taken = inst->mispredicted;
+      if (code->annul == 0)
+	{
+	  proc->pc = inst->npc;
+	  proc->npc = taken ? target : inst->npc + 1;
+	}
+      else if (taken)
+	{
+	  proc->pc = inst->npc;
+	  proc->npc = target;
+	}
+      else
+	{
+	  proc->pc = inst->npc + 1; /* delay slot annulled */
+	  proc->npc = proc->pc + 1;
+	}
+    }
+  else if (code->uncond_branch)
+    {
+      if (code->annul == 0)
+	{
+	  proc->pc = inst->npc;
+	  proc->npc = target;
+	}
+      else
+	{
+	  proc->pc = target;
+	  proc->npc = proc->pc + 1;
+	}
+    }
+  else
+    {
+      proc->pc = inst->npc;
+      proc->npc = proc->pc + 1;
+    }
+}
+
+/*************************************************************************/
+/* EndFastForward : switch every processor to the detailed pipeline      */
+/*************************************************************************/
+
+static void EndFastForward(state *proc)
+{
+  fast_forward = 0;
+  for (int i = 0; i < state::numprocs; i++)
+    reset_lists(AllProcs[i]); /* physical files and mappers from logical */
+
+  fprintf(simerr,"P%d reached newphase: fast-forwarded %lld instructions in %d cycles; starting detailed simulation\n",
+	  proc->proc_id,ff_instructions,proc->curr_cycle);
+}
+
+/*************************************************************************/
+/* FastForward : functionally execute up to quantum instructions of proc */
+/*             : Called from RSIM_NodeCycle in place of maindecode.      */
+/*             : Returns 1 once fast-forward mode has ended.             */
+/*************************************************************************/
+
+int FastForward(state *proc, int quantum)
+{
+  instance *inst = &ffinst;
+  instr *instrn;
+  int target;
+  int counting = !fast_forward && proc->sample_mode == SAMPLE_FF;
+
+  if (counting && quantum > proc->sample_left)
+    quantum = proc->sample_left;
+
+  while (quantum-- > 0 && !proc->exit)
+    {
+      if (proc->pc >= num_instructions || proc->pc < 0)
+	{
+	  if (proc->privstate && proc->pc >= TRAPTABLE_BASE &&
+	      (proc->pc - TRAPTABLE_BASE < TRAPTABLE_SIZE))
+	    instrn = trapstable + (proc->pc - TRAPTABLE_BASE);
+	  else
+	    {
+	      /* fatal in this mode, since nothing is speculative */
+	      instrn = &TheBadPC;
+	      FFDecode(inst,instrn,proc);
+	      inst->exception_code = BADPC;
+	      ProcessException(inst,proc,0);
+	      return 1;
+	    }
+	}
+      else
+	instrn = FetchInstr(proc->pc);
+
+      FFDecode(inst,instrn,proc);
+
+      if (fast_forward && instrn->instruction == iILLTRAP && instrn->aux2 == 35)
+	{
+	  /* newphase marker: leave pc on it for the detailed pipeline */
+	  EndFastForward(proc);
+	  return 1;
+	}
+
+      target = 0;
+      if (inst->exception_code == OK)
+	{
+	  FFReadSources(inst,proc);
+
+	  if (instrn->uncond_branch == 2 || instrn->uncond_branch == 3)
+	    {
+	      target = inst->pc + instrn->imm;
+	      if (instrn->uncond_branch == 3)
+		proc->RASInsert(inst->pc+2);
+	    }
+	  else if (instrn->uncond_branch == 4)
+	    inst->branch_pred = proc->RASPredict(); /* keep the RAS in step */
+	  else if (instrn->cond_branch)
+	    target = inst->pc + instrn->imm;
+
+	  if (inst->unit_type == uMEM)
+	    {
+	      inst->addr = GetAddr(inst);
+	      inst->finish_addr = inst->addr + mem_length[instrn->instruction] - 1;
+	      if (inst->exception_code == OK)
+		(*(instr_func[instrn->instruction]))(inst,proc);
+	    }
+	  else
+	    (*(instr_func[instrn->instruction]))(inst,proc);
+
+	  if (instrn->uncond_branch == 1 || instrn->uncond_branch == 4)
+	    target = inst->newpc;
+	}
+
+      ff_instructions++;
+      if (counting)
+	proc->sample_left--;
+
+      if (inst->exception_code != OK)
+	{
+	  /* The handlers expect the physical files to mirror the logical
+	     ones (reset_lists sees to that), and some of them write only
+	     the physical file, so copy back afterwards. */
+	  ProcessException(inst,proc,0);
+	  memcpy(proc->logical_int_reg_file,proc->physical_int_reg_file,
+		 NO_OF_LOGICAL_INT_REGISTERS*sizeof(int));
+	  memcpy(proc->logical_fp_reg_file,proc->physical_fp_reg_file,
+		 NO_OF_LOGICAL_FP_REGISTERS*sizeof(double));
+	  continue;
+	}
+
+      FFWriteback(inst,proc);
+
+      proc->cwp = inst->win_num;
+      if (instrn->wpchange && !proc->privstate)
+	{
+	  proc->CANSAVE += instrn->wpchange;
+	  proc->CANRESTORE -= instrn->wpchange;
+	}
+
+      FFNextPC(inst,proc,target);
+    }
+
+  return !fast_forward;
+}
+
+/*************************************************************************/
+/* SampleCycle : advance proc through fast-forward, warmup, measured and */
+/*             : drain intervals (-b). Called every cycle after the      */
+/*             : processor has run.                                      */
+/*************************************************************************/
+
+void SampleCycle(state *proc)
+{
+  int phase;
+
+  switch (proc->sample_mode)
+    {
+    case SAMPLE_FF:
+      if (fast_forward || proc->sample_left > 0)
+	return;
+      reset_lists(proc); /* pipeline starts from the logical state */
+      proc->sample_mode = SAMPLE_WARM;
+      proc->sample_mark = proc->graduates;
+      break;
+    case SAMPLE_WARM:
+      if (proc->graduates - proc->sample_mark < sample_warm)
+	return;
+      phase = proc->stats_phase;
+      proc->reset_stats();
+      proc->stats_phase = phase;
+      proc->sample_mode = SAMPLE_MEASURE;
+      break;
+    case SAMPLE_MEASURE:
+      if (proc->graduates < sample_measure)
+	return;
+      proc->record_sample();
+      proc->sample_mode = SAMPLE_DRAIN;
+      break;
+    case SAMPLE_DRAIN:
+      if (proc->active_list->NumElements() != 0 ||
+	  proc->ReadyUnissuedStores != 0 || proc->in_exception != NULL)
+	return;
+      reset_lists(proc);
+      proc->sample_mode = SAMPLE_FF;
+      proc->sample_left = sample_ff;
+      break;
+    default:
+      break;
+    }
+}
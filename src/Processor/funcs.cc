@@ -2267,50 +2267,61 @@ void fnFMOVRs(instance *inst, state *)
 /* GetMap : gets the UNIX address of the address accessed by memory      */
 /*          instruction. If no corresponding address, this access hasn't */
 /*          been accessed and is some sort of seg fault                  */
+/*          Pages found are remembered in the processor's software TLB   */
+/*          A write to a copy-on-write page first gets a private copy    */
 /*************************************************************************/
 
-unsigned GetMap(instance *inst, state *proc)
+char *GetMap(instance *inst, state *proc, int write)
 {
-  unsigned pa;
+  char *pa;
   unsigned addr = inst->addr;
+  unsigned pg = addr / ALLOC_SIZE;
+  TLBEntry *tlb = &proc->tlb[pg & (TLB_SIZE-1)];
+  int found;
+
+  if (tlb->pg == pg && (tlb->writable || !write))
+    return tlb->base+(addr&(ALLOC_SIZE-1));
   
   if (addr < lowshared)
+    /* look it up in regular page table. If failure, grow the stack */
+    found = proc->PageTable.lookup(pg,pa);
+  else
+    /* look it up in shared page table. If failure, it's an exception */
+    found = SharedPageTable->lookup(pg,pa);
+
+  if (!found)
     {
-      /* look it up in regular page table. If failure, grow the stack */
-      if (proc->PageTable.lookup(addr / ALLOC_SIZE,pa))
-	{ /* success */
-	  return pa+(addr&(ALLOC_SIZE-1));
-	}
-      else
-	{
-	  /* failure, mark a violation and try to grow the stack (if
-	     applicable) later */
-	  if (inst->code->instruction != iPREFETCH)
-	    inst->exception_code=SEGV;
-	  return 0;
-	  
-	}
+      /* failure, mark a violation and try to grow the stack (if
+	 applicable) later */
+      if (inst->code->instruction != iPREFETCH)
+	inst->exception_code=SEGV;
+      return 0;
     }
-  else
+
+  tlb->writable = addr >= lowshared || !proc->PageTable.IsShared(pg);
+  if (write && !tlb->writable)
     {
-      /* look it up in shared page table. If failure, it's an exception */
-      if (SharedPageTable->lookup(addr / ALLOC_SIZE,pa))
-	{ /* success */
-	  return pa+(addr&(ALLOC_SIZE-1));
-	}
-      else
+      /* page still shared with a forked process -- copy it now */
+      char *newpg = (char *)malloc(ALLOC_SIZE);
+      if (newpg == NULL)
 	{
-	  if (inst->code->instruction != iPREFETCH)
-	    inst->exception_code=SEGV;
-	  return 0;
+	  fprintf(simerr,"RSIM: Malloc out of space on copy-on-write!\n");
+	  exit(-1);
 	}
+      memcpy(newpg,pa,ALLOC_SIZE);
+      proc->PageTable.insert(pg,newpg);
+      pa = newpg;
+      tlb->writable = 1;
     }
+  tlb->pg = pg;
+  tlb->base = pa;
+  return pa+(addr&(ALLOC_SIZE-1));
 }
 
 /****** Template for a wide variety of integer loads  *********/
 template <class T> void ldi(instance *inst,state *proc, T t)
 {
-  unsigned pa=GetMap(inst,proc);
+  char *pa=GetMap(inst,proc);
   if (pa)
     {
       T *ptr = (T *)pa; 
@@ -2326,7 +2337,7 @@ template <class T> void ldi(instance *inst,state *proc, T t)
 
 void ldll(instance *inst,state *proc, unsigned long long t)
 {
-  unsigned pa=GetMap(inst,proc);
+  char *pa=GetMap(inst,proc);
   if (pa)
     {
       unsigned long long *ptr = (unsigned long long *)pa; 
@@ -2340,7 +2351,7 @@ void ldll(instance *inst,state *proc, unsigned long long t)
 /****** Template for a wide variety of FP loads  *********/
 template <class T> void ldf(instance *inst,state *proc, T)
 {
-  unsigned pa=GetMap(inst,proc);
+  char *pa=GetMap(inst,proc);
   if (pa)
     {
       T *ptr = (T *)pa;
@@ -2355,7 +2366,7 @@ template <class T> void ldf(instance *inst,state *proc, T)
 /****** Template for a wide variety of integer stores  *******/
 template <class T> void sti(instance *inst,state *proc, T)
 {
-  unsigned pa=GetMap(inst,proc);
+  char *pa=GetMap(inst,proc,1);
   if (pa)
     {
       T *ptr = (T *)pa;
@@ -2366,7 +2377,7 @@ template <class T> void sti(instance *inst,state *proc, T)
 /****** Template for a wide variety of FP stores  *******/
 template <class T> void stf(instance *inst,state *proc, T)
 {
-  unsigned pa=GetMap(inst,proc);
+  char *pa=GetMap(inst,proc,1);
   if (pa)
     {
       T *ptr = (T *)pa;
@@ -2410,7 +2421,7 @@ void fnLDSH(instance *inst,state *proc)
 
 void fnLDD(instance *inst,state *proc)
 {
-  unsigned pa=GetMap(inst,proc);
+  char *pa=GetMap(inst,proc);
   if (pa)
     {
       unsigned *ptr = (unsigned *)pa;
@@ -2479,7 +2490,7 @@ void fnSTQF(instance *inst,state *proc)
 
 void fnSTD(instance *inst,state *proc)
 {
-  unsigned pa=GetMap(inst,proc);
+  char *pa=GetMap(inst,proc,1);
   if (pa)
     {
       unsigned *ptr = (unsigned *)pa;
@@ -2586,7 +2597,7 @@ void fnSTQFA(instance *inst,state *proc)
 
 void fnLDSTUB(instance *inst, state *proc)
 {
-  unsigned pa=GetMap(inst,proc);
+  char *pa=GetMap(inst,proc,1);
   if (pa)
     {
       unsigned char *ptr = (unsigned char *)pa;
@@ -2599,7 +2610,7 @@ void fnLDSTUB(instance *inst, state *proc)
 
 void fnSWAP(instance *inst, state *proc)
 {
-  unsigned pa=GetMap(inst,proc);
+  char *pa=GetMap(inst,proc,1);
   if (pa)
     {
       int *ptr = (int *)pa;
@@ -2647,7 +2658,7 @@ void fnPREFETCH(instance *, state *)
 
 void fnCASA(instance *inst, state *proc)
 {
-  unsigned pa=GetMap(inst,proc);
+  char *pa=GetMap(inst,proc,1);
   if (pa)
     {
       int *ptr = (int *)pa;
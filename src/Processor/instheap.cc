@@ -212,3 +212,146 @@ int InstHeap::GetMin(instance *& min, int &tag)
   return ans;
 }
 
+
+int InstWheel::wheelsz = 256; /* must be a power of 2 */
+
+InstWheel::InstWheel():base(0),used(0)
+{
+  slots = new Slot[wheelsz];
+  memset(slots,0,wheelsz*sizeof(Slot));
+}
+
+/*****************************************************************************/
+/* SlotInsert : entries within a slot are kept sorted the way the InstHeap   */
+/* orders them, by timestamp and then tag. A slot normally holds only one    */
+/* timestamp, so this is just a tag-ordered insertion from the end.          */
+/*****************************************************************************/
+
+void InstWheel::SlotInsert(Slot &s, int ts, instance *o, int tag)
+{
+  if (s.n >= s.size)
+    {
+      if (s.first > 0) /* slide the live entries down to the front */
+	{
+	  memmove(s.obj,s.obj+s.first,(s.n-s.first)*sizeof(instptr));
+	  memmove(s.tags,s.tags+s.first,(s.n-s.first)*sizeof(int));
+	  memmove(s.ord,s.ord+s.first,(s.n-s.first)*sizeof(int));
+	  s.n -= s.first;
+	  s.first = 0;
+	}
+      else
+	{
+	  int sz = s.size ? 2*s.size : 4;
+	  instance **obj2 = new instptr[sz];
+	  int *tags2 = new int[sz];
+	  int *ord2 = new int[sz];
+	  if (s.size)
+	    {
+	      memcpy(obj2,s.obj,s.n*sizeof(instptr));
+	      memcpy(tags2,s.tags,s.n*sizeof(int));
+	      memcpy(ord2,s.ord,s.n*sizeof(int));
+	      delete[] s.obj;
+	      delete[] s.tags;
+	      delete[] s.ord;
+	    }
+	  s.obj = obj2;
+	  s.tags = tags2;
+	  s.ord = ord2;
+	  s.size = sz;
+	}
+    }
+
+  int i = s.n++;
+  while (i > s.first && (ts < s.ord[i-1] || (ts == s.ord[i-1] && tag < s.tags[i-1])))
+    {
+      s.obj[i] = s.obj[i-1];
+      s.tags[i] = s.tags[i-1];
+      s.ord[i] = s.ord[i-1];
+      i--;
+    }
+  s.obj[i] = o;
+  s.tags[i] = tag;
+  s.ord[i] = ts;
+}
+
+/*****************************************************************************/
+/* rebase : turns the wheel so that its first slot is for cycle b, and pulls */
+/* in any overflow entries that now fall within the wheel. Only called when  */
+/* no slot holds an entry for a cycle before b, or when the slots are empty. */
+/*****************************************************************************/
+
+void InstWheel::rebase(int b)
+{
+  base = b;
+  while (overflow.num() != 0 && overflow.PeekMin() < base + wheelsz)
+    {
+      instance *o;
+      int tag;
+      int ts = overflow.GetMin(o,tag);
+      SlotInsert(slots[(ts < base ? base : ts) & (wheelsz-1)],ts,o,tag);
+      used++;
+    }
+}
+
+/*****************************************************************************/
+/* FirstCycle : the cycle of the first non-empty slot (used must be > 0)     */
+/*****************************************************************************/
+
+int InstWheel::FirstCycle() const
+{
+  int c = base;
+  while (slots[c & (wheelsz-1)].first == slots[c & (wheelsz-1)].n)
+    c++;
+  return c;
+}
+
+int InstWheel::insert(int ts, instance *o, int tag)
+{
+  if (used == 0) /* wheel is empty, so start it at this entry */
+    {
+      int b = ts;
+      if (overflow.num() != 0 && overflow.PeekMin() < b)
+	b = overflow.PeekMin();
+      rebase(b);
+    }
+
+  if (ts >= base + wheelsz)
+    return overflow.insert(ts,o,tag);
+
+  SlotInsert(slots[(ts < base ? base : ts) & (wheelsz-1)],ts,o,tag);
+  used++;
+  return 1;
+}
+
+int InstWheel::PeekMin()
+{
+  if (used == 0)
+    return overflow.PeekMin();
+  int c = FirstCycle();
+  if (c != base)
+    rebase(c);
+  Slot &s = slots[c & (wheelsz-1)];
+  return s.ord[s.first];
+}
+
+int InstWheel::GetMin(instance *& min, int &tag)
+{
+  if (used == 0)
+    {
+      if (overflow.num() == 0)
+	return -1;
+      rebase(overflow.PeekMin());
+    }
+  
+  int c = FirstCycle();
+  if (c != base)
+    rebase(c);
+  Slot &s = slots[c & (wheelsz-1)];
+  min = s.obj[s.first];
+  tag = s.tags[s.first];
+  int ans = s.ord[s.first];
+  if (++s.first == s.n)
+    s.first = s.n = 0;
+  used--;
+  return ans;
+}
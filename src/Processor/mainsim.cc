@@ -61,6 +61,7 @@
 #include <fcntl.h>
 #include <malloc.h>
 #include <sys/time.h>
+#include <sys/mman.h>
 
 #include <signal.h>
 #include <unistd.h>
@@ -77,6 +78,8 @@
 #include "Processor/traps.h"
 #include "Processor/simio.h"
 #include "Processor/units.h"
+#include "Processor/checkpoint.h"
+#include "Processor/fastfwd.h"
 extern "C"
 {
 #include "MemSys/simsys.h"
@@ -87,6 +90,8 @@ extern "C"
 #include "MemSys/bus.h"
 #include "MemSys/directory.h"
 #include "MemSys/misc.h"
+#include "MemSys/hostprof.h"
+#include "MemSys/statout.h"
 }
 
 /***********************************************************************/
@@ -229,32 +234,117 @@ extern "C" void fpfailure(int)
 char *args[]={"a.out",NULL};
 
 /***********************************************************************/
-/* read_instructions :  read the list of instructions from the         */
-/*                   :  predecoded file onto the instruction array     */
-/*                   :  can be machine-format-dependent                */
+/* read_instructions :  map the predecoded file (see decfile.h) and     */
+/*                   :  set up the instruction array. Each chunk of     */
+/*                   :  instructions is checked, and converted if the   */
+/*                   :  file came from a host with another byte order,  */
+/*                   :  by LoadInstrChunk the first time it is fetched  */
 /***********************************************************************/
 
+static const int *dec_records;	/* the mapped instruction records   */
+static const unsigned *dec_sums; /* chunk checksums, file byte order */
+static int dec_swap;		/* file is in the other byte order  */
+static int dec_direct;		/* instr_array is the mapping itself */
+char *instr_chunk_ready;	/* chunks checked so far            */
+
+static void DecFileError(char *filename, char *why)
+{
+  fprintf(simerr,"%s: %s -- rerun predecode on this application\n",filename,why);
+  exit(-1);
+}
 
 int read_instructions()
 {
   struct stat buf;
   char filename[80];
+  DecHeader hdr;
+  int fd;
   strcpy(filename,args[0]);
   strcat(filename,".dec");
-  if (stat(filename,&buf))
+  if ((fd = open(filename,O_RDONLY)) < 0)
     return 0;
+  if (fstat(fd,&buf) || buf.st_size < (off_t)sizeof(hdr) ||
+      read(fd,(char *)&hdr,sizeof(hdr)) != sizeof(hdr))
+    DecFileError(filename,"not a predecoded file");
 
-  int ninstrs = buf.st_size / sizeof(instr);
-  instr_array = new instr[ninstrs+10];
-  FILE *fp=fopen(filename,"r");
-  if (fp == NULL)
-    return 0;
-  fread((char *)instr_array,sizeof(instr),ninstrs,fp);
-  fclose(fp);
+  if (hdr.magic == (int)DecSwap(DEC_MAGIC))
+    {
+      unsigned *w = (unsigned *)&hdr;
+      for (unsigned i=0; i<sizeof(hdr)/sizeof(unsigned); i++)
+	w[i] = DecSwap(w[i]);
+      dec_swap = 1;
+    }
+  if (hdr.magic != DEC_MAGIC)
+    DecFileError(filename,"old or unknown predecoded format");
+  if (hdr.version != DEC_VERSION || hdr.byteorder != DEC_BYTEORDER ||
+      hdr.fields != DEC_FIELDS || hdr.chunk != DEC_CHUNK)
+    DecFileError(filename,"unsupported predecoded format version");
+
+  int ninstrs = hdr.ninstrs;
+  int nchunks = DecChunks(ninstrs);
+  off_t recoff = sizeof(hdr) + nchunks*sizeof(unsigned);
+  if (ninstrs <= 0 ||
+      buf.st_size != recoff + (off_t)(ninstrs*DEC_FIELDS*sizeof(int)))
+    DecFileError(filename,"size does not match instruction count");
+
+  /* Map the file shared and read-only, so that simulations of the same
+     application share one copy of it, and pages are read on demand */
+  char *base = (char *)mmap(0,buf.st_size,PROT_READ,MAP_SHARED,fd,0);
+  close(fd);
+  if (base == (char *)MAP_FAILED)
+    DecFileError(filename,"cannot be mapped");
+  
+  dec_sums = (const unsigned *)(base + sizeof(hdr));
+  if (DecChecksum(dec_sums,nchunks*sizeof(unsigned)) != hdr.checksum)
+    DecFileError(filename,"header checksum mismatch");
+  dec_records = (const int *)(base + recoff);
+
+  /* The records can be used in place if they are laid out just like
+     struct instr on this host */
+  instr probe(iCALL,1,2,3,4,5,6,7,8,REG_FP,REG_INTPAIR,REG_FPHALF,1,0,1,3,WPC_SAVE);
+  int words[DEC_FIELDS];
+  DecPack(probe,words);
+  dec_direct = !dec_swap && sizeof(instr) == sizeof(words) &&
+    memcmp((char *)&probe,(char *)words,sizeof(words)) == 0;
+  
+  if (dec_direct)
+    instr_array = (instr *)dec_records;
+  else
+    instr_array = new instr[ninstrs];
+  instr_chunk_ready = new char[nchunks];
+  memset(instr_chunk_ready,0,nchunks);
   return ninstrs;
 }
 
-HashTable<unsigned, unsigned> *SharedPageTable;
+/***********************************************************************/
+/* LoadInstrChunk : check chunk c of the predecoded file against its   */
+/*                : checksum and, if needed, convert it into           */
+/*                : instr_array. Called from FetchInstr.               */
+/***********************************************************************/
+
+void LoadInstrChunk(int c)
+{
+  const int *rec = dec_records + c*DEC_CHUNK*DEC_FIELDS;
+  int n = num_instructions - c*DEC_CHUNK;
+  if (n > DEC_CHUNK)
+    n = DEC_CHUNK;
+  
+  unsigned sum = dec_swap ? DecSwap(dec_sums[c]) : dec_sums[c];
+  if (DecChecksum(rec,n*DEC_FIELDS*sizeof(int)) != sum)
+    {
+      fprintf(simerr,"Predecoded instructions %d to %d fail their checksum -- rerun predecode\n",
+	      c*DEC_CHUNK,c*DEC_CHUNK+n-1);
+      exit(-1);
+    }
+  if (!dec_direct)
+    {
+      for (int i=0; i<n; i++)
+	DecUnpack(rec+i*DEC_FIELDS,dec_swap,instr_array[c*DEC_CHUNK+i]);
+    }
+  instr_chunk_ready[c] = 1;
+}
+
+PageMap *SharedPageTable;
 
 extern char *optarg;
 extern int optind;
@@ -263,6 +353,7 @@ char *mailto = NULL, *subject = NULL;
 char *fname0 = NULL, *fname1 = NULL, *fname2 = NULL, *fname3 = NULL, *fname4 = NULL;
 char arr1[1024],arr2[1024],arr3[1024];
 char *dirname = NULL;
+char *statout_name = NULL;
 
 
 /***********************************************************************/
@@ -305,28 +396,6 @@ extern "C" void before_exit()
     }
 }
 
-/***********************************************************************/
-/* mem_map1    : defines a hashing function used in PageTable          */
-/***********************************************************************/
-     
-static unsigned mem_map1(unsigned k, unsigned sz)
-{
-  return k&(sz-1);
-}
-
-/***********************************************************************/
-/* mem_map2    : defines a hashing function used in PageTable          */
-/*             : can be machine specific                               */
-/***********************************************************************/
-
-
-
-static unsigned mem_map2(unsigned k,unsigned sz) // a ROL of 13 or some such
-{
-  return (((k<< 13) | (k >> (BITS(unsigned)-13))) & (sz-1))*2+1;
-}
-
-
 /***********************************************************************/
 /* UserMain    : the main procedure (in YACSIM programs); mainly sets  */
 /*             : variables, parses the command line, and calls         */
@@ -357,12 +426,12 @@ extern "C" void UserMain(int argc, char **argv)
   /* Parse command line and initialize variables                     */
   /*******************************************************************/
   
-  while ((c1=getopt(argc,argv,"D:S:0:1:2:3:z:e:A:c:t:f:i:a:uU:g:w:E:G:Xq:m:L:pPJKN6H:TxkF:y:nWh")) != -1)
+  while ((c1=getopt(argc,argv,"D:S:0:1:2:3:z:e:A:c:t:f:i:a:uU:g:w:E:G:Xq:m:L:pPJKN6H:TxkF:y:nWC:R:sb:oIj:h")) != -1)
     {
       /* USED:                            UNUSED:  
 	 01236			  
-	 ADEFGHJKLNPSTUWXZ	          BCIMOQRVY
-	 acefghikmnpqtuwxyz               bdjlorsv */
+	 ACDEFGHIJKLNPRSTUWX	          BMOQVYZ
+	 abcefghijkmnopqstuwxyz           dlrv */
       
       c=c1;
       switch(c)
@@ -498,6 +567,33 @@ extern "C" void UserMain(int argc, char **argv)
 	case 'W':
 	  MemWarnings = 0;
 	  break;
+	case 'C': // save a checkpoint at the first fork or newphase, then exit
+	  checkpoint_save_file = optarg;
+	  break;
+	case 'R': // restore from a checkpoint instead of loading the binary
+	  checkpoint_restore_file = optarg;
+	  break;
+	case 's': // functional fast-forward up to the first newphase
+	  fast_forward = 1;
+	  break;
+	case 'b': // statistical sampling: fast-forward,warmup,measure lengths
+	  sampling = 1;
+	  if (sscanf(optarg,"%d,%d,%d",&sample_ff,&sample_warm,&sample_measure) != 3 ||
+	      sample_ff < 0 || sample_warm < 0 || sample_measure <= 0)
+	    {
+	      fprintf(simerr,"-b requires three interval lengths: fast-forward,warmup,measure\n");
+	      exit(-1);
+	    }
+	  break;
+	case 'o': // step every cycle, even when all nodes wait on memory
+	  cycle_skip = 0;
+	  break;
+	case 'I': // profile the host time of each simulator component
+	  HostProf = 1;
+	  break;
+	case 'j': // also write the statistics as structured records
+	  statout_name = optarg;
+	  break;
 	case 'h':
 	default:
 	  fprintf(simerr,"Please refer to the RSIM manual for a detailed\ndescription of the RSIM command line options.\n");
@@ -605,6 +701,8 @@ extern "C" void UserMain(int argc, char **argv)
     {
       fname3=fname1; /* simout same as stdout */
     }
+  if (statout_name)
+    StatOutOpen(statout_name);
 
   if (fname4)
     {
@@ -635,7 +733,7 @@ extern "C" void UserMain(int argc, char **argv)
   fprintf(simerr,"\n\n");
   
   state::AllProcessors = new circq<state *>(MAX_MEMSYS_PROCS);
-  SharedPageTable = new HashTable<unsigned, unsigned> (mem_map1,mem_map2);
+  SharedPageTable = new PageMap;
   
 #if defined(USESIGNAL) /* HP-UX, SunOS */
   signal(SIGALRM,alarmhandler);
@@ -699,7 +797,15 @@ extern "C" void UserMain(int argc, char **argv)
   /**********************************************************************/
   
 
-  if (startup(argv+optind-1,pptr) == -1)
+  if (checkpoint_restore_file)
+    {
+      if (CheckpointRestore(pptr) == -1)
+	{
+	  fprintf(simerr,"Error with this checkpoint\n");
+	  exit(-1);
+	}
+    }
+  else if (startup(argv+optind-1,pptr) == -1)
     {
       fprintf(simerr,"Error with this file\n");
       exit(-1);
@@ -765,6 +871,8 @@ extern "C" void UserMain(int argc, char **argv)
   while (state::AllProcessors->Delete(pptr))
     {
       pptr->report_phase();
+      if (sampling)
+	pptr->report_samples();
 #ifdef COREFILE
       fflush(pptr->corefile);
       fclose(pptr->corefile);
@@ -1054,7 +1054,7 @@ inline int CanShPrefetch(state *proc,instance *memop)
 void IssueLoads(state *proc)
 {
   instance *memop;
-  MemQLink<instance *> *stindex = NULL, *ldindex = NULL;
+  MemQLink<instance *> *ldindex = NULL;
 
   while (((ldindex=proc->LoadQueue.GetNext(ldindex)) != NULL) && proc->UnitsFree[uMEM])
     {
@@ -1091,9 +1091,9 @@ void IssueLoads(state *proc)
 	  int canissue=1;
 	  int speccing=0;
 	  unsigned instaddr = memop->addr;
-	  instance *conf;
+	  instance *conf, **confs;
 	  unsigned confaddr;
-	  stindex=NULL;
+	  int nconfs, lowambig = INT_MAX;
 	  if (memop->code->instruction == iPREFETCH)
 	    {
 	      if (L1Q_FULL[proc->proc_id]) /* ports are taken */
@@ -1108,138 +1108,141 @@ void IssueLoads(state *proc)
 		  continue;
 		}
 	    }
-	  while ((stindex=proc->StoreQueue.GetNext(stindex)) != NULL)
+	  /* Only the earlier stores with known addresses that overlap
+	     this load matter here, and the address index finds just those.
+	     Earlier stores with unknown addresses make the load speculative,
+	     or stall it with SPEC_STALL after the stores before them. */
+	  proc->ambig_st_tags.GetMin(lowambig);
+	  nconfs = proc->StoreQueue.Overlaps(memop,confs);
+	  for (int i=0; i<nconfs; i++)
 	    {
-	      conf=stindex->d;
-	      if (conf->tag > memop->tag)
+	      conf=confs[i];
+	      if (conf->tag > lowambig && spec_stores == SPEC_STALL)
 		break;
-	      if (!conf->addr_ready) 
+	      confaddr = conf->addr;
+	      // ok, either we stall or we have a chance for a quick forwarding.
+	      if (confaddr==instaddr && conf->truedep == 0 && 
+		  MemMatch(memop,conf) && 
+		  !((!membarprime || confaddr >= lowsimmed) &&
+		    (!Speculative_Loads &&
+		     ((memop->tag > proc->SLtag && conf->tag < proc->SLtag) ||
+		      (memop->tag > proc->LLtag && proc->minload < proc->LLtag)))))
+		// no forward across membar unless there is specload support
+		// note: specload membar is "speculative" across a LL or SL,
+		// but we _actually_ enforce the MemIssue ones
 		{
-		  speccing=1;
-
-		  if (spec_stores == SPEC_STALL) // now's the time to give up, if so
+		  if (conf->memprogress != 0 && confaddr >= lowsimmed && proc->MEMSYS) // a forward from VSB of something that actually will be GloballyPerformed
 		    {
+		      memop->vsbfwd = -conf->tag-3;
 		      memop->memprogress = 0;
-		      memop->vsbfwd = 0;
-		      return;
 		    }
+		  else
+		    {
+		      memop->vsbfwd = 0; // if we accidentally counted it as a vsbfwd earlier, count it properly now
+		      memop->memprogress = -conf->tag-3; // varies from -3 on down!
+		    }
+		  canissue=1; // we can definitely use it
 		  continue;
 		}
-	      confaddr = conf->addr;
-	      if (overlap(conf,memop))
+	      else if (conf->code->instruction == iSTDF &&
+		       memop->code->instruction == iLDUW &&
+		       conf->truedep == 0 &&
+		       ((memop->addr == conf->addr) ||
+			(memop->addr == conf->addr + sizeof(int))) &&
+		       !((!membarprime || confaddr >= lowsimmed) &&
+			 (!Speculative_Loads &&
+			  ((memop->tag > proc->SLtag && conf->tag < proc->SLtag) ||
+			   (memop->tag > proc->LLtag && proc->minload < proc->LLtag)))))
 		{
-		  // ok, either we stall or we have a chance for a quick forwarding.
-		  if (confaddr==instaddr && conf->truedep == 0 && 
-		      MemMatch(memop,conf) && 
-		      !((!membarprime || confaddr >= lowsimmed) &&
-			(!Speculative_Loads &&
-			 ((memop->tag > proc->SLtag && conf->tag < proc->SLtag) ||
-			  (memop->tag > proc->LLtag && proc->minload < proc->LLtag)))))
-		    // no forward across membar unless there is specload support
-		    // note: specload membar is "speculative" across a LL or SL,
-		    // but we _actually_ enforce the MemIssue ones
+		  /* here's a case where we can forward just like
+		     the regular case, even if it's a partial
+		     overlap. I mention this case because it's so
+		     common, appearing in some libraries all the
+		     time */
+			
+		  if (conf->memprogress != 0 && confaddr >= lowsimmed && proc->MEMSYS) // a forward from VSB of something that actually will be GloballyPerformed -- only way it won't is if it gets flushed
 		    {
-		      if (conf->memprogress != 0 && confaddr >= lowsimmed && proc->MEMSYS) // a forward from VSB of something that actually will be GloballyPerformed
-			{
-			  memop->vsbfwd = -conf->tag-3;
-			  memop->memprogress = 0;
-			}
-		      else
-			{
-			  memop->vsbfwd = 0; // if we accidentally counted it as a vsbfwd earlier, count it properly now
-			  memop->memprogress = -conf->tag-3; // varies from -3 on down!
-			}
-		      canissue=1; // we can definitely use it
-		      continue;
+		      memop->vsbfwd = -conf->tag-3;
+		      memop->memprogress = 0;
 		    }
-		  else if (conf->code->instruction == iSTDF &&
-			   memop->code->instruction == iLDUW &&
-			   conf->truedep == 0 &&
-			   ((memop->addr == conf->addr) ||
-			    (memop->addr == conf->addr + sizeof(int))) &&
-			   !((!membarprime || confaddr >= lowsimmed) &&
-			     (!Speculative_Loads &&
-			      ((memop->tag > proc->SLtag && conf->tag < proc->SLtag) ||
-			       (memop->tag > proc->LLtag && proc->minload < proc->LLtag)))))
+		  else
 		    {
-		      /* here's a case where we can forward just like
-			 the regular case, even if it's a partial
-			 overlap. I mention this case because it's so
-			 common, appearing in some libraries all the
-			 time */
-			
-		      if (conf->memprogress != 0 && confaddr >= lowsimmed && proc->MEMSYS) // a forward from VSB of something that actually will be GloballyPerformed -- only way it won't is if it gets flushed
-			{
-			  memop->vsbfwd = -conf->tag-3;
-			  memop->memprogress = 0;
-			}
-		      else
-			{
-			  memop->vsbfwd = 0; // if we accidentally counted it as a vsbfwd earlier, count it properly now
-			  memop->memprogress = -conf->tag-3; // varies from -3 on down!
-			}
+		      memop->vsbfwd = 0; // if we accidentally counted it as a vsbfwd earlier, count it properly now
+		      memop->memprogress = -conf->tag-3; // varies from -3 on down!
+		    }
 		      
-		      if (memop->addr == conf->addr)
-			{
-			  memop->rdvali = *((int *)&conf->rs1valf);
-			}
-		      else if (memop->addr == conf->addr+sizeof(int))
-			{
-			  memop->rdvali = *(((int *)(&conf->rs1valf)) +1);
-			}
-		      else
-			{
-			  /* a partial overlap of STDF and LDUW that can't be
-			     handled. Most probably misalignment or
-			     other problems involved. Checked for this
-			     case before entering here. */
-			  fprintf(simerr,"Partial overlap of STDF and LDUW which couldn't be recognized -- should have been checked.\n");
-			  exit(-1);
-			}
-		      canissue=1; // we can definitely use it
-		      continue;
-		    }			   
-		  else if (conf->memprogress == 0) // the store hasn't been issued yet
+		  if (memop->addr == conf->addr)
 		    {
-		      memop->memprogress = 0;
-		      memop->vsbfwd = 0;
-		      canissue=0;
-		      continue;
+		      memop->rdvali = *((int *)&conf->rs1valf);
 		    }
-		  else if (IsRMW(conf)) // you can't go in parallel with any RMW (except of course for simple LDSTUBs which you forward)
+		  else if (memop->addr == conf->addr+sizeof(int))
 		    {
-		      memop->memprogress = 0;
-		      memop->vsbfwd = 0;
-		      canissue=0;
-		      continue;
+		      memop->rdvali = *(((int *)(&conf->rs1valf)) +1);
 		    }
-		  else if (!((!membarprime || memop->addr >= lowsimmed) &&
-			     ((memop->tag > proc->SLtag && proc->minstore < proc->SLtag) ||
-			      (memop->tag > proc->LLtag && proc->minload < proc->LLtag))))
-		    /* in other words, this isn't a case of trying to forward across a membar */
+		  else
 		    {
-		      // for now we'll actually block out partial overlaps (except
-		      // for the special case we handled above STDF-LDUW),
-		      // and count them when they graduate
+		      /* a partial overlap of STDF and LDUW that can't be
+			 handled. Most probably misalignment or
+			 other problems involved. Checked for this
+			 case before entering here. */
+		      fprintf(simerr,"Partial overlap of STDF and LDUW which couldn't be recognized -- should have been checked.\n");
+		      exit(-1);
+		    }
+		  canissue=1; // we can definitely use it
+		  continue;
+		}                      
+	      else if (conf->memprogress == 0) // the store hasn't been issued yet
+		{
+		  memop->memprogress = 0;
+		  memop->vsbfwd = 0;
+		  canissue=0;
+		  continue;
+		}
+	      else if (IsRMW(conf)) // you can't go in parallel with any RMW (except of course for simple LDSTUBs which you forward)
+		{
+		  memop->memprogress = 0;
+		  memop->vsbfwd = 0;
+		  canissue=0;
+		  continue;
+		}
+	      else if (!((!membarprime || memop->addr >= lowsimmed) &&
+			 ((memop->tag > proc->SLtag && proc->minstore < proc->SLtag) ||
+			  (memop->tag > proc->LLtag && proc->minload < proc->LLtag))))
+		/* in other words, this isn't a case of trying to forward across a membar */
+		{
+		  // for now we'll actually block out partial overlaps (except
+		  // for the special case we handled above STDF-LDUW),
+		  // and count them when they graduate
 		      
-			{
-			  memop->memprogress = 0;
-			  memop->vsbfwd = 0;
-			  canissue=0;
-			  memop->partial_overlap=1;
+		    {
+		      memop->memprogress = 0;
+		      memop->vsbfwd = 0;
+		      canissue=0;
+		      memop->partial_overlap=1;
 #ifdef COREFILE
-			  if (YS__Simtime > DEBUG_TIME)
-			    fprintf(corefile,"P%d @<%d>: Partially overlapping load tag %d[%s] @(%d) conflicts with tag %d[%s] @(%d)\n",proc->proc_id,proc->curr_cycle,memop->tag,inames[memop->code->instruction],instaddr,conf->tag,inames[conf->code->instruction],confaddr);
+		      if (YS__Simtime > DEBUG_TIME)
+			fprintf(corefile,"P%d @<%d>: Partially overlapping load tag %d[%s] @(%d) conflicts with tag %d[%s] @(%d)\n",proc->proc_id,proc->curr_cycle,memop->tag,inames[memop->code->instruction],instaddr,conf->tag,inames[conf->code->instruction],confaddr);
 #endif
-			  continue;
-			}
+		      continue;
 		    }
 		}
 	    }
 
+	  if (lowambig < memop->tag)
+	    {
+	      speccing=1;
+
+	      if (spec_stores == SPEC_STALL) // now's the time to give up, if so
+		{
+		  memop->memprogress = 0;
+		  memop->vsbfwd = 0;
+		  return;
+		}
+	    }
+
 	  if (canissue && memop->memprogress > -3)
 	    {
-	      if ((!membarprime || confaddr >= lowsimmed) &&
+	      if ((!membarprime || instaddr >= lowsimmed) &&
 		    (!Speculative_Loads &&
 		     ((memop->tag > proc->SLtag && proc->minstore < proc->SLtag) ||
 		      (memop->tag > proc->LLtag && proc->minload < proc->LLtag))))
@@ -1853,6 +1856,7 @@ void Disambiguate(instance *inst, state *proc )
       proc->ambig_st_tags.Remove(inst->tag);
       proc->ambig_st_tags.GetMin(lowambig);
 #ifndef STORE_ORDERING
+      proc->StoreQueue.AddrReady(inst); /* loads can now find it by address */
       while ((ldindex=proc->LoadQueue.GetNext(ldindex)) != NULL)
 #else
       while ((ldindex=proc->MemQueue.GetNext(ldindex)) != NULL)
@@ -68,6 +68,7 @@
 #include "Processor/traps.h"
 #include "Processor/simio.h"
 #include "Processor/processor_dbg.h"
+#include "Processor/fastfwd.h"
 
 extern "C"
 {
@@ -116,7 +117,8 @@ int maindecode(state *proc)
   }
 
   ComputeAvail(proc);
-  if (proc->in_exception == NULL) // we won't take new ops if so
+  if (proc->in_exception == NULL && // we won't take new ops if so
+      proc->sample_mode != SAMPLE_DRAIN) // or if draining for a sample
     {
       decode_cycle(proc);
     }
@@ -231,7 +233,7 @@ int decode_cycle(state *proc)
 	    }
 	}
       else
-	instrn = instr_array + proc->pc; // new instr;
+	instrn = FetchInstr(proc->pc); // new instr;
       /* allocating memory */
       
 #ifdef COREFILE
@@ -86,7 +86,7 @@ void *our_sh_malloc(int size)
   if (startpg < endpg)
     {
       /* add pages as needed */
-      unsigned chunkptr = (unsigned)malloc((endpg - startpg) * ALLOC_SIZE);
+      char *chunkptr = (char *)malloc((endpg - startpg) * ALLOC_SIZE);
       for (unsigned pg=startpg; pg < endpg; pg++, chunkptr += ALLOC_SIZE)
 	{
 	  SharedPageTable->insert(pg,chunkptr);
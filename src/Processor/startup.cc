@@ -95,7 +95,8 @@ int startup(char **args, state *proc)
   register int i;
   int argcount;
   int size;
-  register char **cpp;
+  register unsigned *cpp;
+  unsigned simcp, simcpp;
   int cnt;
   int badpc;
 
@@ -221,8 +222,7 @@ int startup(char **args, state *proc)
 #endif
   
   /****** Insert the data into the processor hash table */
-  unsigned data_chunk = (unsigned) datachunk;
-  unsigned chunkptr = data_chunk;
+  char *chunkptr = datachunk;
   for (unsigned pg=data_start/ALLOC_SIZE;
        pg< (data_start + alloc_size)/ALLOC_SIZE;
        pg++, chunkptr += ALLOC_SIZE)
@@ -230,7 +230,7 @@ int startup(char **args, state *proc)
       proc->PageTable.insert(pg,chunkptr);
     }
   
-  unsigned stackchunk = (unsigned) malloc(ALLOC_SIZE);
+  char *stackchunk = (char *) malloc(ALLOC_SIZE);
   proc->PageTable.insert(lowshared / ALLOC_SIZE -1, stackchunk); /* 1 chunk for the initial stack -- it will expand as needed */
   
   unsigned proglim=data_start+alloc_size;
@@ -259,38 +259,41 @@ int startup(char **args, state *proc)
   fprintf(simerr,"\n\n");
   
   /*
-   *  The arguments will get copied starting at "cp", and the argv
+   *  The arguments will get copied starting at "simcp", and the argv
    *  pointers to the arguments (and the argc value) will get built
-   *  starting at "cpp".  The value for "cpp" is computed by subtracting
+   *  starting at "simcpp".  The value for "simcpp" is computed by subtracting
    *  off space for the number of arguments (plus 2, for the terminating
    *  NULL and the argc value) times the size of each (4 bytes), and
    *  then rounding the value *down* to a double-word boundary.
+   *  These are simulated addresses; "cp" and "cpp" are where they
+   *  fall in the simulator's copy of the stack page.
    */
-  cp = (char *)lowshared - size;
-  cpp = (char **)(((int)cp - ((argcount + 2) * 4)) & ~7);
+  simcp = lowshared - size;
+  simcpp = (simcp - ((argcount + 2) * 4)) & ~7;
 
   /* here's the part for setting the stack pointer, which is register %o6, or 14 */
   int prsp = proc->intmapper[proc->SPARCtoLog(14)]; /* the stack pointer *** */
-  proc->physical_int_reg_file[prsp] = int(cpp) - MINIMUM_STACK_FRAME_SIZE;
+  proc->physical_int_reg_file[prsp] = int(simcpp) - MINIMUM_STACK_FRAME_SIZE;
   proc->physical_int_reg_file[proc->intmapper[proc->SPARCtoLog(8)]] = argcount; // argc
-  proc->physical_int_reg_file[proc->intmapper[proc->SPARCtoLog(9)]] = int(cpp+1); // argv
+  proc->physical_int_reg_file[proc->intmapper[proc->SPARCtoLog(9)]] = int(simcpp+4); // argv
   
-  proc->logical_int_reg_file[proc->SPARCtoLog(14)] = int(cpp) - MINIMUM_STACK_FRAME_SIZE;
+  proc->logical_int_reg_file[proc->SPARCtoLog(14)] = int(simcpp) - MINIMUM_STACK_FRAME_SIZE;
   proc->logical_int_reg_file[proc->SPARCtoLog(8)] = argcount; // argc
-  proc->logical_int_reg_file[proc->SPARCtoLog(9)] = int(cpp+1); // argv
+  proc->logical_int_reg_file[proc->SPARCtoLog(9)] = int(simcpp+4); // argv
   
-  cp = (char *)(stackchunk+ALLOC_SIZE - size);
-  cpp = (char **)(((int)cp - ((argcount + 2) * 4)) & ~7);
+  cp = stackchunk + ALLOC_SIZE - (lowshared - simcp);
+  cpp = (unsigned *)(stackchunk + ALLOC_SIZE - (lowshared - simcpp));
   
-  *cpp++ = (char *)argcount;		/* the first value at cpp is argc */
+  *cpp++ = argcount;		/* the first value at cpp is argc */
 
   for (i = 0; i < argcount; i++)	/* copy each argument and set argv's */
     {
-      *cpp++ = cp+lowshared-(stackchunk+ALLOC_SIZE);
+      *cpp++ = simcp;
       strcpy(cp, args[i]);
+      simcp += strlen(cp) + 1;
       cp += strlen(cp) + 1;
     }
-  *cpp = NULL;			/* the last argv is a NULL pointer */
+  *cpp = 0;			/* the last argv is a NULL pointer */
 
   return 0;
 }
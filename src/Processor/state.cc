@@ -5,7 +5,8 @@
   This file contains procedures relating to the "state" class. Most of
   the functions in this file are concerned with initialization or statistics
   reporting. "RSIM_EVENT" is activated every cycle to 
-  invoke the processor and cache system.
+  invoke the processor and cache system, except across stretches where
+  every node is waiting on the memory system (see RSIM_NodeWake).
 
   */
 /*****************************************************************************/
@@ -68,6 +69,7 @@
 #include "Processor/FastNews.h"
 #include "Processor/simio.h"
 #include "Processor/units.h"
+#include "Processor/fastfwd.h"
 
 extern "C"
 {
@@ -76,6 +78,8 @@ extern "C"
 #include "MemSys/cache.h"
 #include "MemSys/arch.h"
 #include "MemSys/misc.h"
+#include "MemSys/hostprof.h"
+#include "MemSys/statout.h"
 }
 
 #include <malloc.h>
@@ -83,6 +87,7 @@ extern "C"
 #include <string.h>
 #include <values.h>
 #include <time.h>
+#include <math.h>
 
 /* set the names for the latency types -- described in state.h */
 
@@ -114,27 +119,6 @@ static char *fuusage_names[numUTYPES] =
   "ALU utilization", "FPU utilization", "Cache ports utilization", "Addr. gen. utilization"
 };
 
-/***********************************************************************/
-/* mem_map1    : defines a hashing function used in PageTable          */
-/***********************************************************************/
-
-static unsigned mem_map1(unsigned k, unsigned sz)
-{
-  return k&(sz-1);
-}
-
-/***********************************************************************/
-/* mem_map2    : defines a hashing function used in PageTable          */
-/*             : can be machine specific                               */
-/***********************************************************************/
-
-static unsigned mem_map2(unsigned k,unsigned sz) // a ROL of 13 or some such
-{
-  return (((k<< 7) | (k >> (BITS(unsigned)-7))) & (sz-1))*2+1;
-}
-
-
-
 unsigned lowshared=0x80000000; /* data space goes from 0 through END_OF_HEAP : program
                               BOTTOM_OF_STACK through lowshared-1 : stack
                            lowshared through end of address space : shared */
@@ -168,7 +152,6 @@ static void ResetInst(instance *inst)
 
 state::state():
   FreeingUnits(ALU_UNITS+FPU_UNITS+ADDR_UNITS+MEM_UNITS) /* each FU can be freed at most once per cycle */
-     ,PageTable(mem_map1,mem_map2)
 #ifndef STORE_ORDERING
      ,StoresToMem(0)
 #else
@@ -186,6 +169,7 @@ state::state():
   AllProcessors->Insert(this);
   int i,j;
   pc=0;
+  FlushTLB();
 
   copymappernext=0;
   unpredbranch=0;
@@ -279,6 +263,20 @@ state::state():
   ACTIVELIST = NewStatrec("Active list size",POINT,MEANS,
 			  HIST,8,0.0,double(MAX_ACTIVE_INSTS));      
   // size of active list
+
+  // sampled every cycle, so batched through per-cycle counters
+  SPECSctr = NewStatctr(SPECS,MAX_SPEC);
+  FUUsagectr[int(uALU)] = NewStatctr(FUUsage[int(uALU)],ALU_UNITS);
+  FUUsagectr[int(uFP)] = NewStatctr(FUUsage[int(uFP)],FPU_UNITS);
+  FUUsagectr[int(uMEM)] = NewStatctr(FUUsage[int(uMEM)],MEM_UNITS);
+  FUUsagectr[int(uADDR)] = NewStatctr(FUUsage[int(uADDR)],ADDR_UNITS);
+#ifndef STORE_ORDERING
+  VSBctr = NewStatctr(VSB,MAX_MEM_OPS);
+  LoadQueueSizectr = NewStatctr(LoadQueueSize,MAX_MEM_OPS);
+#else
+  MemQueueSizectr = NewStatctr(MemQueueSize,MAX_MEM_OPS);
+#endif
+  ACTIVELISTctr = NewStatctr(ACTIVELIST,MAX_ACTIVE_INSTS);
   agg_lat_type=-1;
   stats_phase=0; // start out in a convenient phase #0
   readacc = NewStatrec("Read accesses",POINT,MEANS,NOHIST,5,0.0,10.0);
@@ -317,9 +315,64 @@ state::state():
   for (int lat_ctr=0; lat_ctr < int(lNUM_LAT_TYPES); lat_ctr++)
     {
       lat_contrs[lat_ctr] = NewStatrec(lattype_names[lat_ctr],POINT,MEANS,NOHIST,0,0.0,0.0);
+      sample_lat[lat_ctr] = NewStatrec(lattype_names[lat_ctr],POINT,MEANS,NOHIST,0,0.0,0.0);
     }
 
+  sample_mode = sampling ? SAMPLE_FF : SAMPLE_OFF;
+  sample_left = sample_ff;
+  sample_mark = 0;
+  sample_ipc = NewStatrec("Sampled IPC",POINT,MEANS,NOHIST,0,0.0,0.0);
+  sample_l1miss = NewStatrec("Sampled L1 miss rate",POINT,MEANS,NOHIST,0,0.0,0.0);
+  sample_l2miss = NewStatrec("Sampled L2 miss rate",POINT,MEANS,NOHIST,0,0.0,0.0);
+
   partial_otime = NewStatrec("Partial Overlap time",POINT,MEANS,NOHIST,0,0.0,0.0);
+
+  // units of the values, for the structured statistics output (-j)
+  StatrecSetUnit(bad_pred_flushes,"instructions");
+  StatrecSetUnit(except_flushed,"instructions");
+  StatrecSetUnit(SPECS,"branches");
+  for (i=0; i<numUTYPES; i++)
+    StatrecSetUnit(FUUsage[i],"units");
+#ifndef STORE_ORDERING
+  StatrecSetUnit(VSB,"stores");
+  StatrecSetUnit(LoadQueueSize,"loads");
+#else
+  StatrecSetUnit(MemQueueSize,"instructions");
+#endif
+  StatrecSetUnit(ACTIVELIST,"instructions");
+  StatrecSetUnit(readacc,"cycles");
+  StatrecSetUnit(writeacc,"cycles");
+  StatrecSetUnit(rmwacc,"cycles");
+  StatrecSetUnit(readiss,"cycles");
+  StatrecSetUnit(writeiss,"cycles");
+  StatrecSetUnit(rmwiss,"cycles");
+  StatrecSetUnit(readact,"cycles");
+  StatrecSetUnit(writeact,"cycles");
+  StatrecSetUnit(rmwact,"cycles");
+  for (i=0; i<reqNUM_REQ_STAT_TYPE; i++)
+    {
+      StatrecSetUnit(demand_read[i],"cycles");
+      StatrecSetUnit(demand_write[i],"cycles");
+      StatrecSetUnit(demand_rmw[i],"cycles");
+      StatrecSetUnit(demand_read_iss[i],"cycles");
+      StatrecSetUnit(demand_write_iss[i],"cycles");
+      StatrecSetUnit(demand_rmw_iss[i],"cycles");
+      StatrecSetUnit(demand_read_act[i],"cycles");
+      StatrecSetUnit(demand_write_act[i],"cycles");
+      StatrecSetUnit(demand_rmw_act[i],"cycles");
+      StatrecSetUnit(pref_sh[i],"cycles");
+      StatrecSetUnit(pref_excl[i],"cycles");
+    }
+  StatrecSetUnit(in_except,"cycles");
+  for (i=0; i<int(lNUM_LAT_TYPES); i++)
+    {
+      StatrecSetUnit(lat_contrs[i],"cycles");
+      StatrecSetUnit(sample_lat[i],"fraction");
+    }
+  StatrecSetUnit(sample_ipc,"instructions/cycle");
+  StatrecSetUnit(sample_l1miss,"fraction");
+  StatrecSetUnit(sample_l2miss,"fraction");
+  StatrecSetUnit(partial_otime,"cycles");
   avail_fetch_slots=0;
   for (i=0; i<int(lNUM_LAT_TYPES); i++)
     {
@@ -367,7 +420,7 @@ state::state():
 /*               : fork command                                        */
 /***********************************************************************/
 
-state *state::fork() const
+state *state::fork()
 {
   state *newproc = new state;
   newproc->copy(this);
@@ -387,9 +440,32 @@ void state::report_phase() // called when you want to end a phase
   fprintf(simout,"Start cycle: %d\t\ticount: %d\n",start_time,start_icount);
   fprintf(simout,"End cycle: %d\t\ticount: %d\n",curr_cycle,instruction_count);
 
+  if (StatOut)
+    {
+      char module[16];
+      sprintf(module,"proc%d",proc_id);
+      StatOutPhase(stats_phase);
+      StatOutScope("proc",module);
+      STATOUT("start_cycle",start_time,"cycles");
+      STATOUT("end_cycle",curr_cycle,"cycles");
+      STATOUT("execution_time",curr_cycle-start_time,"cycles");
+      STATOUT("start_icount",start_icount,"instructions");
+      STATOUT("end_icount",instruction_count,"instructions");
+      STATOUT("issued",instruction_count-start_icount,"instructions");
+      STATOUT("graduated",graduates,"instructions");
+    }
   report_stats();
   report_phase_fast(); // this gives the critical stats to simerr
+  if (HostProf && proc_id == 0) // host time is for the whole simulator
+    {
+      double grads = 0.0;
+      for (int i=0; i<numprocs; i++)
+	grads += (double)AllProcs[i]->graduation_count;
+      HostProfReport(simout,(double)curr_cycle,grads);
+    }
   fflush(simout);
+  if (StatOut)
+    fflush(StatOut);
 }
 
 /*************************************************************************/
@@ -411,6 +487,7 @@ void state::report_stats()
 {
   int i;
   
+  fold_stats();
   StatrecReport(ACTIVELIST);
 
   StatrecReport(SPECS);
@@ -425,6 +502,30 @@ void state::report_stats()
   fprintf(simout,"RAS Good predictions: %d, RAS Bad predictions: %d, RAS Prediction rate: %f\n",ras_good_predicts,ras_bad_predicts,double(ras_good_predicts)/double(ras_good_predicts+ras_bad_predicts));
   fprintf(simout,"Loads issued: %d, speced: %d, limbos: %d, unlimbos: %d, redos: %d, kills: %d\n",ldissues,ldspecs,limbos,unlimbos,redos,kills);
   fprintf(simout,"Memory unit fwds: %d, Virtual store buffer fwds: %d Partial overlaps: %d\n",fwds,vsbfwds, partial_overlaps);
+  if (StatOut)
+    {
+      StatOutValue("bpb_predictions","good",bpb_good_predicts,"count");
+      StatOutValue("bpb_predictions","bad",bpb_bad_predicts,"count");
+      StatOutValue("ras_predictions","good",ras_good_predicts,"count");
+      StatOutValue("ras_predictions","bad",ras_bad_predicts,"count");
+      StatOutValue("loads","issued",ldissues,"count");
+      StatOutValue("loads","speced",ldspecs,"count");
+      StatOutValue("loads","limbos",limbos,"count");
+      StatOutValue("loads","unlimbos",unlimbos,"count");
+      StatOutValue("loads","redos",redos,"count");
+      StatOutValue("loads","kills",kills,"count");
+      StatOutValue("forwards","memory_unit",fwds,"count");
+      StatOutValue("forwards","virtual_store_buffer",vsbfwds,"count");
+      StatOutValue("forwards","partial_overlaps",partial_overlaps,"count");
+      StatOutValue("exceptions","total",exceptions,"count");
+      StatOutValue("exceptions","soft",soft_exceptions,"count");
+      StatOutValue("exceptions","sl_soft",sl_soft_exceptions,"count");
+      StatOutValue("exceptions","sl_soft_replacements",sl_repl_soft_exceptions,"count");
+      StatOutValue("exceptions","footnote5",footnote5,"count");
+      StatOutValue("window_traps","overflows",window_overflows,"count");
+      StatOutValue("window_traps","underflows",window_underflows,"count");
+      STATOUT("cycles_since_last_graduation",curr_cycle-last_graduated,"cycles");
+    }
 
   StatrecReport(bad_pred_flushes);
 
@@ -444,6 +545,9 @@ void state::report_stats()
       if (i != uMEM) /* cache port utilization not really meaningul like others..  */
 	{
 	  fprintf(simout,"%s: %.1f%%\n",fuusage_names[i],StatrecMean(FUUsage[i]) / double(MaxUnits[i]) * 100.0);
+	  if (StatOut)
+	    StatOutValue("fu_utilization",fuusage_names[i],
+			 StatrecMean(FUUsage[i]) / double(MaxUnits[i]),"fraction");
 	}
     }
   
@@ -506,6 +610,36 @@ void state::report_stats()
       fprintf(simout,"Pref excl %s -- Num %d Mean %.3f Stddev %.3f\n", Req_stat_type[i],d,StatrecMean(pref_excl[i]),StatrecSdv(pref_excl[i]));
     }
 
+  if (StatOut)
+    for (i=0; i<(int)reqNUM_REQ_STAT_TYPE; i++)
+      {
+	/* latencies by how the access was resolved: from the time the
+	   access became active, had its address and was issued */
+	char stat[48];
+	sprintf(stat,"demand_read_%s_active",Req_stat_type[i]);
+	StatOutStatrec(stat,demand_read_act[i]);
+	sprintf(stat,"demand_read_%s",Req_stat_type[i]);
+	StatOutStatrec(stat,demand_read[i]);
+	sprintf(stat,"demand_read_%s_issued",Req_stat_type[i]);
+	StatOutStatrec(stat,demand_read_iss[i]);
+	sprintf(stat,"demand_write_%s_active",Req_stat_type[i]);
+	StatOutStatrec(stat,demand_write_act[i]);
+	sprintf(stat,"demand_write_%s",Req_stat_type[i]);
+	StatOutStatrec(stat,demand_write[i]);
+	sprintf(stat,"demand_write_%s_issued",Req_stat_type[i]);
+	StatOutStatrec(stat,demand_write_iss[i]);
+	sprintf(stat,"demand_rmw_%s_active",Req_stat_type[i]);
+	StatOutStatrec(stat,demand_rmw_act[i]);
+	sprintf(stat,"demand_rmw_%s",Req_stat_type[i]);
+	StatOutStatrec(stat,demand_rmw[i]);
+	sprintf(stat,"demand_rmw_%s_issued",Req_stat_type[i]);
+	StatOutStatrec(stat,demand_rmw_iss[i]);
+	sprintf(stat,"pref_sh_%s",Req_stat_type[i]);
+	StatOutStatrec(stat,pref_sh[i]);
+	sprintf(stat,"pref_excl_%s",Req_stat_type[i]);
+	StatOutStatrec(stat,pref_excl[i]);
+      }
+
   fprintf(simout,"\n");
 
   for (i=0; i <lNUM_LAT_TYPES; i++)
@@ -513,6 +647,10 @@ void state::report_stats()
       fprintf(simout,"Avail loss from %s: %.3f\n",lattype_names[i],
 	      double(avail_active_full_losses[i])/
 	      (double(decode_rate)*double(curr_cycle-start_time)));
+      if (StatOut)
+	StatOutValue("avail_loss",lattype_names[i],
+		     double(avail_active_full_losses[i])/
+		     (double(decode_rate)*double(curr_cycle-start_time)),"fraction");
     }
   
   fprintf(simout,"\n");
@@ -521,6 +659,9 @@ void state::report_stats()
     {      
       fprintf(simout,"Efficiency loss from %s: %.3f\n",eff_loss_names[i],
 	      double(eff_losses[i])/double(avail_fetch_slots));
+      if (StatOut)
+	StatOutValue("efficiency_loss",eff_loss_names[i],
+		     double(eff_losses[i])/double(avail_fetch_slots),"fraction");
     }
 
   double ifetch = instruction_count-start_icount;
@@ -530,6 +671,11 @@ void state::report_stats()
   fprintf(simout, "Utility losses from misspecs: %.3f excepts: %.3f\n",
 	  StatrecSum(bad_pred_flushes)/ifetch,
 	  StatrecSum(except_flushed)/ifetch);
+  if (StatOut)
+    {
+      StatOutValue("utility_loss","misspeculation",StatrecSum(bad_pred_flushes)/ifetch,"fraction");
+      StatOutValue("utility_loss","exceptions",StatrecSum(except_flushed)/ifetch,"fraction");
+    }
 
   fprintf(simout,"\n\n\n");  
 }
@@ -549,10 +695,20 @@ void state::report_phase_fast()
   fprintf(simerr,"STAT Execution time: %d Start time: %d Since last grad: %d\n",
 	  curr_cycle-start_time,start_time,curr_cycle-last_graduated);
   for (int i=0; i<lNUM_LAT_TYPES;i++)
-    fprintf(simerr,"STAT %s: Grads %d Ratio %.4f\n",lattype_names[i],
-	    StatrecSamples(lat_contrs[i]),
-	    double(StatrecSamples(lat_contrs[i]))*StatrecMean(lat_contrs[i])/
-	    double(curr_cycle-start_time));
+    {
+      fprintf(simerr,"STAT %s: Grads %d Ratio %.4f\n",lattype_names[i],
+	      StatrecSamples(lat_contrs[i]),
+	      double(StatrecSamples(lat_contrs[i]))*StatrecMean(lat_contrs[i])/
+	      double(curr_cycle-start_time));
+      if (StatOut)
+	{
+	  StatOutValue("lat_contr_grads",lattype_names[i],
+		       StatrecSamples(lat_contrs[i]),"instructions");
+	  StatOutValue("lat_contr_ratio",lattype_names[i],
+		       double(StatrecSamples(lat_contrs[i]))*StatrecMean(lat_contrs[i])/
+		       double(curr_cycle-start_time),"fraction");
+	}
+    }
 
   fprintf(simerr,"STAT Window overflows: %d underflows: %d\n",window_overflows,window_underflows);
   fprintf(simerr,"STAT Branch prediction rate: %.4f\n",double(bpb_good_predicts)/double(bpb_good_predicts+bpb_bad_predicts));
@@ -578,6 +734,107 @@ void state::report_phase_fast()
   fflush(simerr);
 }
 
+/*************************************************************************/
+/* state::record_sample : add the interval measured since reset_stats to */
+/*                      : the per-sample statistics (-b)                 */
+/*************************************************************************/
+
+void state::record_sample()
+{
+  int i;
+  double cycles = double(curr_cycle-start_time);
+  if (cycles <= 0.0)
+    return;
+
+  StatrecUpdate(sample_ipc,double(graduates)/cycles,1.0);
+  for (i=0; i<lNUM_LAT_TYPES; i++)
+    StatrecUpdate(sample_lat[i],
+		  double(StatrecSamples(lat_contrs[i]))*StatrecMean(lat_contrs[i])/cycles,1.0);
+
+  /* demand accesses, classified as in report_stats */
+  double refs=0.0, l1hits=0.0, l2hits=0.0;
+  for (i=0; i<(int)reqNUM_REQ_STAT_TYPE; i++)
+    {
+      double d = StatrecSamples(demand_read[i]) + StatrecSamples(demand_write[i]) +
+	StatrecSamples(demand_rmw[i]);
+      refs += d;
+      if (i == reqL1HIT || i == reqWBCOAL)
+	l1hits += d;
+      else if (i == reqL2HIT)
+	l2hits += d;
+    }
+  if (refs > 0.0)
+    StatrecUpdate(sample_l1miss,(refs-l1hits)/refs,1.0);
+  if (refs > l1hits)
+    StatrecUpdate(sample_l2miss,(refs-l1hits-l2hits)/(refs-l1hits),1.0);
+}
+
+/*************************************************************************/
+/* SampleCI : half-width of the 95% confidence interval for the mean of  */
+/*          : the samples in rec (normal approximation)                  */
+/*************************************************************************/
+
+static double SampleCI(STATREC *rec)
+{
+  int n = StatrecSamples(rec);
+  if (n < 2)
+    return 0.0;
+  return 1.96*StatrecSdv(rec)/sqrt(double(n));
+}
+
+/*************************************************************************/
+/* state::report_samples : report the sampled estimates and their        */
+/*                       : confidence intervals at the end of a run      */
+/*************************************************************************/
+
+void state::report_samples()
+{
+  int n = StatrecSamples(sample_ipc);
+  double ipc = StatrecMean(sample_ipc), ipcci = SampleCI(sample_ipc);
+
+  fprintf(simout,"PROCESSOR %d SAMPLED STATISTICS: %d samples of %d instructions, 95%% confidence\n",
+	  proc_id,n,sample_measure);
+  if (n == 0)
+    {
+      fprintf(simout,"No measured interval completed\n\n");
+      return;
+    }
+  fprintf(simout,"IPC: %.4f +/- %.4f (%.2f%%)\n",ipc,ipcci,
+	  ipc > 0.0 ? 100.0*ipcci/ipc : 0.0);
+  fprintf(simout,"L1 demand miss rate: %.4f +/- %.4f\n",
+	  StatrecMean(sample_l1miss),SampleCI(sample_l1miss));
+  fprintf(simout,"L2 demand miss rate: %.4f +/- %.4f\n",
+	  StatrecMean(sample_l2miss),SampleCI(sample_l2miss));
+  for (int i=0; i<lNUM_LAT_TYPES; i++)
+    fprintf(simout,"%s ratio: %.4f +/- %.4f\n",lattype_names[i],
+	    StatrecMean(sample_lat[i]),SampleCI(sample_lat[i]));
+  fprintf(simout,"\n");
+
+  fprintf(simerr,"STAT Processor: %d Samples: %d IPC: %.4f +/- %.4f\n",
+	  proc_id,n,ipc,ipcci);
+
+  if (StatOut)
+    {
+      char module[16];
+      sprintf(module,"proc%d",proc_id);
+      StatOutScope("sample",module);
+      StatOutStatrec("ipc",sample_ipc);
+      StatOutValue("ipc","ci95",ipcci,"instructions/cycle");
+      StatOutStatrec("l1_demand_miss_rate",sample_l1miss);
+      StatOutValue("l1_demand_miss_rate","ci95",SampleCI(sample_l1miss),"fraction");
+      StatOutStatrec("l2_demand_miss_rate",sample_l2miss);
+      StatOutValue("l2_demand_miss_rate","ci95",SampleCI(sample_l2miss),"fraction");
+      for (int i=0; i<lNUM_LAT_TYPES; i++)
+	{
+	  char stat[48];
+	  sprintf(stat,"lat_contr_ratio_%s",lattype_names[i]);
+	  StatOutStatrec(stat,sample_lat[i]);
+	  StatOutValue(stat,"ci95",SampleCI(sample_lat[i]),"fraction");
+	}
+      fflush(StatOut);
+    }
+}
+
 /*************************************************************************/
 /* state::end_phase : Full statistics dump at the end of a phase         */
 /*************************************************************************/
@@ -598,6 +855,24 @@ void state::newphase(int phase)
   stats_phase=phase;
 }
 
+/*************************************************************************/
+/* state::fold_stats : fold the per-cycle counters into their statrecs   */
+/*************************************************************************/
+
+void state::fold_stats()
+{
+  StatctrFold(SPECSctr);
+  for (int i=0; i<numUTYPES; i++)
+    StatctrFold(FUUsagectr[i]);
+#ifndef STORE_ORDERING
+  StatctrFold(VSBctr);
+  StatctrFold(LoadQueueSizectr);
+#else
+  StatctrFold(MemQueueSizectr);
+#endif
+  StatctrFold(ACTIVELISTctr);
+}
+
 /*************************************************************************/
 /* state::reset_stats : Reset phase collection statistics                */
 /*************************************************************************/
@@ -622,18 +897,26 @@ void state::reset_stats()
   // total number of instructions flushed on exceptions
   window_overflows=window_underflows=0;
   StatrecReset(SPECS);
+  StatctrReset(SPECSctr);
   
   for (i=0; i<numUTYPES; i++)
-    StatrecReset(FUUsage[i]);
+    {
+      StatrecReset(FUUsage[i]);
+      StatctrReset(FUUsagectr[i]);
+    }
 #ifndef STORE_ORDERING
   StatrecReset(VSB);
   StatrecReset(LoadQueueSize);
+  StatctrReset(VSBctr);
+  StatctrReset(LoadQueueSizectr);
 #else
   StatrecReset(MemQueueSize);
+  StatctrReset(MemQueueSizectr);
 #endif
 
   // how long we are at each spec level
   StatrecReset(ACTIVELIST);
+  StatctrReset(ACTIVELISTctr);
   // size of active list
   agg_lat_type=-1;
   stats_phase=-1;
@@ -687,7 +970,7 @@ void state::reset_stats()
 /* state::copy   : copy state from one data structure to the other       */
 /*************************************************************************/
 
-void state::copy(const state *proc)
+void state::copy(state *proc)
 {
   // To fork processor proc, do the following
   // newproc = new state;
@@ -706,6 +989,8 @@ void state::copy(const state *proc)
   start_time=proc->curr_cycle;
   agg_lat_type=proc->agg_lat_type;
   stats_phase=proc->stats_phase;
+  sample_mode=proc->sample_mode;
+  sample_left=proc->sample_left;
   
   memcpy(logical_int_reg_file,proc->logical_int_reg_file,sizeof(logical_int_reg_file));
   memcpy(logical_fp_reg_file,proc->logical_fp_reg_file,sizeof(logical_fp_reg_file));
@@ -713,29 +998,15 @@ void state::copy(const state *proc)
   memcpy(physical_fp_reg_file,proc->physical_fp_reg_file,sizeof(physical_fp_reg_file));
   // the above copies straight over since the pages themselves are going to be all forked
 
-  unsigned pg;
-  for (pg=0;pg<highheap/ALLOC_SIZE; pg++)
-    {
-      unsigned oldaddr;
-      if (proc->PageTable.lookup(pg,oldaddr))
-	{
-	  char *newpg = (char *)malloc(ALLOC_SIZE);
-	  
-	  memcpy(newpg,(char *)oldaddr,ALLOC_SIZE);
-	  PageTable.insert(pg,(unsigned) newpg);
-	}
-    }
-  for (pg=lowshared/ALLOC_SIZE - 1; pg >= lowstack/ALLOC_SIZE; pg--)
+  /* the heap and stack pages are shared copy-on-write; each process
+     gets its own copy of a page when it first stores to it (see GetMap).
+     The parent's TLB may still hold those pages as writable. */
+  if (!proc->PageTable.ShareWith(PageTable))
     {
-      unsigned oldaddr;
-      if (proc->PageTable.lookup(pg,oldaddr)) /* in the case of the stack, they should all be present */
-	{
-	  char *newpg = (char *)malloc(ALLOC_SIZE);
-	  
-	  memcpy(newpg,(char *)oldaddr,ALLOC_SIZE);
-	  PageTable.insert(pg,(unsigned) newpg);
-	}
+      fprintf(simerr,"RSIM: Malloc out of space when forking page table!\n");
+      ::exit(-1);
     }
+  proc->FlushTLB();
 
 #ifndef STORE_ORDERING
   SStag=LStag=SLtag=LLtag= -1; /* indicates that anything can pass! */
@@ -744,140 +1015,336 @@ void state::copy(const state *proc)
 }
 
 /*************************************************************************/
-/* RSIM_EVENT  : The main process event; gets called every cycle         */
-/*             : performs the main processor functions                   */
-/*             : The main loop calls RSIM_EVENT for each processor every */
-/*             : cycle (cycle-by-cycle processor simulation stage)       */
+/* RSIM_NodeStats : per-cycle processor statistics, weighted by the      */
+/*                : number of processor cycles they stand for            */
 /*************************************************************************/
 
-extern "C" void RSIM_EVENT()
+static inline void RSIM_NodeStats(state *proc, double cycles)
 {
-  int curtime = (int) YS__Simtime;
-  int nondelayed;
-  int runL1,runL2,runproc;
+  StatctrUpdate(proc->SPECSctr,proc->branchq.NumItems(),cycles);
 
-  /* ********************* We have some delay when we wait for the cache clock
-     and the processor clock to synchronize. *********** */
-  
-  runL1 = (FASTER_PROC_L1 == 1) || (curtime % FASTER_PROC_L1 == 0);
-  runL2 = (FASTER_PROC == 1) ||  (curtime % FASTER_PROC == 0) ;
-  runproc = (FASTER_NET == 1) || (curtime % FASTER_NET == 0);
-
-  /* Loop through each processor and advance simulation by a cycle */
-  for (int i=0; i<np; i++)
+  for (int ctrfu=0; ctrfu<numUTYPES; ctrfu++)
     {
-      state *proc = AllProcs[i];
-      proc->curr_cycle = curtime;
+      StatctrUpdate(proc->FUUsagectr[ctrfu],
+		    proc->MaxUnits[ctrfu]-proc->UnitsFree[ctrfu],
+		    cycles);
+    }
+
+#ifndef STORE_ORDERING
+  StatctrUpdate(proc->VSBctr,proc->StoresToMem,cycles);
+  StatctrUpdate(proc->LoadQueueSizectr,proc->LoadQueue.NumItems(),cycles);
+#else
+  StatctrUpdate(proc->MemQueueSizectr,proc->MemQueue.NumItems(),cycles);
+#endif
+  StatctrUpdate(proc->ACTIVELISTctr,proc->active_list->NumElements(),cycles);
+}
+
+/*************************************************************************/
+/* RSIM_NodeCycle : advance one node (processor plus its private L1, L2  */
+/*                : and write buffer) by a single cycle. Returns 0 once  */
+/*                : the last processor has exited, 1 otherwise.          */
+/*                                                                       */
+/* All state touched here is private to the node except for the          */
+/* simulated memory image, the YACSIM pools and event list, and the     */
+/* global corefile pointer. Nodes must therefore still be stepped in    */
+/* proc_id order: a store graduated by node i in this cycle is visible  */
+/* to a load executed by node j>i in the same cycle, and the requests   */
+/* the caches hand to the bus/network are timestamped and queued in     */
+/* that order as well.                                                   */
+/*************************************************************************/
+
+static inline int RSIM_NodeCycle(state *proc, int curtime,
+				 int runL1, int runL2, int runproc)
+{
+  int nondelayed;
+
+  proc->curr_cycle = curtime;
 #ifdef COREFILE
-      corefile=proc->corefile;
+  corefile=proc->corefile;
 #endif
-      nondelayed = runproc && (--proc->DELAY <= 0);
-      // if runproc is 0, make nondelayed == 0 regardless
+  nondelayed = runproc && (--proc->DELAY <= 0);
+  // if runproc is 0, make nondelayed == 0 regardless
       
-      if (runL1 &&                                   /* this is the the time to run the L1 */
-	  (!proc->l1_argptr->mptr->pipe_empty ||     /* There is something to do at L1 */
-	   (proc->wb_argptr &&                       /* Or there is somthing at the WB */
-	    !(proc->wb_argptr->mptr->pipe_empty && proc->wb_argptr->mptr->inq_empty) ) ) )
-	{
-	  L1CacheOutSim(proc);          /*************************
-					  Handle requests in the
-					  pipelines of the L1 cache
-					  *************************/
+  if (runL1 &&                                   /* this is the the time to run the L1 */
+      (!proc->l1_argptr->mptr->pipe_empty ||     /* There is something to do at L1 */
+       (proc->wb_argptr &&                       /* Or there is somthing at the WB */
+	!(proc->wb_argptr->mptr->pipe_empty && proc->wb_argptr->mptr->inq_empty) ) ) )
+    {
+      HOSTPROF_BEGIN(HP_L1OUT);
+      L1CacheOutSim(proc);          /*************************
+				      Handle requests in the
+				      pipelines of the L1 cache
+				      *************************/
+      HOSTPROF_END;
         
-	}
+    }
 	   
-      if(runL2 &&                                    /* time to run the L2 */
-	 !(proc->l2_argptr->mptr->pipe_empty))       /* and there is something to do */
-	{
-	  L2CacheOutSim(proc);  /*************************
-				  Handle requests in the
-				  pipelines of the L2 cache
-				  *************************/
-	}
+  if(runL2 &&                                    /* time to run the L2 */
+     !(proc->l2_argptr->mptr->pipe_empty))       /* and there is something to do */
+    {
+      HOSTPROF_BEGIN(HP_L2OUT);
+      L2CacheOutSim(proc);  /*************************
+			      Handle requests in the
+			      pipelines of the L2 cache
+			      *************************/
+      HOSTPROF_END;
+    }
 
 
-      if (nondelayed && !proc->exit) /* no delay present, try to fetch,etc. */
-	{
-	  /* now, note availability */
+  if (nondelayed && !proc->exit) /* no delay present, try to fetch,etc. */
+    {
+      /* now, note availability */
 
-	  if (proc->in_exception != NULL && !(proc->exit))
-	    {
-	      ComputeAvail(proc);
-	      PreExceptionHandler(proc->in_exception,proc);
-	    }
+      if (proc->in_exception != NULL && !(proc->exit))
+	{
+	  ComputeAvail(proc);
+	  PreExceptionHandler(proc->in_exception,proc);
+	}
 
 #ifdef COREFILE
-	  if(proc->curr_cycle > DEBUG_TIME)
-	    fprintf(corefile,"Completion cycle %d \n",proc->curr_cycle);
+      if(proc->curr_cycle > DEBUG_TIME)
+	fprintf(corefile,"Completion cycle %d \n",proc->curr_cycle);
 #endif
 	  
-	  CompleteMemQueue(proc);
-	  CompleteQueues(proc);    /*************************
-				     Completion stage of the
-				     pipeline
-				     **************************/
+      HOSTPROF_BEGIN(HP_COMPLETE);
+      CompleteMemQueue(proc);
+      CompleteQueues(proc);    /*************************
+				 Completion stage of the
+				 pipeline
+				 **************************/
+      HOSTPROF_END;
 	  
-	  if (proc->in_exception == NULL && !(proc->exit))
-	    {
-	      maindecode(proc);    /*************************
-				     Main processor pipeline
-				     *************************/
-	    }
-
-	  if (proc->exit)
-	    {
-	      aliveprocs--;
-	      if (aliveprocs == 1) /* only uniprocessor left */
-          	parelapsedtime = (double)time(0) - parelapsedtime;
-	      if (aliveprocs == 0)
-		return;
-	      /* otherwise, just keep running, since caches might
-		 still need to service INVL requests, etc. */
-	    }
+      if (proc->in_exception == NULL && !(proc->exit))
+	{
+	  HOSTPROF_BEGIN(HP_DECODE);
+	  if (fast_forward || proc->sample_mode == SAMPLE_FF)
+	    FastForward(proc,FF_QUANTUM); /* functional mode (-s, -b) */
+	  else
+	    maindecode(proc);  /*************************
+				 Main processor pipeline
+				 *************************/
+	  HOSTPROF_END;
+	  if (sampling)
+	    SampleCycle(proc);
+	}
+
+      if (proc->exit)
+	{
+	  aliveprocs--;
+	  if (aliveprocs == 1) /* only uniprocessor left */
+	    parelapsedtime = (double)time(0) - parelapsedtime;
+	  if (aliveprocs == 0)
+	    return 0;
+	  /* otherwise, just keep running, since caches might
+	     still need to service INVL requests, etc. */
+	}
 	  
-	    if (!proc->DELAY)
-	      {
-		IssueQueues(proc);   /*********************
-				       Issue to queues
-				       ********************/
-
-		proc->DELAY=1;
-	      }
+      if (!proc->DELAY)
+	{
+	  HOSTPROF_BEGIN(HP_ISSUE);
+	  IssueQueues(proc);   /*********************
+				 Issue to queues
+				 ********************/
+	  HOSTPROF_END;
+
+	  proc->DELAY=1;
+	}
 	    
-	    StatrecUpdate(proc->SPECS,double(proc->branchq.NumItems()),1.0);
+      RSIM_NodeStats(proc,1.0);
+    }
+  if(runL1 &&                           /* If we need to run L1 and inq is not empty */
+     !(proc->l1_argptr->mptr->inq_empty))
+    {
+      HOSTPROF_BEGIN(HP_L1IN);
+      L1CacheInSim(proc); /****************************
+			    Handle requests coming into
+			    L1 cache
+			    ***************************/
+      HOSTPROF_END;
+    }
+      
+  if(runL2 &&
+     !(proc->l2_argptr->mptr->inq_empty))
+    {
+      HOSTPROF_BEGIN(HP_L2IN);
+      L2CacheInSim(proc);            /****************************
+				       Handle requests coming into
+				       L2 cache
+				       ****************************/
+      HOSTPROF_END;
+
+    }
+  return 1;
+}
+
+/*************************************************************************/
+/* Cycle skipping: a node whose processor cycle changed nothing, and     */
+/* whose caches and write buffer are empty, will keep doing nothing      */
+/* until a functional unit or memory operation completes, an exception   */
+/* flush delay runs out, or the memory system delivers something to its  */
+/* caches. The last of these can only happen through a YACSIM event, so  */
+/* once every node is in this state RSIM_EVENT can sleep until the       */
+/* earliest such wakeup, accounting the per-cycle statistics of the      */
+/* cycles it skips in bulk. Turned off with -o.                          */
+/*************************************************************************/
 
-	    for (int ctrfu=0; ctrfu<numUTYPES; ctrfu++)
-	      {
-		StatrecUpdate(proc->FUUsage[ctrfu],
-			      double(proc->MaxUnits[ctrfu]-proc->UnitsFree[ctrfu]),
-			      1.0);
-	      }
+int cycle_skip = 1;
 
+struct NodeSnapshot
+{
+  instance *exc;
+  int icount, gcount, actives, running, done, memdone, freeing, ready;
+  int memops, insystem, stores, readystores, pc, stall, unissued, branches;
+};
+
+static inline void RSIM_NodeSnapshot(state *proc, NodeSnapshot& s)
+{
+  memset(&s,0,sizeof(s));
+  s.exc = proc->in_exception;
+  s.icount = proc->instruction_count;
+  s.gcount = proc->graduation_count;
+  s.actives = proc->active_list->NumEntries();
+  s.running = proc->Running.num();
+  s.done = proc->DoneHeap.num();
+  s.memdone = proc->MemDoneHeap.num();
+  s.freeing = proc->FreeingUnits.num();
+  for (int i=0; i<numUTYPES; i++)
+    s.ready += proc->ReadyQueues[i].NumInQueue();
 #ifndef STORE_ORDERING
-	    StatrecUpdate(proc->VSB,double(proc->StoresToMem),1.0);
-	    StatrecUpdate(proc->LoadQueueSize,double(proc->LoadQueue.NumItems()),1.0);
+  s.memops = proc->LoadQueue.NumItems() + proc->StoreQueue.NumItems();
+  s.stores = proc->StoresToMem;
 #else
-	    StatrecUpdate(proc->MemQueueSize,double(proc->MemQueue.NumItems()),1.0);
+  s.memops = proc->MemQueue.NumItems();
 #endif
-	    StatrecUpdate(proc->ACTIVELIST,double(proc->active_list->NumElements()),1.0);
-	}
-      if(runL1 &&                           /* If we need to run L1 and inq is not empty */
-         !(proc->l1_argptr->mptr->inq_empty))
+  s.insystem = NumInMemorySystem(proc);
+  s.readystores = proc->ReadyUnissuedStores;
+  s.pc = proc->pc;
+  s.stall = proc->stall_the_rest;
+  s.unissued = proc->unissued;
+  s.branches = proc->branchq.NumItems();
+}
+
+/*************************************************************************/
+/* RSIM_NodeWake : called after a processor cycle of a node with its     */
+/*               : snapshot from before that cycle. Returns the first    */
+/*               : cycle at which the node may have work to do again;    */
+/*               : curtime+1 if it is not idle.                          */
+/*************************************************************************/
+
+static int RSIM_NodeWake(state *proc, int curtime, const NodeSnapshot& before)
+{
+  NodeSnapshot after;
+  int wake = MAXINT;
+
+  if (!proc->l1_argptr->mptr->pipe_empty || !proc->l1_argptr->mptr->inq_empty ||
+      (proc->wb_argptr &&
+       !(proc->wb_argptr->mptr->pipe_empty && proc->wb_argptr->mptr->inq_empty)) ||
+      !proc->l2_argptr->mptr->pipe_empty || !proc->l2_argptr->mptr->inq_empty)
+    return curtime+1;
+
+  if (proc->exit)		/* only the caches are left */
+    return MAXINT;
+
+  RSIM_NodeSnapshot(proc,after);
+  if (memcmp(&before,&after,sizeof(after)) != 0)
+    return curtime+1;
+
+  if (proc->DELAY > 1)		/* processor cycle DELAY from now */
+    return (curtime/FASTER_NET + proc->DELAY) * FASTER_NET;
+
+  if (proc->in_exception != NULL)
+    return curtime+1;
+
+  if (proc->Running.num() && proc->Running.PeekMin() < wake)
+    wake = proc->Running.PeekMin();
+  if (proc->DoneHeap.num() && proc->DoneHeap.PeekMin() < wake)
+    wake = proc->DoneHeap.PeekMin();
+  if (proc->MemDoneHeap.num() && proc->MemDoneHeap.PeekMin() < wake)
+    wake = proc->MemDoneHeap.PeekMin();
+  if (proc->FreeingUnits.num() && proc->FreeingUnits.PeekMin() < wake)
+    wake = proc->FreeingUnits.PeekMin();
+  return wake;
+}
+
+/*************************************************************************/
+/* RSIM_SkipCycles : account for the idle cycles curtime+1 .. wake-1     */
+/*                 : as though each node had been stepped through them   */
+/*************************************************************************/
+
+static void RSIM_SkipCycles(int curtime, int wake)
+{
+  int ncycles = (wake-1)/FASTER_NET - curtime/FASTER_NET; /* processor cycles */
+
+  for (int i=0; i<np; i++)
+    {
+      state *proc = AllProcs[i];
+      
+      proc->curr_cycle = wake-1;
+      if (proc->exit || ncycles == 0)
+	continue;
+      if (proc->DELAY > 1)
 	{
-	  L1CacheInSim(proc); /****************************
-				Handle requests coming into
-				L1 cache
-				***************************/
+	  proc->DELAY -= ncycles;
+	  continue;
 	}
-      
-      if(runL2 &&
-         !(proc->l2_argptr->mptr->inq_empty))
+      ComputeAvail(proc,ncycles);
+      RSIM_NodeStats(proc,double(ncycles));
+    }
+}
+
+/*************************************************************************/
+/* RSIM_EVENT  : The main process event; gets called every cycle         */
+/*             : performs the main processor functions                   */
+/*             : The main loop calls RSIM_NodeCycle for each processor   */
+/*             : every cycle (cycle-by-cycle processor simulation stage) */
+/*************************************************************************/
+
+extern "C" void RSIM_EVENT()
+{
+  int curtime = (int) YS__Simtime;
+  int runL1,runL2,runproc;
+  int skip, wake = MAXINT;
+  NodeSnapshot before;
+
+  /* ********************* We have some delay when we wait for the cache clock
+     and the processor clock to synchronize. *********** */
+  
+  runL1 = (FASTER_PROC_L1 == 1) || (curtime % FASTER_PROC_L1 == 0);
+  runL2 = (FASTER_PROC == 1) ||  (curtime % FASTER_PROC == 0) ;
+  runproc = (FASTER_NET == 1) || (curtime % FASTER_NET == 0);
+
+  /* Idleness is only judged on cycles where the processors ran; the
+     functional modes always have work to do */
+  skip = cycle_skip && runproc && !fast_forward && !sampling;
+
+  /* Loop through each processor and advance simulation by a cycle */
+  for (int i=0; i<np; i++)
+    {
+      if (skip)
+	RSIM_NodeSnapshot(AllProcs[i],before);
+      if (!RSIM_NodeCycle(AllProcs[i],curtime,runL1,runL2,runproc))
+	return;
+      if (skip && wake > curtime+1)
 	{
-	  L2CacheInSim(proc);            /****************************
-					   Handle requests coming into
-					   L2 cache
-					 ****************************/
+	  int nodewake = RSIM_NodeWake(AllProcs[i],curtime,before);
+	  if (nodewake < wake)
+	    wake = nodewake;
+	}
+    }
 
+  if (skip && wake > curtime+1)
+    {
+      /* the next event on the list may hand work to a cache */
+      double next = YS__EventListHeadval();
+      if (next >= 0.0 && ceil(next) < wake)
+	wake = (int) ceil(next);
+      if (wake == MAXINT) /* nothing pending anywhere */
+	wake = curtime+1;
+      if (wake > curtime+1)
+	{
+	  RSIM_SkipCycles(curtime,wake);
+	  ActivitySchedTime(ME,double(wake-curtime),INDEPENDENT);
+	  return;
 	}
     }
 
@@ -971,7 +1438,7 @@ int reset_lists(state *proc)
 /*               : details on the definition see BennetFlynn1995         */
 /*************************************************************************/
 
-void ComputeAvail(state *proc)
+void ComputeAvail(state *proc, int cycles)
 {
   int avails = proc->active_list->NumAvail();
   if (avails < proc->decode_rate)
@@ -979,13 +1446,13 @@ void ComputeAvail(state *proc)
       if (proc->in_exception != NULL)
 	{
 	  // credit all the losses to exception
-	  proc->avail_active_full_losses[lEXCEPT]+= proc->decode_rate-avails;
+	  proc->avail_active_full_losses[lEXCEPT]+= (proc->decode_rate-avails)*cycles;
 	}
       else
 	{
 	  // find out why
 	  instance *avloss = GetHeadInst(proc);
-	  proc->avail_active_full_losses[lattype[avloss->code->instruction]]+= proc->decode_rate-avails;
+	  proc->avail_active_full_losses[lattype[avloss->code->instruction]]+= (proc->decode_rate-avails)*cycles;
 	}
     }
   else
@@ -993,8 +1460,8 @@ void ComputeAvail(state *proc)
       avails = proc->decode_rate;
     }
   
-  proc->stalledeff += avails;
-  proc->avail_fetch_slots += avails;
+  proc->stalledeff += avails*cycles;
+  proc->avail_fetch_slots += avails*cycles;
 }
 
 
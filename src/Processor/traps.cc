@@ -61,6 +61,7 @@
 #include "Processor/memprocess.h"
 #include "Processor/processor_dbg.h"
 #include "Processor/simio.h"
+#include "Processor/checkpoint.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -105,6 +106,9 @@ void SysTrapHandle(instance *inst,state *proc)
     fprintf(corefile,"traps.cc: In SysTrapHandler with code %d\n",inst->code->aux2);
 #endif
 
+  if (checkpoint_save_file) /* -C: may dump state and exit here */
+    CheckpointSave(inst,proc);
+
   switch (aux2)
     {
     case 0: // exit
@@ -212,9 +216,9 @@ void SysTrapHandle(instance *inst,state *proc)
 	if (inst->rs1vali > 0) /* need to increase */
 	  {
 	    unsigned incr = UP_TO_PAGE(inst->rs1vali);
-	    unsigned chunkptr = (unsigned) malloc(incr);
+	    char *chunkptr = (char *) malloc(incr);
 #ifdef COREFILE
-	    memset((void *)chunkptr,0x5a,incr);
+	    memset(chunkptr,0x5a,incr);
 #endif
 	    for (unsigned pg = proc->highheap/ALLOC_SIZE;
 		 pg < (proc->highheap + incr)/ALLOC_SIZE;
@@ -263,7 +267,7 @@ void StackTrapHandle(unsigned addr, state *proc)
 {
   while (proc->lowstack > addr)
     {
-      unsigned chunk = (unsigned) malloc(ALLOC_SIZE);
+      char *chunk = (char *) malloc(ALLOC_SIZE);
       if (chunk == 0)
 	{
 	  fprintf(simerr,"RSIM: Malloc out of space when growing stack!\n");
@@ -309,7 +313,7 @@ static void Sym_Bzero(instance *inst,state *proc)
   
   inst->addr=inst->rs1vali;
   int st=inst->addr & (ALLOC_SIZE-1);
-  char *pa = (char *)GetMap(inst,proc);
+  char *pa = GetMap(inst,proc,1);
   if (sz > ALLOC_SIZE-st)
     {
 #ifdef COREFILE
@@ -319,7 +323,7 @@ static void Sym_Bzero(instance *inst,state *proc)
       memset(pa,0,ALLOC_SIZE-st);
       inst->addr += ALLOC_SIZE -st;
       sz -= ALLOC_SIZE-st;
-      pa=(char *)GetMap(inst,proc);
+      pa=GetMap(inst,proc,1);
       while (sz >=ALLOC_SIZE)
 	{
 #ifdef COREFILE
@@ -329,7 +333,7 @@ static void Sym_Bzero(instance *inst,state *proc)
 	  memset(pa,0,ALLOC_SIZE);
 	  inst->addr += ALLOC_SIZE;
 	  sz -= ALLOC_SIZE;
-	  pa=(char *)GetMap(inst,proc);
+	  pa=GetMap(inst,proc,1);
 	}
     }
 #ifdef COREFILE
@@ -361,7 +365,7 @@ static void TimeHandler(instance *inst,state *proc)
 
   if ((void *)inst->addr != NULL)
     {
-      pa = (int *)GetMap(inst,proc);
+      pa = (int *)GetMap(inst,proc,1);
       *pa = int(YS__Simtime/(300*1000000)); // time for user program in clock seconds
     }
   
@@ -387,13 +391,13 @@ static void TimesHandler(instance *inst,state *proc)
   pr = proc->intmapper[lr];
   inst->addr = proc->physical_int_reg_file[pr];
 
-  pa = (int *)GetMap(inst,proc);
+  pa = (int *)GetMap(inst,proc,1);
   *pa = int(YS__Simtime/(3*1000000)); // time for user program in clock ticks
     // a clock tick defined in limits.h is 1/100 of a sec
     for(int i=0;i<3;i++)
       { 
 	inst->addr+=4; //go to next field
-	pa = (int *)GetMap(inst,proc);
+	pa = (int *)GetMap(inst,proc,1);
 	*pa = 0;
       }
   
@@ -412,7 +416,7 @@ static void ReadHandler(instance *inst,state *proc)
 #endif
   
   int fd,number_of_items;
-  int buffer;
+  char *buffer;
   int lr,pr;
   int count=0;
   int return_register;
@@ -433,15 +437,15 @@ static void ReadHandler(instance *inst,state *proc)
   int st = inst->addr & (ALLOC_SIZE-1);
 
   if(number_of_items > ALLOC_SIZE-st) {
-    buffer = GetMap(inst,proc);
-    if(read(fd,(char*)buffer,ALLOC_SIZE-st)!=-1)
+    buffer = GetMap(inst,proc,1);
+    if(read(fd,buffer,ALLOC_SIZE-st)!=-1)
       count+=ALLOC_SIZE-st;
     inst->addr+=ALLOC_SIZE-st;
     number_of_items-=ALLOC_SIZE-st;
 
     while(number_of_items>=ALLOC_SIZE) {
-      buffer = GetMap(inst,proc);
-      if(read(fd,(char*)buffer,ALLOC_SIZE)!=-1)
+      buffer = GetMap(inst,proc,1);
+      if(read(fd,buffer,ALLOC_SIZE)!=-1)
 	count+=ALLOC_SIZE;
       else 
 	break;
@@ -450,9 +454,9 @@ static void ReadHandler(instance *inst,state *proc)
     }
   }
       
-    buffer = GetMap(inst,proc);
+    buffer = GetMap(inst,proc,1);
 
-    if(read(fd,(char*)buffer,number_of_items)!=-1)
+    if(read(fd,buffer,number_of_items)!=-1)
       count+=number_of_items;
 
   proc->physical_int_reg_file[return_register] = count;
@@ -470,7 +474,7 @@ static void WriteHandler(instance *inst,state *proc)
 #endif
   
   int fd,number_of_items;
-  int buffer;
+  char *buffer;
   int lr,pr;
   int count = 0; /* return value */
   int return_register;
@@ -491,14 +495,14 @@ static void WriteHandler(instance *inst,state *proc)
 
   if(number_of_items > ALLOC_SIZE-st) {
     buffer = GetMap(inst,proc);
-    if(write(fd,(char*)buffer,ALLOC_SIZE-st)!=-1)
+    if(write(fd,buffer,ALLOC_SIZE-st)!=-1)
       count+=ALLOC_SIZE-st;
     inst->addr+=ALLOC_SIZE-st;
     number_of_items-=ALLOC_SIZE-st;
 
     while(number_of_items>=ALLOC_SIZE) {
       buffer = GetMap(inst,proc);
-      if(write(fd,(char*)buffer,ALLOC_SIZE)!=-1)
+      if(write(fd,buffer,ALLOC_SIZE)!=-1)
 	count+=ALLOC_SIZE;
       else 
 	break;
@@ -509,7 +513,7 @@ static void WriteHandler(instance *inst,state *proc)
       
     buffer = GetMap(inst,proc);
 
-    if(write(fd,(char*)buffer,number_of_items)!=-1)
+    if(write(fd,buffer,number_of_items)!=-1)
       count+=number_of_items;
 
   proc->physical_int_reg_file[return_register] = count;
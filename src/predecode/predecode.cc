@@ -54,6 +54,7 @@
 /******************************************************************************/
 
 #include "Processor/instruction.h"
+#include "Processor/decfile.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -78,6 +79,61 @@ void instr::print()
   printf("%-12.11s%d\t%d\t%d\t%d\t%d\t%d\t%d\n",inames[instruction],rd,rcc,rs1,rs2,aux1,aux2,imm);
 }
 
+/* Predecoded instructions are collected here and written out with a
+   header once the count is known (see decfile.h) */
+
+static int *decwords = NULL;
+static int ndecoded = 0, maxdecoded = 0;
+
+static void AddDecoded(const instr& inst)
+{
+  if (ndecoded == maxdecoded)
+    {
+      maxdecoded = maxdecoded ? 2*maxdecoded : 8192;
+      decwords = (int *)realloc(decwords,maxdecoded*DEC_FIELDS*sizeof(int));
+      if (decwords == NULL)
+	{
+	  fprintf(stderr,"Out of memory for predecoded instructions\n");
+	  exit(-1);
+	}
+    }
+  DecPack(inst,decwords+ndecoded*DEC_FIELDS);
+  ndecoded++;
+}
+
+static void WriteDecoded(FILE *fpout)
+{
+  DecHeader hdr;
+  int nchunks = DecChunks(ndecoded);
+  unsigned *sums = new unsigned[nchunks+1];
+
+  for (int c=0; c<nchunks; c++)
+    {
+      int n = ndecoded - c*DEC_CHUNK;
+      if (n > DEC_CHUNK)
+	n = DEC_CHUNK;
+      sums[c] = DecChecksum(decwords+c*DEC_CHUNK*DEC_FIELDS,n*DEC_FIELDS*sizeof(int));
+    }
+  
+  memset((char *)&hdr,0,sizeof(hdr));
+  hdr.magic = DEC_MAGIC;
+  hdr.version = DEC_VERSION;
+  hdr.byteorder = DEC_BYTEORDER;
+  hdr.fields = DEC_FIELDS;
+  hdr.ninstrs = ndecoded;
+  hdr.chunk = DEC_CHUNK;
+  hdr.checksum = DecChecksum(sums,nchunks*sizeof(unsigned));
+
+  if (fwrite((char *)&hdr,sizeof(hdr),1,fpout) != 1 ||
+      fwrite((char *)sums,sizeof(unsigned),nchunks,fpout) != nchunks ||
+      fwrite((char *)decwords,DEC_FIELDS*sizeof(int),ndecoded,fpout) != ndecoded)
+    {
+      fprintf(stderr,"Error writing predecoded file\n");
+      exit(-1);
+    }
+  delete[] sums;
+}
+
 main(int argc, char **argv)
 {
   Elf32_Shdr *shdr;
@@ -203,7 +259,7 @@ main(int argc, char **argv)
 			  if (start_decode(&inst,page[j]))
 			    {
 			      inst.print();
-			      inst.output(fpout);
+			      AddDecoded(inst);
 			    } /* otherwise it was just a meta-instruction */
 			}
 		      i = inew;
@@ -229,6 +285,7 @@ main(int argc, char **argv)
 	}
       elf_end(elf);
     }
+  WriteDecoded(fpout);
   fclose(fpout);
   close(fildes);
 }